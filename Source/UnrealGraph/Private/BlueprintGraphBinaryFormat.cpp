@@ -0,0 +1,655 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintGraphBinaryFormat.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphSerializer.h"
+#include "Containers/StringConv.h"
+#include "Async/ParallelFor.h"
+#include <cmath>
+
+namespace
+{
+	const uint8 BinaryGraphMagic[4] = { 'U', 'G', 'R', 'B' };
+
+	/** Node flag bits */
+	enum ENodeFlags : uint32
+	{
+		NodeFlag_HasPosition = 1 << 0,
+		NodeFlag_RawPosition = 1 << 1,
+		NodeFlag_HasMemberReference = 1 << 2,
+		NodeFlag_SelfContext = 1 << 3,
+		NodeFlag_HasIsCustomEvent = 1 << 4,
+		NodeFlag_IsCustomEvent = 1 << 5
+	};
+
+	/** Pin flag bits */
+	enum EPinFlags : uint32
+	{
+		PinFlag_Output = 1 << 0
+	};
+
+	/** Positions that survive a trip through int64 (no fraction, no negative zero) */
+	bool IsIntegralPosition(double Value)
+	{
+		return FMath::Abs(Value) < 1e15 && FMath::FloorToDouble(Value) == Value && !(Value == 0.0 && std::signbit(Value));
+	}
+
+	class FBinaryGraphWriter
+	{
+	public:
+		explicit FBinaryGraphWriter(TArray<uint8>& InBytes)
+			: Bytes(InBytes)
+		{
+		}
+
+		void WriteVarUInt(uint64 Value)
+		{
+			do
+			{
+				uint8 Byte = static_cast<uint8>(Value & 0x7F);
+				Value >>= 7;
+				if (Value != 0)
+				{
+					Byte |= 0x80;
+				}
+				Bytes.Add(Byte);
+			}
+			while (Value != 0);
+		}
+
+		void WriteVarInt(int64 Value)
+		{
+			// Zigzag so small negative deltas stay small
+			WriteVarUInt((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+		}
+
+		void WriteDouble(double Value)
+		{
+			uint64 Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+			for (int32 Shift = 0; Shift < 64; Shift += 8)
+			{
+				Bytes.Add(static_cast<uint8>(Bits >> Shift));
+			}
+		}
+
+		void WriteStringRef(int32 StringIndex)
+		{
+			WriteVarUInt(StringIndex == INDEX_NONE ? 0 : static_cast<uint64>(StringIndex) + 1);
+		}
+
+		void WriteString(const FString& Value)
+		{
+			FTCHARToUTF8 Utf8(*Value, Value.Len());
+			WriteVarUInt(Utf8.Length());
+			Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		}
+
+		void WriteRaw(const uint8* Data, int32 Num)
+		{
+			Bytes.Append(Data, Num);
+		}
+
+	private:
+		TArray<uint8>& Bytes;
+	};
+
+	class FBinaryGraphReader
+	{
+	public:
+		explicit FBinaryGraphReader(TArrayView<const uint8> InBytes)
+			: Bytes(InBytes)
+		{
+		}
+
+		bool ReadVarUInt(uint64& OutValue)
+		{
+			OutValue = 0;
+			for (int32 Shift = 0; Shift < 64; Shift += 7)
+			{
+				if (Offset >= Bytes.Num())
+				{
+					return Fail(TEXT("Unexpected end of data"));
+				}
+				const uint8 Byte = Bytes[Offset++];
+				OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+				if ((Byte & 0x80) == 0)
+				{
+					return true;
+				}
+			}
+			return Fail(TEXT("Malformed varint"));
+		}
+
+		bool ReadVarInt(int64& OutValue)
+		{
+			uint64 Encoded;
+			if (!ReadVarUInt(Encoded))
+			{
+				return false;
+			}
+			OutValue = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+			return true;
+		}
+
+		/** Read an element count, rejecting counts the remaining data cannot hold (one byte per element minimum) */
+		bool ReadCount(int32& OutCount)
+		{
+			uint64 Count;
+			if (!ReadVarUInt(Count))
+			{
+				return false;
+			}
+			if (Count > static_cast<uint64>(Bytes.Num() - Offset))
+			{
+				return Fail(TEXT("Element count exceeds data size"));
+			}
+			OutCount = static_cast<int32>(Count);
+			return true;
+		}
+
+		bool ReadDouble(double& OutValue)
+		{
+			if (Offset + 8 > Bytes.Num())
+			{
+				return Fail(TEXT("Unexpected end of data"));
+			}
+			uint64 Bits = 0;
+			for (int32 Shift = 0; Shift < 64; Shift += 8)
+			{
+				Bits |= static_cast<uint64>(Bytes[Offset++]) << Shift;
+			}
+			FMemory::Memcpy(&OutValue, &Bits, sizeof(Bits));
+			return true;
+		}
+
+		bool ReadString(FString& OutValue)
+		{
+			uint64 Length;
+			if (!ReadVarUInt(Length))
+			{
+				return false;
+			}
+			if (Length > static_cast<uint64>(Bytes.Num() - Offset))
+			{
+				return Fail(TEXT("String exceeds data size"));
+			}
+			const int32 ByteCount = static_cast<int32>(Length);
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + Offset), ByteCount);
+			OutValue = FString(Converted.Length(), Converted.Get());
+			Offset += ByteCount;
+			return true;
+		}
+
+		bool ReadStringRef(int32& OutIndex, int32 NumStrings)
+		{
+			uint64 Ref;
+			if (!ReadVarUInt(Ref))
+			{
+				return false;
+			}
+			if (Ref > static_cast<uint64>(NumStrings))
+			{
+				return Fail(TEXT("String index out of range"));
+			}
+			OutIndex = static_cast<int32>(Ref) - 1;
+			return true;
+		}
+
+		bool ReadRaw(uint8* OutData, int32 Num)
+		{
+			if (Offset + Num > Bytes.Num())
+			{
+				return Fail(TEXT("Unexpected end of data"));
+			}
+			FMemory::Memcpy(OutData, Bytes.GetData() + Offset, Num);
+			Offset += Num;
+			return true;
+		}
+
+		bool Fail(const TCHAR* Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("%s at byte %d"), Message, Offset);
+			}
+			return false;
+		}
+
+		const FString& GetError() const
+		{
+			return Error;
+		}
+
+	private:
+		TArrayView<const uint8> Bytes;
+		int32 Offset = 0;
+		FString Error;
+	};
+
+	/**
+	 * Index-or-string field of a connection endpoint: index + 1, or 0 followed by a string ref
+	 */
+	void WriteIndexOrString(FBinaryGraphWriter& Writer, int32 Index, int32 StringIndex)
+	{
+		if (Index != INDEX_NONE)
+		{
+			Writer.WriteVarUInt(static_cast<uint64>(Index) + 1);
+		}
+		else
+		{
+			Writer.WriteVarUInt(0);
+			Writer.WriteStringRef(StringIndex);
+		}
+	}
+
+	bool ReadIndexOrString(FBinaryGraphReader& Reader, int32 NumStrings, int32& OutIndex, int32& OutStringIndex)
+	{
+		uint64 Ref;
+		if (!Reader.ReadVarUInt(Ref))
+		{
+			return false;
+		}
+		if (Ref == 0)
+		{
+			return Reader.ReadStringRef(OutStringIndex, NumStrings);
+		}
+		if (Ref > static_cast<uint64>(MAX_int32))
+		{
+			return Reader.Fail(TEXT("Index out of range"));
+		}
+		OutIndex = static_cast<int32>(Ref) - 1;
+		return true;
+	}
+
+	/** Last integral node position written; positions are encoded as deltas from it */
+	struct FIntegralPosition
+	{
+		int64 X = 0;
+		int64 Y = 0;
+	};
+
+	/**
+	 * Advance the delta base past a node: a node with an integral position becomes the new base
+	 */
+	void AdvanceIntegralPosition(const FBlueprintGraphNodeDescription& Node, FIntegralPosition& Position)
+	{
+		if (Node.bHasPosition && IsIntegralPosition(Node.PositionX) && IsIntegralPosition(Node.PositionY))
+		{
+			Position.X = static_cast<int64>(Node.PositionX);
+			Position.Y = static_cast<int64>(Node.PositionY);
+		}
+	}
+
+	/**
+	 * Write one node and its pins, updating the position delta base
+	 */
+	void EncodeNode(FBinaryGraphWriter& Writer, const FBlueprintGraphDescription& Description, const FBlueprintGraphNodeDescription& Node, FIntegralPosition& PreviousPosition)
+	{
+		const bool bRawPosition = Node.bHasPosition && !(IsIntegralPosition(Node.PositionX) && IsIntegralPosition(Node.PositionY));
+
+		uint32 Flags = 0;
+		Flags |= Node.bHasPosition ? NodeFlag_HasPosition : 0;
+		Flags |= bRawPosition ? NodeFlag_RawPosition : 0;
+		Flags |= Node.bHasMemberReference ? NodeFlag_HasMemberReference : 0;
+		Flags |= Node.bSelfContext ? NodeFlag_SelfContext : 0;
+		Flags |= Node.bHasIsCustomEvent ? NodeFlag_HasIsCustomEvent : 0;
+		Flags |= Node.bIsCustomEvent ? NodeFlag_IsCustomEvent : 0;
+		Writer.WriteVarUInt(Flags);
+
+		Writer.WriteStringRef(Node.Id);
+		Writer.WriteStringRef(Node.Type);
+		Writer.WriteStringRef(Node.ClassPath);
+		Writer.WriteStringRef(Node.Title);
+		Writer.WriteStringRef(Node.FunctionName);
+		Writer.WriteStringRef(Node.VariableName);
+		Writer.WriteStringRef(Node.EventName);
+		Writer.WriteStringRef(Node.EventClass);
+		Writer.WriteStringRef(Node.EventClassPath);
+
+		if (bRawPosition)
+		{
+			Writer.WriteDouble(Node.PositionX);
+			Writer.WriteDouble(Node.PositionY);
+		}
+		else if (Node.bHasPosition)
+		{
+			const FIntegralPosition Base = PreviousPosition;
+			AdvanceIntegralPosition(Node, PreviousPosition);
+			Writer.WriteVarInt(PreviousPosition.X - Base.X);
+			Writer.WriteVarInt(PreviousPosition.Y - Base.Y);
+		}
+
+		if (Node.bHasMemberReference)
+		{
+			Writer.WriteStringRef(Node.MemberName);
+			Writer.WriteStringRef(Node.MemberParent);
+			Writer.WriteStringRef(Node.MemberGuid);
+		}
+
+		Writer.WriteVarUInt(Node.NumPins);
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			const FBlueprintGraphPinDescription& Pin = Description.Pins[PinIndex];
+			Writer.WriteVarUInt(Pin.Direction == EGPD_Output ? PinFlag_Output : 0);
+			Writer.WriteStringRef(Pin.Name);
+			Writer.WriteStringRef(Pin.Category);
+			Writer.WriteStringRef(Pin.SubCategory);
+			Writer.WriteStringRef(Pin.DefaultValue);
+		}
+	}
+}
+
+void FBlueprintGraphBinaryFormat::Encode(const FBlueprintGraphDescription& Description, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FBinaryGraphWriter Writer(OutBytes);
+
+	Writer.WriteRaw(BinaryGraphMagic, UE_ARRAY_COUNT(BinaryGraphMagic));
+	Writer.WriteVarUInt(CurrentVersion);
+
+	Writer.WriteVarUInt(Description.Strings.Num());
+	for (const FString& String : Description.Strings)
+	{
+		Writer.WriteString(String);
+	}
+
+	Writer.WriteStringRef(Description.Version);
+	Writer.WriteStringRef(Description.UnrealVersion);
+	Writer.WriteStringRef(Description.ExportDate);
+
+	const int32 NumNodes = Description.Nodes.Num();
+	Writer.WriteVarUInt(NumNodes);
+	if (!FBlueprintGraphSerializer::ShouldEncodeInParallel(NumNodes))
+	{
+		FIntegralPosition PreviousPosition;
+		for (const FBlueprintGraphNodeDescription& Node : Description.Nodes)
+		{
+			EncodeNode(Writer, Description, Node, PreviousPosition);
+		}
+	}
+	else
+	{
+		// Positions are deltas from the previous positioned node, so find the delta base of each chunk
+		// first; the chunks can then be encoded independently and appended in order
+		const int32 ChunkSize = FBlueprintGraphSerializer::GetParallelEncodeChunkSize();
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumNodes, ChunkSize);
+
+		TArray<FIntegralPosition> ChunkStartPositions;
+		ChunkStartPositions.Reserve(NumChunks);
+		FIntegralPosition Position;
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+		{
+			if (NodeIndex % ChunkSize == 0)
+			{
+				ChunkStartPositions.Add(Position);
+			}
+			AdvanceIntegralPosition(Description.Nodes[NodeIndex], Position);
+		}
+
+		TArray<TArray<uint8>> Chunks;
+		Chunks.SetNum(NumChunks);
+		ParallelFor(NumChunks, [&Description, &Chunks, &ChunkStartPositions, ChunkSize, NumNodes](int32 ChunkIndex)
+		{
+			const int32 FirstNode = ChunkIndex * ChunkSize;
+			const int32 EndNode = FMath::Min(FirstNode + ChunkSize, NumNodes);
+
+			FBinaryGraphWriter ChunkWriter(Chunks[ChunkIndex]);
+			FIntegralPosition PreviousPosition = ChunkStartPositions[ChunkIndex];
+			for (int32 NodeIndex = FirstNode; NodeIndex < EndNode; ++NodeIndex)
+			{
+				EncodeNode(ChunkWriter, Description, Description.Nodes[NodeIndex], PreviousPosition);
+			}
+		});
+
+		for (const TArray<uint8>& Chunk : Chunks)
+		{
+			Writer.WriteRaw(Chunk.GetData(), Chunk.Num());
+		}
+	}
+
+	Writer.WriteVarUInt(Description.Connections.Num());
+	for (const FBlueprintGraphConnectionDescription& Connection : Description.Connections)
+	{
+		for (const FBlueprintGraphConnectionEndpoint* Endpoint : { &Connection.From, &Connection.To })
+		{
+			WriteIndexOrString(Writer, Endpoint->Node, Endpoint->NodeId);
+			WriteIndexOrString(Writer, Endpoint->Pin, Endpoint->PinName);
+		}
+	}
+}
+
+bool FBlueprintGraphBinaryFormat::Decode(TArrayView<const uint8> Bytes, FBlueprintGraphDescription& OutDescription, FString& OutError)
+{
+	OutDescription.Reset();
+	OutError.Reset();
+
+	if (!IsBinaryGraph(Bytes))
+	{
+		OutError = TEXT("Not a binary graph (bad magic)");
+		return false;
+	}
+
+	FBinaryGraphReader Reader(Bytes);
+	uint8 Magic[UE_ARRAY_COUNT(BinaryGraphMagic)];
+	Reader.ReadRaw(Magic, UE_ARRAY_COUNT(Magic));
+
+	auto Failed = [&Reader, &OutDescription, &OutError]()
+	{
+		OutError = Reader.GetError();
+		OutDescription.Reset();
+		return false;
+	};
+
+	uint64 Version;
+	if (!Reader.ReadVarUInt(Version))
+	{
+		return Failed();
+	}
+	if (Version == 0 || Version > CurrentVersion)
+	{
+		OutError = FString::Printf(TEXT("Unsupported binary graph version %llu (supported: 1-%u)"), Version, CurrentVersion);
+		return false;
+	}
+
+	int32 NumStrings;
+	if (!Reader.ReadCount(NumStrings))
+	{
+		return Failed();
+	}
+	OutDescription.Strings.SetNum(NumStrings);
+	for (FString& String : OutDescription.Strings)
+	{
+		if (!Reader.ReadString(String))
+		{
+			return Failed();
+		}
+	}
+
+	if (!Reader.ReadStringRef(OutDescription.Version, NumStrings) ||
+		!Reader.ReadStringRef(OutDescription.UnrealVersion, NumStrings) ||
+		!Reader.ReadStringRef(OutDescription.ExportDate, NumStrings))
+	{
+		return Failed();
+	}
+
+	int32 NumNodes;
+	if (!Reader.ReadCount(NumNodes))
+	{
+		return Failed();
+	}
+
+	OutDescription.Nodes.Reserve(NumNodes);
+
+	int64 PreviousX = 0;
+	int64 PreviousY = 0;
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		FBlueprintGraphNodeDescription& Node = OutDescription.Nodes.AddDefaulted_GetRef();
+
+		uint64 Flags;
+		if (!Reader.ReadVarUInt(Flags) ||
+			!Reader.ReadStringRef(Node.Id, NumStrings) ||
+			!Reader.ReadStringRef(Node.Type, NumStrings) ||
+			!Reader.ReadStringRef(Node.ClassPath, NumStrings) ||
+			!Reader.ReadStringRef(Node.Title, NumStrings) ||
+			!Reader.ReadStringRef(Node.FunctionName, NumStrings) ||
+			!Reader.ReadStringRef(Node.VariableName, NumStrings) ||
+			!Reader.ReadStringRef(Node.EventName, NumStrings) ||
+			!Reader.ReadStringRef(Node.EventClass, NumStrings) ||
+			!Reader.ReadStringRef(Node.EventClassPath, NumStrings))
+		{
+			return Failed();
+		}
+
+		Node.bHasPosition = (Flags & NodeFlag_HasPosition) != 0;
+		Node.bHasMemberReference = (Flags & NodeFlag_HasMemberReference) != 0;
+		Node.bSelfContext = (Flags & NodeFlag_SelfContext) != 0;
+		Node.bHasIsCustomEvent = (Flags & NodeFlag_HasIsCustomEvent) != 0;
+		Node.bIsCustomEvent = (Flags & NodeFlag_IsCustomEvent) != 0;
+
+		if (Node.Id == INDEX_NONE || Node.Type == INDEX_NONE)
+		{
+			Reader.Fail(TEXT("Node is missing id or type"));
+			return Failed();
+		}
+
+		if ((Flags & NodeFlag_RawPosition) != 0)
+		{
+			if (!Reader.ReadDouble(Node.PositionX) || !Reader.ReadDouble(Node.PositionY))
+			{
+				return Failed();
+			}
+		}
+		else if (Node.bHasPosition)
+		{
+			int64 DeltaX, DeltaY;
+			if (!Reader.ReadVarInt(DeltaX) || !Reader.ReadVarInt(DeltaY))
+			{
+				return Failed();
+			}
+			PreviousX += DeltaX;
+			PreviousY += DeltaY;
+			Node.PositionX = static_cast<double>(PreviousX);
+			Node.PositionY = static_cast<double>(PreviousY);
+		}
+
+		if (Node.bHasMemberReference)
+		{
+			if (!Reader.ReadStringRef(Node.MemberName, NumStrings) ||
+				!Reader.ReadStringRef(Node.MemberParent, NumStrings) ||
+				!Reader.ReadStringRef(Node.MemberGuid, NumStrings))
+			{
+				return Failed();
+			}
+		}
+
+		if (!Reader.ReadCount(Node.NumPins))
+		{
+			return Failed();
+		}
+		Node.FirstPin = OutDescription.Pins.Num();
+		for (int32 PinIndex = 0; PinIndex < Node.NumPins; ++PinIndex)
+		{
+			FBlueprintGraphPinDescription& Pin = OutDescription.Pins.AddDefaulted_GetRef();
+
+			uint64 PinFlags;
+			if (!Reader.ReadVarUInt(PinFlags) ||
+				!Reader.ReadStringRef(Pin.Name, NumStrings) ||
+				!Reader.ReadStringRef(Pin.Category, NumStrings) ||
+				!Reader.ReadStringRef(Pin.SubCategory, NumStrings) ||
+				!Reader.ReadStringRef(Pin.DefaultValue, NumStrings))
+			{
+				return Failed();
+			}
+			Pin.Direction = (PinFlags & PinFlag_Output) != 0 ? EGPD_Output : EGPD_Input;
+
+			// Version 1 stored each pin's linked node refs; the connections carry the same links
+			if (Version == 1)
+			{
+				int32 NumLinks;
+				if (!Reader.ReadCount(NumLinks))
+				{
+					return Failed();
+				}
+				for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+				{
+					int32 UnusedNode = INDEX_NONE;
+					int32 UnusedNodeId = INDEX_NONE;
+					if (!ReadIndexOrString(Reader, NumStrings, UnusedNode, UnusedNodeId))
+					{
+						return Failed();
+					}
+				}
+			}
+		}
+	}
+
+	int32 NumConnections;
+	if (!Reader.ReadCount(NumConnections))
+	{
+		return Failed();
+	}
+	OutDescription.Connections.Reserve(NumConnections);
+	for (int32 ConnectionIndex = 0; ConnectionIndex < NumConnections; ++ConnectionIndex)
+	{
+		FBlueprintGraphConnectionDescription& Connection = OutDescription.Connections.AddDefaulted_GetRef();
+		for (FBlueprintGraphConnectionEndpoint* Endpoint : { &Connection.From, &Connection.To })
+		{
+			const bool bRead = ReadIndexOrString(Reader, NumStrings, Endpoint->Node, Endpoint->NodeId) &&
+				(Version == 1
+					? Reader.ReadStringRef(Endpoint->PinName, NumStrings)
+					: ReadIndexOrString(Reader, NumStrings, Endpoint->Pin, Endpoint->PinName));
+			if (!bRead)
+			{
+				return Failed();
+			}
+
+			if (!Endpoint->IsValid() ||
+				(Endpoint->Node != INDEX_NONE && !OutDescription.Nodes.IsValidIndex(Endpoint->Node)) ||
+				(Endpoint->Pin != INDEX_NONE && !OutDescription.GetEndpointPin(*Endpoint)))
+			{
+				Reader.Fail(TEXT("Connection endpoint out of range"));
+				return Failed();
+			}
+		}
+	}
+
+	// Version 1 named pins by string; convert to pin indices like the schema 1.0 JSON reader does
+	if (Version == 1)
+	{
+		OutDescription.ResolveConnectionEndpoints();
+	}
+
+	return true;
+}
+
+bool FBlueprintGraphBinaryFormat::IsBinaryGraph(TArrayView<const uint8> Bytes)
+{
+	return Bytes.Num() >= UE_ARRAY_COUNT(BinaryGraphMagic) &&
+		FMemory::Memcmp(Bytes.GetData(), BinaryGraphMagic, UE_ARRAY_COUNT(BinaryGraphMagic)) == 0;
+}
+
+bool FBlueprintGraphBinaryFormat::JsonToBinary(const FString& JsonText, TArray<uint8>& OutBytes, FString& OutError)
+{
+	FBlueprintGraphDescription Description;
+	if (!FBlueprintGraphJsonReader::ReadGraph(JsonText, Description, OutError))
+	{
+		return false;
+	}
+
+	Encode(Description, OutBytes);
+	return true;
+}
+
+bool FBlueprintGraphBinaryFormat::BinaryToJson(TArrayView<const uint8> Bytes, FString& OutJson, FString& OutError, bool bPrettyPrint)
+{
+	FBlueprintGraphDescription Description;
+	if (!Decode(Bytes, Description, OutError))
+	{
+		return false;
+	}
+
+	return FBlueprintGraphSerializer::WriteDescriptionJson(Description, OutJson, bPrettyPrint);
+}
@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintGraphContentHash.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphSerializer.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+
+namespace
+{
+	/** Length-prefixed, so adjacent fields cannot run into each other; absent strings differ from empty ones */
+	void HashText(FXxHash64Builder& Builder, const FString* Text)
+	{
+		const int32 Length = Text ? Text->Len() : -1;
+		Builder.Update(&Length, sizeof(Length));
+		if (Length > 0)
+		{
+			Builder.Update(**Text, Length * sizeof(TCHAR));
+		}
+	}
+
+	void HashString(FXxHash64Builder& Builder, const FBlueprintGraphDescription& Description, int32 StringIndex)
+	{
+		HashText(Builder, StringIndex != INDEX_NONE ? &Description.GetString(StringIndex) : nullptr);
+	}
+
+	template <typename ValueType>
+	void HashValue(FXxHash64Builder& Builder, const ValueType& Value)
+	{
+		Builder.Update(&Value, sizeof(Value));
+	}
+
+	/** Everything a node is, apart from its id, position and links */
+	uint64 HashNodeFields(const FBlueprintGraphDescription& Description, const FBlueprintGraphNodeDescription& Node)
+	{
+		FXxHash64Builder Builder;
+		HashString(Builder, Description, Node.Type);
+		HashString(Builder, Description, Node.ClassPath);
+		HashString(Builder, Description, Node.Title);
+		HashString(Builder, Description, Node.FunctionName);
+		HashString(Builder, Description, Node.VariableName);
+		HashString(Builder, Description, Node.EventName);
+		HashString(Builder, Description, Node.EventClass);
+		HashString(Builder, Description, Node.EventClassPath);
+
+		const uint8 Flags = (Node.bHasIsCustomEvent ? 1 : 0) | (Node.bIsCustomEvent ? 2 : 0) | (Node.bHasMemberReference ? 4 : 0) | (Node.bSelfContext ? 8 : 0);
+		HashValue(Builder, Flags);
+		if (Node.bHasMemberReference)
+		{
+			HashString(Builder, Description, Node.MemberName);
+			HashString(Builder, Description, Node.MemberParent);
+			HashString(Builder, Description, Node.MemberGuid);
+		}
+
+		HashValue(Builder, Node.NumPins);
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			const FBlueprintGraphPinDescription& Pin = Description.Pins[PinIndex];
+			HashString(Builder, Description, Pin.Name);
+			HashValue(Builder, static_cast<uint8>(Pin.Direction));
+			HashString(Builder, Description, Pin.Category);
+			HashString(Builder, Description, Pin.SubCategory);
+			HashString(Builder, Description, Pin.DefaultValue);
+		}
+		return Builder.Finalize().Hash;
+	}
+
+	uint64 HashNodeLayout(const FBlueprintGraphNodeDescription& Node)
+	{
+		FXxHash64Builder Builder;
+		HashValue(Builder, Node.bHasPosition);
+		if (Node.bHasPosition)
+		{
+			HashValue(Builder, Node.PositionX);
+			HashValue(Builder, Node.PositionY);
+		}
+		return Builder.Finalize().Hash;
+	}
+
+	/** Pin name of an endpoint whose node index is local to a graph section */
+	const FString* GetEndpointPinName(const FBlueprintGraphDescription& Content, const FBlueprintGraphSectionDescription& Section, const FBlueprintGraphConnectionEndpoint& Endpoint)
+	{
+		if (Endpoint.Pin != INDEX_NONE)
+		{
+			const FBlueprintGraphNodeDescription& Node = Content.Nodes[Section.FirstNode + Endpoint.Node];
+			return &Content.GetString(Content.Pins[Node.FirstPin + Endpoint.Pin].Name);
+		}
+		return &Content.GetString(Endpoint.PinName);
+	}
+
+	/** Order-independent root: the sorted hashes, hashed together */
+	uint64 HashSorted(TArray<uint64>& Hashes)
+	{
+		Hashes.Sort();
+		FXxHash64Builder Builder;
+		HashValue(Builder, Hashes.Num());
+		Builder.Update(Hashes.GetData(), Hashes.Num() * sizeof(uint64));
+		return Builder.Finalize().Hash;
+	}
+}
+
+void FBlueprintGraphContentHash::HashGraph(const FBlueprintGraphDescription& Description, FBlueprintGraphHashes& OutHashes)
+{
+	FBlueprintGraphSectionDescription Whole;
+	Whole.NumNodes = Description.Nodes.Num();
+	Whole.NumConnections = Description.Connections.Num();
+	HashGraph(Description, Whole, OutHashes);
+}
+
+void FBlueprintGraphContentHash::HashGraph(const FBlueprintGraphDescription& Content, const FBlueprintGraphSectionDescription& Section, FBlueprintGraphHashes& OutHashes)
+{
+	const int32 NumNodes = Section.NumNodes;
+	OutHashes.Nodes.SetNumUninitialized(NumNodes);
+
+	// Node fields and layout are independent per node; large graphs hash them in chunks, like encoding
+	TArray<uint64> FieldHashes;
+	FieldHashes.SetNumUninitialized(NumNodes);
+	auto HashNodes = [&Content, &Section, &FieldHashes, &OutHashes](int32 Begin, int32 End)
+	{
+		for (int32 NodeIndex = Begin; NodeIndex < End; ++NodeIndex)
+		{
+			const FBlueprintGraphNodeDescription& Node = Content.Nodes[Section.FirstNode + NodeIndex];
+			FieldHashes[NodeIndex] = HashNodeFields(Content, Node);
+			OutHashes.Nodes[NodeIndex].Layout = HashNodeLayout(Node);
+		}
+	};
+
+	if (FBlueprintGraphSerializer::ShouldEncodeInParallel(NumNodes))
+	{
+		const int32 ChunkSize = FBlueprintGraphSerializer::GetParallelEncodeChunkSize();
+		ParallelFor(FMath::DivideAndRoundUp(NumNodes, ChunkSize), [&HashNodes, NumNodes, ChunkSize](int32 ChunkIndex)
+		{
+			HashNodes(ChunkIndex * ChunkSize, FMath::Min((ChunkIndex + 1) * ChunkSize, NumNodes));
+		});
+	}
+	else
+	{
+		HashNodes(0, NumNodes);
+	}
+
+	// Outgoing links, by source node. The linked node contributes its own fields (not its content hash:
+	// links can form cycles); a node outside the graph contributes its id.
+	TArray<TPair<int32, uint64>> Links;
+	Links.Reserve(Section.NumConnections);
+	for (int32 ConnectionIndex = Section.FirstConnection; ConnectionIndex < Section.FirstConnection + Section.NumConnections; ++ConnectionIndex)
+	{
+		const FBlueprintGraphConnectionDescription& Connection = Content.Connections[ConnectionIndex];
+		if (Connection.From.Node == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FXxHash64Builder Builder;
+		HashText(Builder, GetEndpointPinName(Content, Section, Connection.From));
+		if (Connection.To.Node != INDEX_NONE)
+		{
+			HashValue(Builder, FieldHashes[Connection.To.Node]);
+		}
+		else
+		{
+			HashString(Builder, Content, Connection.To.NodeId);
+		}
+		HashText(Builder, GetEndpointPinName(Content, Section, Connection.To));
+		Links.Emplace(Connection.From.Node, Builder.Finalize().Hash);
+	}
+	Links.Sort([](const TPair<int32, uint64>& A, const TPair<int32, uint64>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+	});
+
+	TArray<uint64> ContentHashes;
+	TArray<uint64> LayoutHashes;
+	ContentHashes.SetNumUninitialized(NumNodes);
+	LayoutHashes.SetNumUninitialized(NumNodes);
+
+	int32 LinkIndex = 0;
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		FXxHash64Builder Builder;
+		HashValue(Builder, FieldHashes[NodeIndex]);
+		for (; LinkIndex < Links.Num() && Links[LinkIndex].Key == NodeIndex; ++LinkIndex)
+		{
+			HashValue(Builder, Links[LinkIndex].Value);
+		}
+
+		FBlueprintGraphNodeHashes& NodeHashes = OutHashes.Nodes[NodeIndex];
+		NodeHashes.Content = Builder.Finalize().Hash;
+		ContentHashes[NodeIndex] = NodeHashes.Content;
+
+		const uint64 Pair[2] = { NodeHashes.Content, NodeHashes.Layout };
+		LayoutHashes[NodeIndex] = FXxHash64::HashBuffer(Pair, sizeof(Pair)).Hash;
+	}
+
+	OutHashes.ContentRoot = HashSorted(ContentHashes);
+	OutHashes.LayoutRoot = HashSorted(LayoutHashes);
+}
+
+bool FBlueprintGraphContentHash::HashGraph(UEdGraph* Graph, FBlueprintGraphHashes& OutHashes)
+{
+	FBlueprintGraphDescription Description;
+	if (!FBlueprintGraphSerializer::DescribeGraph(Graph, Description))
+	{
+		return false;
+	}
+
+	HashGraph(Description, OutHashes);
+	return true;
+}
+
+void FBlueprintGraphContentHash::HashBlueprint(const FBlueprintDescription& Description, FBlueprintHashes& OutHashes)
+{
+	OutHashes.Graphs.SetNum(Description.Graphs.Num());
+	ParallelFor(Description.Graphs.Num(), [&Description, &OutHashes](int32 GraphIndex)
+	{
+		HashGraph(Description.Content, Description.Graphs[GraphIndex], OutHashes.Graphs[GraphIndex]);
+	});
+	FinishBlueprint(Description, OutHashes);
+}
+
+void FBlueprintGraphContentHash::FinishBlueprint(const FBlueprintDescription& Description, FBlueprintHashes& InOutHashes)
+{
+	FXxHash64Builder ContentBuilder;
+	FXxHash64Builder LayoutBuilder;
+	for (int32 GraphIndex = 0; GraphIndex < Description.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintGraphSectionDescription& Section = Description.Graphs[GraphIndex];
+		for (FXxHash64Builder* Builder : { &ContentBuilder, &LayoutBuilder })
+		{
+			HashString(*Builder, Description.Content, Section.Name);
+			HashString(*Builder, Description.Content, Section.Kind);
+			HashValue(*Builder, Section.ParentGraph);
+		}
+		HashValue(ContentBuilder, InOutHashes.Graphs[GraphIndex].ContentRoot);
+		HashValue(LayoutBuilder, InOutHashes.Graphs[GraphIndex].LayoutRoot);
+	}
+	InOutHashes.ContentRoot = ContentBuilder.Finalize().Hash;
+	InOutHashes.LayoutRoot = LayoutBuilder.Finalize().Hash;
+}
+
+FString FBlueprintGraphContentHash::ToString(uint64 Hash)
+{
+	return FString::Printf(TEXT("%016llx"), Hash);
+}
@@ -3,6 +3,12 @@
 #include "BlueprintGraphDeserializer.h"
 #include "UnrealGraphLogger.h"
 #include "BlueprintGraphJsonSchema.h"
+#include "BlueprintGraphReflectionCache.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphBinaryFormat.h"
+#include "BlueprintGraphDiff.h"
+#include "Engine/MemberReference.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
@@ -12,19 +18,259 @@
 #include "ScopedTransaction.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Class.h"
-#include "UObject/UObjectIterator.h"
 #include "UObject/UnrealType.h"
 #include "UObject/PropertyAccessUtil.h"
 #include "Engine/Blueprint.h"
 #include "Engine/Engine.h"
 #include "GameFramework/Actor.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Math/UnrealMathUtility.h"
 #include "Math/UnrealMathUtility.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ITransaction.h"
+#include "Templates/UnrealTemplate.h"
 
-// Static map to track node ID mappings during deserialization
-static TMap<FString, UEdGraphNode*> GNodeIdMap;
+namespace UnrealGraphDeserializer
+{
+	static int32 BulkPasteThreshold = 100;
+	static FAutoConsoleVariableRef CVarBulkPasteThreshold(
+		TEXT("UnrealGraph.Paste.BulkThreshold"),
+		BulkPasteThreshold,
+		TEXT("Node count from which a paste runs in bulk mode: one undo snapshot of the graph, no per-node graph notifications, ")
+		TEXT("and a single structural modification and editor refresh at the end (0 disables bulk mode)."),
+		ECVF_Default
+	);
+}
+
+namespace
+{
+	/**
+	 * GUID index of a graph kept between patches, so a patch resolves the nodes it names without walking
+	 * the graph. It is built on the first patch and dropped when the graph reports a change (OnGraphChanged)
+	 * or its node count no longer matches. Hits are checked against the node, so a node whose GUID or graph
+	 * changed without a notification is never returned.
+	 */
+	struct FPatchNodeIndex
+	{
+		TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> NodesByGuid;
+		int32 NumNodes = 0;
+		FDelegateHandle OnGraphChangedHandle;
+	};
+
+	/** Indices of graphs patched before (game thread only); emptied by ResetPatchNodeIndices on module shutdown */
+	TMap<TWeakObjectPtr<UEdGraph>, FPatchNodeIndex> PatchNodeIndices;
+
+	void BuildPatchNodeIndex(UEdGraph* Graph, FPatchNodeIndex& OutIndex)
+	{
+		OutIndex.NodesByGuid.Reset();
+		OutIndex.NodesByGuid.Reserve(Graph->Nodes.Num());
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && IsValid(Node) && Node->NodeGuid.IsValid())
+			{
+				OutIndex.NodesByGuid.Add(Node->NodeGuid, Node);
+			}
+		}
+	}
+
+	/**
+	 * Take the index of a graph out of the cache, building it if there is none or it is stale.
+	 * While checked out it does not listen for changes, so the patch's own edits do not drop it.
+	 * @return True if the index was just built from the graph
+	 */
+	bool CheckoutPatchNodeIndex(UEdGraph* Graph, FPatchNodeIndex& OutIndex)
+	{
+		if (PatchNodeIndices.RemoveAndCopyValue(Graph, OutIndex))
+		{
+			Graph->RemoveOnGraphChangedHandler(OutIndex.OnGraphChangedHandle);
+			OutIndex.OnGraphChangedHandle.Reset();
+			if (OutIndex.NumNodes == Graph->Nodes.Num())
+			{
+				return false;
+			}
+		}
+
+		// Forget graphs that no longer exist
+		for (auto It = PatchNodeIndices.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		BuildPatchNodeIndex(Graph, OutIndex);
+		return true;
+	}
+
+	/**
+	 * Put an index back into the cache, valid for the graph as it is now
+	 */
+	void ReturnPatchNodeIndex(UEdGraph* Graph, FPatchNodeIndex&& Index)
+	{
+		const TWeakObjectPtr<UEdGraph> WeakGraph(Graph);
+		Index.NumNodes = Graph->Nodes.Num();
+		Index.OnGraphChangedHandle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda([WeakGraph](const FEdGraphEditAction&)
+		{
+			FPatchNodeIndex StaleIndex;
+			if (PatchNodeIndices.RemoveAndCopyValue(WeakGraph, StaleIndex))
+			{
+				if (UEdGraph* ChangedGraph = WeakGraph.Get())
+				{
+					ChangedGraph->RemoveOnGraphChangedHandler(StaleIndex.OnGraphChangedHandle);
+				}
+			}
+		}));
+		PatchNodeIndices.Add(WeakGraph, MoveTemp(Index));
+	}
+
+	UEdGraphNode* FindIndexedNode(const FPatchNodeIndex& Index, const UEdGraph* Graph, const FGuid& NodeGuid)
+	{
+		const TWeakObjectPtr<UEdGraphNode>* Entry = Index.NodesByGuid.Find(NodeGuid);
+		UEdGraphNode* Node = Entry ? Entry->Get() : nullptr;
+		return Node && IsValid(Node) && Node->GetGraph() == Graph && Node->NodeGuid == NodeGuid ? Node : nullptr;
+	}
+
+	/**
+	 * Resolve the existing nodes a patch names (removed, moved, changed, unlinked, and id-form endpoints of
+	 * added links) into Context.ExistingNodesByGuid. A cached index that misses a named id is rebuilt once,
+	 * in case the graph changed without notifying.
+	 */
+	void ResolvePatchNodes(const FBlueprintGraphPatch& Patch, UEdGraph* Graph, FPatchNodeIndex& Index, bool bIndexIsFresh, FGraphDeserializeContext& Context)
+	{
+		const FBlueprintGraphDescription& Strings = Patch.Added;
+		auto Resolve = [&](int32 Id)
+		{
+			FGuid NodeGuid;
+			if (Id == INDEX_NONE || !FGuid::Parse(Strings.GetString(Id), NodeGuid) || Context.ExistingNodesByGuid.Contains(NodeGuid))
+			{
+				return;
+			}
+
+			UEdGraphNode* Node = FindIndexedNode(Index, Graph, NodeGuid);
+			if (!Node && !bIndexIsFresh)
+			{
+				BuildPatchNodeIndex(Graph, Index);
+				bIndexIsFresh = true;
+				Node = FindIndexedNode(Index, Graph, NodeGuid);
+			}
+			if (Node)
+			{
+				Context.ExistingNodesByGuid.Add(NodeGuid, Node);
+			}
+		};
+
+		for (const int32 Id : Patch.RemovedNodes)
+		{
+			Resolve(Id);
+		}
+		for (const FBlueprintGraphNodeMove& Move : Patch.MovedNodes)
+		{
+			Resolve(Move.Id);
+		}
+		for (const FBlueprintGraphPinDefaultChange& Change : Patch.ChangedDefaults)
+		{
+			Resolve(Change.Id);
+		}
+		for (const FBlueprintGraphConnectionDescription& Link : Patch.RemovedLinks)
+		{
+			Resolve(Link.From.NodeId);
+			Resolve(Link.To.NodeId);
+		}
+		for (const FBlueprintGraphConnectionDescription& Link : Patch.Added.Connections)
+		{
+			Resolve(Link.From.NodeId);
+			Resolve(Link.To.NodeId);
+		}
+	}
+}
+
+void FGraphNodePinIndex::Build(const UEdGraphNode* Node)
+{
+	Pins.Reset();
+	PinsByName.Reset();
+	for (TMap<FName, UEdGraphPin*>& DirectionPins : PinsByDirection)
+	{
+		DirectionPins.Reset();
+	}
+
+	if (!Node)
+	{
+		return;
+	}
+
+	Pins.Reserve(Node->Pins.Num());
+	PinsByName.Reserve(Node->Pins.Num());
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		if (!Pin)
+		{
+			continue;
+		}
+
+		Pins.Add(Pin);
+		PinsByName.FindOrAdd(Pin->PinName, Pin);
+		if (Pin->Direction < EGPD_MAX)
+		{
+			PinsByDirection[Pin->Direction].FindOrAdd(Pin->PinName, Pin);
+		}
+	}
+}
+
+bool FGraphNodePinIndex::IsUpToDate(const UEdGraphNode* Node) const
+{
+	if (!Node)
+	{
+		return Pins.Num() == 0;
+	}
+
+	int32 PinIndex = 0;
+	for (const UEdGraphPin* Pin : Node->Pins)
+	{
+		if (Pin && (!Pins.IsValidIndex(PinIndex) || Pins[PinIndex++] != Pin))
+		{
+			return false;
+		}
+	}
+	return PinIndex == Pins.Num();
+}
+
+UEdGraphPin* FGraphNodePinIndex::FindPin(FName PinName) const
+{
+	UEdGraphPin* const* Pin = PinsByName.Find(PinName);
+	return Pin ? *Pin : nullptr;
+}
+
+UEdGraphPin* FGraphNodePinIndex::FindPin(FName PinName, EEdGraphPinDirection Direction) const
+{
+	if (Direction >= EGPD_MAX)
+	{
+		return nullptr;
+	}
+	UEdGraphPin* const* Pin = PinsByDirection[Direction].Find(PinName);
+	return Pin ? *Pin : nullptr;
+}
+
+FGraphDeserializeContext::FGraphDeserializeContext(UEdGraph* InGraph, const FBlueprintGraphDescription& InDescription, bool bIndexExistingNodes)
+	: Graph(InGraph)
+	, Blueprint(InGraph ? FBlueprintEditorUtils::FindBlueprintForGraph(InGraph) : nullptr)
+	, Description(InDescription)
+{
+	CreatedNodes.Reserve(Description.Nodes.Num());
+
+	// Index the nodes already in the graph once; id-form connection endpoints resolve against it
+	if (Graph && bIndexExistingNodes)
+	{
+		ExistingNodesByGuid.Reserve(Graph->Nodes.Num());
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && IsValid(Node) && Node->NodeGuid.IsValid())
+			{
+				ExistingNodesByGuid.Add(Node->NodeGuid, Node);
+			}
+		}
+	}
+}
 
 bool FBlueprintGraphDeserializer::DeserializeGraph(UEdGraph* Graph, const TSharedPtr<FJsonObject>& JsonData)
 {
@@ -33,114 +279,360 @@ bool FBlueprintGraphDeserializer::DeserializeGraph(UEdGraph* Graph, const TShare
 		return false;
 	}
 
-	// Initialize logger for this deserialization session
-	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Deserialization"));
-	FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Deserializing Graph: %s"), *Graph->GetName()));
-
 	// Validate JSON schema
 	if (!ValidateJsonSchema(JsonData))
 	{
-		FUnrealGraphLogger::Log(TEXT("✗ ERROR: Invalid JSON schema"));
-		FUnrealGraphLogger::Shutdown();
 		UE_LOG(LogTemp, Error, TEXT("Invalid JSON schema"));
 		return false;
 	}
 
-	FUnrealGraphLogger::Log(TEXT("✓ JSON schema validated"));
+	// Read straight from the object: the reader converts schema 1.0 from/to connections itself, so no migrated copy is needed
+	FBlueprintGraphDescription Description;
+	FString Error;
+	if (!FBlueprintGraphJsonReader::ReadGraph(JsonData, Description, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Invalid graph JSON: %s"), *Error);
+		return false;
+	}
 
-	// Begin transaction for undo/redo support
-	FScopedTransaction Transaction(NSLOCTEXT("UnrealGraph", "PasteGraph", "Paste Graph from JSON"));
+	return DeserializeGraph(Graph, Description);
+}
 
-	// Clear the node ID mapping for this deserialization
-	GNodeIdMap.Empty();
+bool FBlueprintGraphDeserializer::DeserializeGraphFromString(UEdGraph* Graph, const FString& JsonText)
+{
+	if (!Graph)
+	{
+		return false;
+	}
 
-	// Get graph data
-	const TSharedPtr<FJsonObject>* GraphObjectPtr;
-	if (!JsonData->TryGetObjectField(TEXT("graph"), GraphObjectPtr))
+	// Token-streaming read; no FJsonObject tree is built. Schema checks happen while reading.
+	FBlueprintGraphDescription Description;
+	FString Error;
+	if (!FBlueprintGraphJsonReader::ReadGraph(JsonText, Description, Error))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Missing 'graph' field in JSON"));
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Invalid graph JSON: %s"), *Error);
 		return false;
 	}
 
-	TSharedPtr<FJsonObject> GraphObject = *GraphObjectPtr;
+	return DeserializeGraph(Graph, Description);
+}
+
+bool FBlueprintGraphDeserializer::DeserializeGraphFromBinary(UEdGraph* Graph, TArrayView<const uint8> Bytes)
+{
+	if (!Graph)
+	{
+		return false;
+	}
+
+	FBlueprintGraphDescription Description;
+	FString Error;
+	if (!FBlueprintGraphBinaryFormat::Decode(Bytes, Description, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Invalid binary graph: %s"), *Error);
+		return false;
+	}
+
+	return DeserializeGraph(Graph, Description);
+}
+
+bool FBlueprintGraphDeserializer::DeserializeGraph(UEdGraph* Graph, const FBlueprintGraphDescription& Description, FGraphDeserializeStats* OutStats, const FGraphDeserializeOptions& Options)
+{
+	if (!Graph)
+	{
+		return false;
+	}
+
+	// Initialize logger for this deserialization session
+	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Deserialization"));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Deserializing Graph: %s"), *Graph->GetName()));
+	// JSON and binary input is validated by its reader before it reaches this point
+	UNREALGRAPH_LOG(Summary, TEXT("✓ Graph description read: %d nodes, %d connections"), Description.Nodes.Num(), Description.Connections.Num());
+
+	// Begin transaction for undo/redo support
+	FScopedTransaction Transaction(NSLOCTEXT("UnrealGraph", "PasteGraph", "Paste Graph from JSON"));
+
+	// All per-call state lives here, so concurrent deserializations do not share anything
+	FGraphDeserializeContext Context(Graph, Description);
+	Context.bBulkMode = Options.bForceBulkMode
+		|| (UnrealGraphDeserializer::BulkPasteThreshold > 0 && Description.Nodes.Num() >= UnrealGraphDeserializer::BulkPasteThreshold);
+
+	if (Context.bBulkMode)
+	{
+		UNREALGRAPH_LOG(Summary, TEXT("Bulk paste mode (%d nodes, threshold %d)"), Description.Nodes.Num(), UnrealGraphDeserializer::BulkPasteThreshold);
+
+		// One graph-level undo snapshot: undoing restores the node list, which removes every pasted node.
+		// Pasted nodes are new objects, so their own state needs no recording; existing nodes that gain links do.
+		Graph->Modify();
+		ModifyExistingEndpointNodes(Context);
+	}
 
-	// Create nodes first
-	const TArray<TSharedPtr<FJsonValue>>* NodesArray;
 	int32 NodesCreated = 0;
-	if (GraphObject->TryGetArrayField(TEXT("nodes"), NodesArray))
+	int32 SuccessfulConnections = 0;
 	{
-		FUnrealGraphLogger::LogFormatted(TEXT("Creating %d nodes..."), NodesArray->Num());
-		for (const TSharedPtr<FJsonValue>& NodeValue : *NodesArray)
+		// In bulk mode the Modify() calls made by node setup and MakeLinkTo are not recorded
+		TGuardValue<ITransaction*> UndoGuard(GUndo, Context.bBulkMode ? nullptr : GUndo);
+
+		// Create nodes first; connections refer to them by description index
+		UNREALGRAPH_LOG(Summary, TEXT("Creating %d nodes..."), Description.Nodes.Num());
+		for (const FBlueprintGraphNodeDescription& NodeDescription : Description.Nodes)
 		{
-			const TSharedPtr<FJsonObject>* NodeObjectPtr;
-			if (NodeValue->TryGetObject(NodeObjectPtr))
+			FGraphNodePinIndex& NewNodePins = Context.CreatedNodePins.AddDefaulted_GetRef();
+			UEdGraphNode* NewNode = CreateNode(Context, NodeDescription, NewNodePins);
+			Context.CreatedNodes.Add(NewNode);
+			if (NewNode)
 			{
-				UEdGraphNode* CreatedNode = CreateNodeFromJson(Graph, *NodeObjectPtr);
-				if (CreatedNode)
-				{
-					NodesCreated++;
-				}
+				NodesCreated++;
 			}
 		}
-		FUnrealGraphLogger::LogFormatted(TEXT("✓ Created %d/%d nodes"), NodesCreated, NodesArray ? NodesArray->Num() : 0);
+		UNREALGRAPH_LOG(Summary, TEXT("✓ Created %d/%d nodes"), NodesCreated, Description.Nodes.Num());
+
+		// Create connections after all nodes are created
+		if (Description.Connections.Num() > 0)
+		{
+			UNREALGRAPH_LOG(Summary, TEXT("Creating %d connections..."), Description.Connections.Num());
+			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Attempting to create %d connections"), Description.Connections.Num());
+			SuccessfulConnections = CreateConnections(Context);
+			UNREALGRAPH_LOG(Summary, TEXT("✓ Created %d/%d connections"), SuccessfulConnections, Description.Connections.Num());
+			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Successfully created %d/%d connections"), SuccessfulConnections, Description.Connections.Num());
+		}
 	}
 
-	// Create connections after all nodes are created
-	const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray;
-	int32 SuccessfulConnections = 0;
-	if (GraphObject->TryGetArrayField(TEXT("connections"), ConnectionsArray))
+	if (Context.bBulkMode)
 	{
-		FUnrealGraphLogger::LogFormatted(TEXT("Creating %d connections..."), ConnectionsArray->Num());
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Attempting to create %d connections"), ConnectionsArray->Num());
-		SuccessfulConnections = CreateConnectionsFromJson(Graph, *ConnectionsArray);
-		FUnrealGraphLogger::LogFormatted(TEXT("✓ Created %d/%d connections"), SuccessfulConnections, ConnectionsArray->Num());
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Successfully created %d/%d connections"), SuccessfulConnections, ConnectionsArray->Num());
+		// The per-node add notifications were skipped: refresh the graph once, then make the single
+		// structural modification (skeleton regeneration) for all pasted nodes
+		Graph->NotifyGraphChanged();
+		if (Context.Blueprint)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Context.Blueprint);
+		}
 	}
-
-	// Clear the mapping after connections are created
-	GNodeIdMap.Empty();
-
-	// Mark Blueprint as modified
-	if (UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph))
+	else if (Context.Blueprint)
 	{
-		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		// Mark Blueprint as modified
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Context.Blueprint);
 	}
 
-	FUnrealGraphLogger::LogSection(TEXT("Deserialization Complete"));
-	FUnrealGraphLogger::LogFormatted(TEXT("Successfully created %d nodes and %d connections"), 
+	UNREALGRAPH_LOG_SECTION(Summary, TEXT("Deserialization Complete"));
+	UNREALGRAPH_LOG(Summary, TEXT("Successfully created %d nodes and %d connections"), 
 		NodesCreated, SuccessfulConnections);
 	FUnrealGraphLogger::Shutdown();
 
 	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Deserialization completed. Created %d nodes and %d connections"), NodesCreated, SuccessfulConnections);
 
+	if (OutStats)
+	{
+		OutStats->NodesCreated = NodesCreated;
+		OutStats->NodesFailed = Description.Nodes.Num() - NodesCreated;
+		OutStats->ConnectionsCreated = SuccessfulConnections;
+		OutStats->ConnectionsFailed = Description.Connections.Num() - SuccessfulConnections;
+	}
+
 	return true;
 }
 
-UEdGraphNode* FBlueprintGraphDeserializer::CreateNodeFromJson(UEdGraph* Graph, const TSharedPtr<FJsonObject>& NodeData)
+bool FBlueprintGraphDeserializer::ApplyPatchFromString(UEdGraph* Graph, const FString& PatchJson)
 {
-	if (!Graph || !NodeData.IsValid())
+	if (!Graph)
 	{
-		return nullptr;
+		return false;
 	}
 
-	// Get node type
-	FString NodeType;
-	if (!NodeData->TryGetStringField(TEXT("type"), NodeType))
+	FBlueprintGraphPatch Patch;
+	FString Error;
+	if (!FBlueprintGraphDiff::ReadPatchJson(PatchJson, Patch, Error))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Missing 'type' field in node data"));
-		return nullptr;
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Invalid graph patch: %s"), *Error);
+		return false;
 	}
 
-	// Get node ID for mapping
-	FString NodeId;
-	if (!NodeData->TryGetStringField(TEXT("id"), NodeId))
+	return ApplyPatch(Graph, Patch);
+}
+
+void FBlueprintGraphDeserializer::ResetPatchNodeIndices()
+{
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FPatchNodeIndex>& Pair : PatchNodeIndices)
+	{
+		if (UEdGraph* Graph = Pair.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.OnGraphChangedHandle);
+		}
+	}
+	PatchNodeIndices.Empty();
+}
+
+bool FBlueprintGraphDeserializer::ApplyPatch(UEdGraph* Graph, const FBlueprintGraphPatch& Patch)
+{
+	if (!Graph)
+	{
+		return false;
+	}
+
+	if (Patch.IsEmpty())
+	{
+		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Patch for %s is empty, nothing to apply"), *Graph->GetName());
+		return true;
+	}
+
+	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Patch"));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Applying Patch to Graph: %s"), *Graph->GetName()));
+
+	FScopedTransaction Transaction(NSLOCTEXT("UnrealGraph", "ApplyPatch", "Apply Graph Patch"));
+
+	// The added nodes and links form the description being deserialized; its string table serves the whole patch.
+	// Only the existing nodes the patch names are resolved, through the graph's cached GUID index, so the cost
+	// follows the size of the patch (the first patch of a graph builds the index).
+	FGraphDeserializeContext Context(Graph, Patch.Added, /*bIndexExistingNodes*/ false);
+	const FBlueprintGraphDescription& Strings = Patch.Added;
+
+	FPatchNodeIndex NodeIndex;
+	const bool bIndexIsFresh = CheckoutPatchNodeIndex(Graph, NodeIndex);
+	ResolvePatchNodes(Patch, Graph, NodeIndex, bIndexIsFresh, Context);
+
+	// 1. Links between nodes that stay (BreakLinkTo records both nodes)
+	int32 LinksRemoved = 0;
+	for (const FBlueprintGraphConnectionDescription& Link : Patch.RemovedLinks)
+	{
+		UEdGraphNode* FromNode = FindNodeById(Context, Strings.GetString(Link.From.NodeId));
+		UEdGraphNode* ToNode = FindNodeById(Context, Strings.GetString(Link.To.NodeId));
+		UEdGraphPin* FromPin = FindPinByName(FromNode, Strings.GetString(Link.From.PinName), EGPD_Output);
+		UEdGraphPin* ToPin = FindPinByName(ToNode, Strings.GetString(Link.To.PinName), EGPD_Input);
+		if (FromPin && ToPin && FromPin->LinkedTo.Contains(ToPin))
+		{
+			FromPin->BreakLinkTo(ToPin);
+			++LinksRemoved;
+		}
+	}
+
+	// 2. Removed and replaced nodes; their remaining links go with them
+	int32 NodesRemoved = 0;
+	for (const int32 Id : Patch.RemovedNodes)
+	{
+		UEdGraphNode* Node = FindNodeById(Context, Strings.GetString(Id));
+		if (!Node)
+		{
+			continue;
+		}
+
+		Context.ExistingNodesByGuid.Remove(Node->NodeGuid);
+		NodeIndex.NodesByGuid.Remove(Node->NodeGuid);
+		if (Context.Blueprint)
+		{
+			FBlueprintEditorUtils::RemoveNode(Context.Blueprint, Node, /*bDontRecompile*/ true);
+		}
+		else
+		{
+			Node->Modify();
+			Node->BreakAllNodeLinks();
+			Graph->RemoveNode(Node);
+		}
+		++NodesRemoved;
+	}
+
+	// 3. Positions
+	int32 NodesMoved = 0;
+	for (const FBlueprintGraphNodeMove& Move : Patch.MovedNodes)
+	{
+		if (UEdGraphNode* Node = FindNodeById(Context, Strings.GetString(Move.Id)))
+		{
+			FBlueprintGraphNodeDescription Position;
+			Position.bHasPosition = true;
+			Position.PositionX = Move.PositionX;
+			Position.PositionY = Move.PositionY;
+
+			Node->Modify();
+			SetNodePosition(Node, Position);
+			++NodesMoved;
+		}
+	}
+
+	// 4. Pin defaults, set the way pasting restores them
+	int32 DefaultsChanged = 0;
+	for (const FBlueprintGraphPinDefaultChange& Change : Patch.ChangedDefaults)
+	{
+		UEdGraphNode* Node = FindNodeById(Context, Strings.GetString(Change.Id));
+		UEdGraphPin* Pin = FindPinByName(Node, Strings.GetString(Change.PinName), Change.Direction);
+		if (!Pin)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find pin '%s' on node %s for a default value change"),
+				*Strings.GetString(Change.PinName), *Strings.GetString(Change.Id));
+			continue;
+		}
+
+		const FString& DefaultValue = Strings.GetString(Change.DefaultValue);
+		Node->Modify();
+		Pin->DefaultValue = DefaultValue;
+		Pin->AutogeneratedDefaultValue = DefaultValue;
+		Node->PinDefaultValueChanged(Pin);
+		++DefaultsChanged;
+	}
+
+	// 5. Added and replaced nodes, keeping their ids as GUIDs so the graph and the target document still match
+	int32 NodesCreated = 0;
+	for (const FBlueprintGraphNodeDescription& NodeDescription : Patch.Added.Nodes)
+	{
+		FGraphNodePinIndex& NewNodePins = Context.CreatedNodePins.AddDefaulted_GetRef();
+		UEdGraphNode* NewNode = CreateNode(Context, NodeDescription, NewNodePins);
+		Context.CreatedNodes.Add(NewNode);
+		if (!NewNode)
+		{
+			continue;
+		}
+		++NodesCreated;
+
+		FGuid NodeGuid;
+		if (FGuid::Parse(Strings.GetString(NodeDescription.Id), NodeGuid) && !Context.ExistingNodesByGuid.Contains(NodeGuid)
+			&& !FindIndexedNode(NodeIndex, Graph, NodeGuid))
+		{
+			NewNode->NodeGuid = NodeGuid;
+			Context.ExistingNodesByGuid.Add(NodeGuid, NewNode);
+		}
+		NodeIndex.NodesByGuid.Add(NewNode->NodeGuid, NewNode);
+	}
+
+	// 6. Added links: index endpoints refer to the nodes just created, id endpoints to nodes that stayed
+	const int32 LinksCreated = CreateConnections(Context);
+
+	ReturnPatchNodeIndex(Graph, MoveTemp(NodeIndex));
+
+	if (Context.Blueprint)
+	{
+		if (NodesRemoved > 0 || NodesCreated > 0)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Context.Blueprint);
+		}
+		else
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(Context.Blueprint);
+		}
+	}
+
+	UNREALGRAPH_LOG(Summary, TEXT("Patch applied: %d/%d nodes removed, %d/%d created, %d/%d moved, %d/%d defaults changed, %d/%d links removed, %d/%d links created"),
+		NodesRemoved, Patch.RemovedNodes.Num(), NodesCreated, Patch.Added.Nodes.Num(), NodesMoved, Patch.MovedNodes.Num(),
+		DefaultsChanged, Patch.ChangedDefaults.Num(), LinksRemoved, Patch.RemovedLinks.Num(), LinksCreated, Patch.Added.Connections.Num());
+	FUnrealGraphLogger::Shutdown();
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Patch applied to %s: %d nodes removed, %d created, %d moved, %d defaults changed, %d links removed, %d created"),
+		*Graph->GetName(), NodesRemoved, NodesCreated, NodesMoved, DefaultsChanged, LinksRemoved, LinksCreated);
+
+	return true;
+}
+
+UEdGraphNode* FBlueprintGraphDeserializer::CreateNode(const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, FGraphNodePinIndex& OutPins)
+{
+	UEdGraph* Graph = Context.Graph;
+	const FBlueprintGraphDescription& Description = Context.Description;
+	if (!Graph)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Missing 'id' field in node data"));
 		return nullptr;
 	}
 
-	// Map node type to UClass
-	UClass* NodeClass = GetNodeClassFromTypeName(NodeType);
+	// Node type and ID are guaranteed by the reader's schema checks
+	const FString& NodeType = Description.GetString(NodeDescription.Type);
+	const FString& NodeId = Description.GetString(NodeDescription.Id);
+
+	// Map node type to UClass (classPath, when present, allows a direct lookup)
+	UClass* NodeClass = GetNodeClassFromTypeName(NodeType, Description.GetString(NodeDescription.ClassPath));
 	if (!NodeClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Could not find UClass for node type: %s"), *NodeType);
@@ -156,10 +648,18 @@ UEdGraphNode* FBlueprintGraphDeserializer::CreateNodeFromJson(UEdGraph* Graph, c
 	}
 
 	// Add node to graph first (some nodes need to be in graph before configuration)
-	Graph->AddNode(NewNode, /*bFromUI*/ false, /*bSelectNewNode*/ false);
+	if (Context.bBulkMode)
+	{
+		// Same as AddNode minus its per-node graph-changed notification; DeserializeGraph refreshes once
+		Graph->Nodes.Add(NewNode);
+	}
+	else
+	{
+		Graph->AddNode(NewNode, /*bFromUI*/ false, /*bSelectNewNode*/ false);
+	}
 
 	// Configure node-specific properties BEFORE allocating pins
-	bool bWasConfigured = ConfigureNodeProperties(NewNode, NodeData, Graph);
+	bool bWasConfigured = ConfigureNodeProperties(NewNode, Context, NodeDescription);
 	
 	// Reconstruct node if configuration changed it (some nodes need this to allocate pins properly)
 	// ReconstructNode will allocate pins based on the configured properties
@@ -173,147 +673,179 @@ UEdGraphNode* FBlueprintGraphDeserializer::CreateNodeFromJson(UEdGraph* Graph, c
 		NewNode->AllocateDefaultPins();
 	}
 
+	// Index the allocated pins once; default restoration and wiring both look pins up through it
+	OutPins.Build(NewNode);
+
 	// Restore pin default values from JSON
-	RestorePinDefaultValues(NewNode, NodeData);
+	RestorePinDefaultValues(NewNode, Context, NodeDescription, OutPins);
 
 	// Set node position (after adding to graph)
-	FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Setting Position for Node: %s"), *NodeId));
-	SetNodePosition(NewNode, NodeData);
+	UNREALGRAPH_LOG_SECTION(Verbose, FString::Printf(TEXT("Setting Position for Node: %s"), *NodeId));
+	SetNodePosition(NewNode, NodeDescription);
 
 	// Post-creation setup - some nodes need this
 	NewNode->PostPlacedNewNode();
 
-	// Store mapping of old ID to new node
-	GNodeIdMap.Add(NodeId, NewNode);
+	// Rare, but a node may reallocate its pins while being placed
+	if (!OutPins.IsUpToDate(NewNode))
+	{
+		OutPins.Build(NewNode);
+	}
 
 	// Log node creation and available pins for debugging
-	FString PinList;
-	for (UEdGraphPin* Pin : NewNode->Pins)
+	if (UNREALGRAPH_LOG_ACTIVE(Verbose))
 	{
-		if (Pin)
+		FString PinList;
+		for (UEdGraphPin* Pin : NewNode->Pins)
 		{
-			if (!PinList.IsEmpty()) PinList += TEXT(", ");
-			PinList += FString::Printf(TEXT("%s(%s)"), *Pin->PinName.ToString(), Pin->Direction == EGPD_Input ? TEXT("in") : TEXT("out"));
+			if (Pin)
+			{
+				if (!PinList.IsEmpty()) PinList += TEXT(", ");
+				PinList += FString::Printf(TEXT("%s(%s)"), *Pin->PinName.ToString(), Pin->Direction == EGPD_Input ? TEXT("in") : TEXT("out"));
+			}
 		}
+		UNREALGRAPH_LOG(Verbose, TEXT("Created node: %s (ID: %s) with %d pins: %s"), 
+			*NodeType, *NodeId, NewNode->Pins.Num(), *PinList);
 	}
-	UE_LOG(LogTemp, Log, TEXT("Created node: %s (ID: %s) with %d pins: %s"), 
-		*NodeType, *NodeId, NewNode->Pins.Num(), *PinList);
 
 	return NewNode;
 }
 
-int32 FBlueprintGraphDeserializer::CreateConnectionsFromJson(UEdGraph* Graph, const TArray<TSharedPtr<FJsonValue>>& ConnectionsArray)
+int32 FBlueprintGraphDeserializer::CreateConnections(const FGraphDeserializeContext& Context)
 {
 	int32 SuccessCount = 0;
 	
-	if (!Graph)
+	if (!Context.Graph)
 	{
 		return 0;
 	}
 
-	for (const TSharedPtr<FJsonValue>& ConnectionValue : ConnectionsArray)
+	for (const FBlueprintGraphConnectionDescription& Connection : Context.Description.Connections)
 	{
-		const TSharedPtr<FJsonObject>* ConnectionObjectPtr;
-		if (!ConnectionValue->TryGetObject(ConnectionObjectPtr))
+		// Endpoints are guaranteed well-formed and in range by the reader
+		UEdGraphPin* FromPin = ResolveConnectionEndpoint(Context, Connection.From);
+		UEdGraphPin* ToPin = ResolveConnectionEndpoint(Context, Connection.To);
+		if (!FromPin || !ToPin)
 		{
 			continue;
 		}
 
-		TSharedPtr<FJsonObject> ConnectionObject = *ConnectionObjectPtr;
-
-		// Get "from" connection point
-		const TSharedPtr<FJsonObject>* FromObjectPtr;
-		const TSharedPtr<FJsonObject>* ToObjectPtr;
-		
-		if (!ConnectionObject->TryGetObjectField(TEXT("from"), FromObjectPtr) ||
-			!ConnectionObject->TryGetObjectField(TEXT("to"), ToObjectPtr))
+		// Create connection - MakeLinkTo returns void, so we can't check success directly
+		// Check if pins are already connected before attempting
+		bool bAlreadyConnected = FromPin->LinkedTo.Contains(ToPin);
+		if (!bAlreadyConnected)
 		{
-			continue;
+			FromPin->MakeLinkTo(ToPin);
+			SuccessCount++;
+			UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Created connection from %s.%s to %s.%s"), 
+				*FromPin->GetOwningNode()->GetName(), *FromPin->PinName.ToString(), *ToPin->GetOwningNode()->GetName(), *ToPin->PinName.ToString());
 		}
-
-		FString FromNodeId, FromPinName;
-		FString ToNodeId, ToPinName;
-
-		if (!(*FromObjectPtr)->TryGetStringField(TEXT("nodeId"), FromNodeId) ||
-			!(*FromObjectPtr)->TryGetStringField(TEXT("pinName"), FromPinName) ||
-			!(*ToObjectPtr)->TryGetStringField(TEXT("nodeId"), ToNodeId) ||
-			!(*ToObjectPtr)->TryGetStringField(TEXT("pinName"), ToPinName))
+		else
 		{
-			continue;
+			UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Connection from %s.%s to %s.%s already exists"), 
+				*FromPin->GetOwningNode()->GetName(), *FromPin->PinName.ToString(), *ToPin->GetOwningNode()->GetName(), *ToPin->PinName.ToString());
+			SuccessCount++; // Count as success since it's already connected
 		}
+	}
 
-		// Find nodes and pins
-		UEdGraphNode* FromNode = FindNodeById(Graph, FromNodeId);
-		UEdGraphNode* ToNode = FindNodeById(Graph, ToNodeId);
+	return SuccessCount;
+}
 
-		if (!FromNode)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find FromNode with ID: %s"), *FromNodeId);
-			continue;
-		}
+void FBlueprintGraphDeserializer::ModifyExistingEndpointNodes(const FGraphDeserializeContext& Context)
+{
+	const FBlueprintGraphDescription& Description = Context.Description;
 
-		if (!ToNode)
+	TSet<UEdGraphNode*> ModifiedNodes;
+	for (const FBlueprintGraphConnectionDescription& Connection : Description.Connections)
+	{
+		for (const FBlueprintGraphConnectionEndpoint* Endpoint : { &Connection.From, &Connection.To })
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find ToNode with ID: %s"), *ToNodeId);
-			continue;
+			FGuid NodeGuid;
+			if (Endpoint->NodeId == INDEX_NONE || !FGuid::Parse(Description.GetString(Endpoint->NodeId), NodeGuid))
+			{
+				continue;
+			}
+
+			// Unknown ids are reported when the connection is resolved
+			UEdGraphNode* const* ExistingNode = Context.ExistingNodesByGuid.Find(NodeGuid);
+			if (ExistingNode && IsValid(*ExistingNode) && !ModifiedNodes.Contains(*ExistingNode))
+			{
+				ModifiedNodes.Add(*ExistingNode);
+				(*ExistingNode)->Modify();
+			}
 		}
+	}
+}
+
+UEdGraphPin* FBlueprintGraphDeserializer::ResolveConnectionEndpoint(const FGraphDeserializeContext& Context, const FBlueprintGraphConnectionEndpoint& Endpoint)
+{
+	const FBlueprintGraphDescription& Description = Context.Description;
+
+	const FBlueprintGraphPinDescription* PinDescription = Description.GetEndpointPin(Endpoint);
+	const FString& PinName = PinDescription ? Description.GetString(PinDescription->Name) : Description.GetString(Endpoint.PinName);
 
-		UEdGraphPin* FromPin = FindPinByName(FromNode, FromPinName);
-		UEdGraphPin* ToPin = FindPinByName(ToNode, ToPinName);
+	// A name that was never made into an FName cannot match any pin
+	const FName PinFName(*PinName, FNAME_Find);
 
-		if (!FromPin)
+	// Node: created from the description by index, or an existing graph node by id
+	UEdGraphNode* Node = nullptr;
+	UEdGraphPin* Pin = nullptr;
+	if (Endpoint.Node != INDEX_NONE)
+	{
+		Node = Context.CreatedNodes.IsValidIndex(Endpoint.Node) ? Context.CreatedNodes[Endpoint.Node] : nullptr;
+		if (!Node)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find FromPin '%s' on node %s"), *FromPinName, *FromNode->GetName());
-			// Log available pins for debugging
-			FString AvailablePins;
-			for (UEdGraphPin* Pin : FromNode->Pins)
-			{
-				if (Pin)
-				{
-					if (!AvailablePins.IsEmpty()) AvailablePins += TEXT(", ");
-					AvailablePins += Pin->PinName.ToString();
-				}
-			}
-			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Available pins on FromNode: %s"), *AvailablePins);
-			continue;
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Node %d (ID: %s) was not created, skipping its connection"),
+				Endpoint.Node, Description.Nodes.IsValidIndex(Endpoint.Node) ? *Description.GetString(Description.Nodes[Endpoint.Node].Id) : TEXT("?"));
+			return nullptr;
 		}
 
-		if (!ToPin)
+		// The serialized pin index usually still matches the reconstructed node, so check it first
+		const FGraphNodePinIndex& Pins = Context.CreatedNodePins[Endpoint.Node];
+		if (PinDescription)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find ToPin '%s' on node %s"), *ToPinName, *ToNode->GetName());
-			// Log available pins for debugging
-			FString AvailablePins;
-			for (UEdGraphPin* Pin : ToNode->Pins)
+			UEdGraphPin* CandidatePin = Pins.GetPin(Endpoint.Pin);
+			if (CandidatePin && CandidatePin->Direction == PinDescription->Direction && CandidatePin->PinName == PinFName)
 			{
-				if (Pin)
-				{
-					if (!AvailablePins.IsEmpty()) AvailablePins += TEXT(", ");
-					AvailablePins += Pin->PinName.ToString();
-				}
+				Pin = CandidatePin;
+			}
+			else
+			{
+				Pin = Pins.FindPin(PinFName, PinDescription->Direction);
 			}
-			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Available pins on ToNode: %s"), *AvailablePins);
-			continue;
 		}
-
-		// Create connection - MakeLinkTo returns void, so we can't check success directly
-		// Check if pins are already connected before attempting
-		bool bAlreadyConnected = FromPin->LinkedTo.Contains(ToPin);
-		if (!bAlreadyConnected)
+		if (!Pin && !PinFName.IsNone())
 		{
-			FromPin->MakeLinkTo(ToPin);
-			SuccessCount++;
-			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Created connection from %s.%s to %s.%s"), 
-				*FromNode->GetName(), *FromPinName, *ToNode->GetName(), *ToPinName);
+			Pin = Pins.FindPin(PinFName);
 		}
-		else
+	}
+	else
+	{
+		Node = FindNodeById(Context, Description.GetString(Endpoint.NodeId));
+		if (!Node)
 		{
-			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Connection from %s.%s to %s.%s already exists"), 
-				*FromNode->GetName(), *FromPinName, *ToNode->GetName(), *ToPinName);
-			SuccessCount++; // Count as success since it's already connected
+			return nullptr;
 		}
+		Pin = FindPinByName(Node, PinName);
 	}
 
-	return SuccessCount;
+	if (!Pin)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find pin '%s' on node %s"), *PinName, *Node->GetName());
+		// Log available pins for debugging
+		FString AvailablePins;
+		for (UEdGraphPin* NodePin : Node->Pins)
+		{
+			if (NodePin)
+			{
+				if (!AvailablePins.IsEmpty()) AvailablePins += TEXT(", ");
+				AvailablePins += NodePin->PinName.ToString();
+			}
+		}
+		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Available pins on %s: %s"), *Node->GetName(), *AvailablePins);
+	}
+
+	return Pin;
 }
 
 bool FBlueprintGraphDeserializer::ValidateJsonSchema(const TSharedPtr<FJsonObject>& JsonData)
@@ -327,31 +859,22 @@ bool FBlueprintGraphDeserializer::ValidateJsonSchema(const TSharedPtr<FJsonObjec
 	return FBlueprintGraphJsonSchema::ValidateJson(JsonData);
 }
 
-UEdGraphNode* FBlueprintGraphDeserializer::FindNodeById(UEdGraph* Graph, const FString& NodeId)
+UEdGraphNode* FBlueprintGraphDeserializer::FindNodeById(const FGraphDeserializeContext& Context, const FString& NodeId)
 {
-	if (!Graph || NodeId.IsEmpty())
+	if (NodeId.IsEmpty())
 	{
 		return nullptr;
 	}
 
-	// First, check the mapping from deserialization (for newly created nodes)
-	if (UEdGraphNode** MappedNode = GNodeIdMap.Find(NodeId))
-	{
-		if (*MappedNode && IsValid(*MappedNode))
-		{
-			return *MappedNode;
-		}
-	}
-
-	// Try to parse as GUID and search in existing nodes
+	// Nodes of the payload are addressed by index; ids only refer to nodes already in the graph
 	FGuid NodeGuid;
 	if (FGuid::Parse(NodeId, NodeGuid))
 	{
-		for (UEdGraphNode* Node : Graph->Nodes)
+		if (UEdGraphNode* const* ExistingNode = Context.ExistingNodesByGuid.Find(NodeGuid))
 		{
-			if (Node && IsValid(Node) && Node->NodeGuid == NodeGuid)
+			if (IsValid(*ExistingNode))
 			{
-				return Node;
+				return *ExistingNode;
 			}
 		}
 	}
@@ -367,73 +890,99 @@ UEdGraphPin* FBlueprintGraphDeserializer::FindPinByName(UEdGraphNode* Node, cons
 		return nullptr;
 	}
 
+	const FName PinFName(*PinName, FNAME_Find);
+	if (PinFName.IsNone())
+	{
+		return nullptr;
+	}
+
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		if (Pin && Pin->PinName == PinFName)
+		{
+			return Pin;
+		}
+	}
+
+	return nullptr;
+}
+
+UEdGraphPin* FBlueprintGraphDeserializer::FindPinByName(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction)
+{
+	if (!Node || PinName.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const FName PinFName(*PinName, FNAME_Find);
+	if (PinFName.IsNone())
+	{
+		return nullptr;
+	}
+
+	UEdGraphPin* NameMatch = nullptr;
 	for (UEdGraphPin* Pin : Node->Pins)
 	{
-		if (Pin && Pin->PinName.ToString() == PinName)
+		if (Pin && Pin->PinName == PinFName)
 		{
-			return Pin;
+			if (Pin->Direction == Direction)
+			{
+				return Pin;
+			}
+			NameMatch = NameMatch ? NameMatch : Pin;
 		}
 	}
 
-	return nullptr;
+	return NameMatch;
 }
 
-UClass* FBlueprintGraphDeserializer::GetNodeClassFromTypeName(const FString& NodeTypeName)
+UClass* FBlueprintGraphDeserializer::GetNodeClassFromTypeName(const FString& NodeTypeName, const FString& ClassPath)
 {
+	// Direct lookup by full path (/Script/Module.ClassName) written by newer serializers
+	if (!ClassPath.IsEmpty())
+	{
+		UClass* PathClass = FindObject<UClass>(nullptr, *ClassPath);
+		if (PathClass && PathClass->IsChildOf(UEdGraphNode::StaticClass()))
+		{
+			return PathClass;
+		}
+		UNREALGRAPH_LOG(Verbose, TEXT("  Class path %s not loaded, falling back to name lookup"), *ClassPath);
+	}
+
 	if (NodeTypeName.IsEmpty())
 	{
 		return nullptr;
 	}
 
-	// Build the full class path - Blueprint graph nodes are typically in BlueprintGraph module
-	// Format: /Script/ModuleName.ClassName
-	FString ClassPath = FString::Printf(TEXT("/Script/BlueprintGraph.%s"), *NodeTypeName);
-	
-	// Try to load the class
-	UClass* NodeClass = LoadClass<UEdGraphNode>(nullptr, *ClassPath);
-	
-	if (!NodeClass)
+	// Name index over every loaded UEdGraphNode subclass (built once, refreshed on module load/unload)
+	if (UClass* IndexedClass = FBlueprintGraphReflectionCache::FindNodeClass(*NodeTypeName))
 	{
-		// Try iterating through all UEdGraphNode classes to find by name
-		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-		{
-			UClass* TestClass = *ClassIt;
-			if (TestClass && TestClass->IsChildOf(UEdGraphNode::StaticClass()))
-			{
-				if (TestClass->GetName() == NodeTypeName)
-				{
-					NodeClass = TestClass;
-					break;
-				}
-			}
-		}
+		return IndexedClass;
 	}
 
-	return NodeClass;
+	// Build the full class path - Blueprint graph nodes are typically in BlueprintGraph module
+	// Format: /Script/ModuleName.ClassName
+	const FString BlueprintGraphClassPath = FString::Printf(TEXT("/Script/BlueprintGraph.%s"), *NodeTypeName);
+	return LoadClass<UEdGraphNode>(nullptr, *BlueprintGraphClassPath);
 }
 
-void FBlueprintGraphDeserializer::SetNodePosition(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData)
+void FBlueprintGraphDeserializer::SetNodePosition(UEdGraphNode* Node, const FBlueprintGraphNodeDescription& NodeDescription)
 {
-	if (!Node || !NodeData.IsValid())
+	if (!Node)
 	{
 		return;
 	}
 
-	// Get position from JSON
-	const TSharedPtr<FJsonObject>* PositionObjectPtr;
-	if (!NodeData->TryGetObjectField(TEXT("position"), PositionObjectPtr))
+	if (!NodeDescription.bHasPosition)
 	{
-		FUnrealGraphLogger::Log(TEXT("  No position data in JSON"));
+		UNREALGRAPH_LOG(Verbose, TEXT("  No position data in JSON"));
 		return;
 	}
 
-	TSharedPtr<FJsonObject> PositionObject = *PositionObjectPtr;
-	
-	double X = 0.0, Y = 0.0;
-	PositionObject->TryGetNumberField(TEXT("x"), X);
-	PositionObject->TryGetNumberField(TEXT("y"), Y);
+	const double X = NodeDescription.PositionX;
+	const double Y = NodeDescription.PositionY;
 
-	FUnrealGraphLogger::LogFormatted(TEXT("  Position from JSON: (%.1f, %.1f)"), X, Y);
+	UNREALGRAPH_LOG(Trace, TEXT("  Position from JSON: (%.1f, %.1f)"), X, Y);
 
 	int32 PosX = FMath::RoundToInt(static_cast<float>(X));
 	int32 PosY = FMath::RoundToInt(static_cast<float>(Y));
@@ -444,34 +993,34 @@ void FBlueprintGraphDeserializer::SetNodePosition(UEdGraphNode* Node, const TSha
 
 	// Based on log analysis: Positions are stored as IntProperty (NodePosX, NodePosY), not Vector2D!
 	// Try to set NodePosX and NodePosY as IntProperty
-	FUnrealGraphLogger::Log(TEXT("  Attempting to set NodePosX (IntProperty)..."));
+	UNREALGRAPH_LOG(Trace, TEXT("  Attempting to set NodePosX (IntProperty)..."));
 	FIntProperty* PosXProp = FindFProperty<FIntProperty>(Node->GetClass(), TEXT("NodePosX"));
 	if (PosXProp)
 	{
 		PosXProp->SetPropertyValue_InContainer(Node, PosX);
 		bSetX = true;
 		bPositionSet = true;
-		FUnrealGraphLogger::LogFormatted(TEXT("    ✓ Set NodePosX to %d"), PosX);
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set NodePosX to %d"), PosX);
+		UNREALGRAPH_LOG(Trace, TEXT("    ✓ Set NodePosX to %d"), PosX);
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set NodePosX to %d"), PosX);
 	}
 	else
 	{
-		FUnrealGraphLogger::Log(TEXT("    ✗ NodePosX property not found"));
+		UNREALGRAPH_LOG(Trace, TEXT("    ✗ NodePosX property not found"));
 	}
 
-	FUnrealGraphLogger::Log(TEXT("  Attempting to set NodePosY (IntProperty)..."));
+	UNREALGRAPH_LOG(Trace, TEXT("  Attempting to set NodePosY (IntProperty)..."));
 	FIntProperty* PosYProp = FindFProperty<FIntProperty>(Node->GetClass(), TEXT("NodePosY"));
 	if (PosYProp)
 	{
 		PosYProp->SetPropertyValue_InContainer(Node, PosY);
 		bSetY = true;
 		bPositionSet = true;
-		FUnrealGraphLogger::LogFormatted(TEXT("    ✓ Set NodePosY to %d"), PosY);
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set NodePosY to %d"), PosY);
+		UNREALGRAPH_LOG(Trace, TEXT("    ✓ Set NodePosY to %d"), PosY);
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set NodePosY to %d"), PosY);
 	}
 	else
 	{
-		FUnrealGraphLogger::Log(TEXT("    ✗ NodePosY property not found"));
+		UNREALGRAPH_LOG(Trace, TEXT("    ✗ NodePosY property not found"));
 	}
 
 	// Fallback: Try Vector2D approach (in case some nodes use it)
@@ -503,58 +1052,52 @@ void FBlueprintGraphDeserializer::SetNodePosition(UEdGraphNode* Node, const TSha
 	if (bPositionSet && bSetX && bSetY)
 	{
 		Node->Modify(); // Mark for undo/redo
-		FUnrealGraphLogger::LogFormatted(TEXT("  ✓ SUCCESS: Position set to (%d, %d)"), PosX, PosY);
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set node position to (%d, %d)"), PosX, PosY);
+		UNREALGRAPH_LOG(Verbose, TEXT("  ✓ SUCCESS: Position set to (%d, %d)"), PosX, PosY);
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set node position to (%d, %d)"), PosX, PosY);
 	}
 	else if (bPositionSet)
 	{
 		Node->Modify(); // Mark for undo/redo
-		FUnrealGraphLogger::LogFormatted(TEXT("  ⚠ PARTIAL: Position partially set (X: %s, Y: %s)"), 
+		UNREALGRAPH_LOG(Verbose, TEXT("  ⚠ PARTIAL: Position partially set (X: %s, Y: %s)"), 
 			bSetX ? TEXT("Yes") : TEXT("No"), bSetY ? TEXT("Yes") : TEXT("No"));
 		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Partially set node position (X: %s, Y: %s)"), 
 			bSetX ? TEXT("Yes") : TEXT("No"), bSetY ? TEXT("Yes") : TEXT("No"));
 	}
 	else
 	{
-		FUnrealGraphLogger::LogFormatted(TEXT("  ✗ FAILED: Could not set node position - NodePosX/NodePosY properties not found"));
+		UNREALGRAPH_LOG(Error, TEXT("  ✗ FAILED: Could not set node position - NodePosX/NodePosY properties not found"));
 		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not set node position - NodePosX/NodePosY properties not found"));
 	}
 }
 
-bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData, UEdGraph* Graph)
+bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription)
 {
-	if (!Node || !NodeData.IsValid() || !Graph)
+	// Blueprint for variable lookups, resolved once per deserialization
+	if (!Node || !Context.Graph || !Context.Blueprint)
 	{
 		return false;
 	}
 
-	FString NodeType;
-	if (!NodeData->TryGetStringField(TEXT("type"), NodeType))
-	{
-		return false;
-	}
-
-	FString Title;
-	NodeData->TryGetStringField(TEXT("title"), Title);
-
-	// Get Blueprint for variable lookups
-	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
-	if (!Blueprint)
-	{
-		return false;
-	}
+	const FBlueprintGraphDescription& Description = Context.Description;
+	const FString& NodeType = Description.GetString(NodeDescription.Type);
+	const FString& Title = Description.GetString(NodeDescription.Title);
 
 	// Configure based on node type
 	if (NodeType == TEXT("K2Node_CallFunction"))
 	{
+		// Serialized member reference: one direct lookup, no class scan
+		if (ApplyMemberReference(Node, TEXT("FunctionReference"), Context, NodeDescription, /*bIsFunction*/ true))
+		{
+			return true;
+		}
+
 		// Extract function name from title (e.g., "Print String" -> "PrintString")
 		FString FunctionName = Title.Replace(TEXT(" "), TEXT(""));
 		
 		// Try to find the function - first check if we have explicit functionName in JSON
-		FString ExplicitFunctionName;
-		if (NodeData->TryGetStringField(TEXT("functionName"), ExplicitFunctionName))
+		if (NodeDescription.FunctionName != INDEX_NONE)
 		{
-			FunctionName = ExplicitFunctionName;
+			FunctionName = Description.GetString(NodeDescription.FunctionName);
 		}
 
 		// Common function mapping (title -> actual function name)
@@ -563,34 +1106,10 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 			FunctionName = TEXT("PrintString");
 		}
 
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Configuring CallFunction node with function: %s"), *FunctionName);
-		
-		// Find the UFunction by name - try common classes
-		UFunction* TargetFunction = nullptr;
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Configuring CallFunction node with function: %s"), *FunctionName);
 		
-		// Try UKismetSystemLibrary first (most common for PrintString, etc.)
-		if (UClass* KismetLibClass = UKismetSystemLibrary::StaticClass())
-		{
-			TargetFunction = KismetLibClass->FindFunctionByName(*FunctionName);
-		}
-		
-		// If not found, search in common classes
-		if (!TargetFunction)
-		{
-			// Try to find in any class
-			for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-			{
-				UClass* TestClass = *ClassIt;
-				if (TestClass && TestClass->IsChildOf(UObject::StaticClass()))
-				{
-					TargetFunction = TestClass->FindFunctionByName(*FunctionName);
-					if (TargetFunction)
-					{
-						break;
-					}
-				}
-			}
-		}
+		// Find the UFunction by name through the session function index (ranked, misses cached)
+		UFunction* TargetFunction = FBlueprintGraphReflectionCache::FindFunction(*FunctionName);
 		
 		if (!TargetFunction)
 		{
@@ -619,7 +1138,7 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 					MemberParentProp->SetObjectPropertyValue_InContainer(FunctionRefPtr, TargetFunction->GetOuterUClass());
 				}
 				
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set FunctionReference for %s"), *FunctionName);
+				UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set FunctionReference for %s"), *FunctionName);
 				return true;
 			}
 		}
@@ -629,290 +1148,41 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 	}
 	else if (NodeType == TEXT("K2Node_VariableGet"))
 	{
-		FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Configuring VariableGet Node: %s"), *Title));
+		UNREALGRAPH_LOG_SECTION(Verbose, FString::Printf(TEXT("Configuring VariableGet Node: %s"), *Title));
 		
-		// Extract variable name from title (e.g., "Get In String" -> "In String")
-		FString VariableName = Title;
-		if (VariableName.StartsWith(TEXT("Get ")))
-		{
-			VariableName = VariableName.RightChop(4); // Remove "Get "
-		}
-
-		// Try explicit variableName in JSON (preferred method)
-		FString ExplicitVariableName;
-		if (NodeData->TryGetStringField(TEXT("variableName"), ExplicitVariableName))
-		{
-			VariableName = ExplicitVariableName;
-			FUnrealGraphLogger::LogFormatted(TEXT("  Using explicit variableName from JSON: %s"), *VariableName);
-		}
-		else
-		{
-			FUnrealGraphLogger::LogFormatted(TEXT("  Extracted variable name from title: %s"), *VariableName);
-		}
-
-		if (VariableName.IsEmpty())
-		{
-			FUnrealGraphLogger::Log(TEXT("  ✗ ERROR: Variable name is empty"));
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Variable name is empty for VariableGet node"));
-			return false;
-		}
-
-		FName VariableNameAsFName = *VariableName;
-		FUnrealGraphLogger::LogFormatted(TEXT("  Searching for variable: %s"), *VariableName);
-
-		// Find the variable property in the Blueprint
-		FProperty* VariableProperty = nullptr;
-		UClass* VariableOwnerClass = nullptr;
-
-		// First, try to find in the Blueprint's GeneratedClass (fully compiled)
-		if (Blueprint->GeneratedClass)
-		{
-			VariableProperty = Blueprint->GeneratedClass->FindPropertyByName(VariableNameAsFName);
-			if (VariableProperty)
-			{
-				VariableOwnerClass = Blueprint->GeneratedClass;
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in GeneratedClass: %s"), *Blueprint->GeneratedClass->GetName());
-			}
-		}
-
-		// If not found, try SkeletonClass (available earlier in compilation)
-		if (!VariableProperty && Blueprint->SkeletonGeneratedClass)
-		{
-			VariableProperty = Blueprint->SkeletonGeneratedClass->FindPropertyByName(VariableNameAsFName);
-			if (VariableProperty)
-			{
-				VariableOwnerClass = Blueprint->SkeletonGeneratedClass;
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in SkeletonGeneratedClass: %s"), *Blueprint->SkeletonGeneratedClass->GetName());
-			}
-		}
-
-		// If still not found, try searching in parent classes
-		if (!VariableProperty)
-		{
-			UClass* ParentClass = Blueprint->ParentClass;
-			if (ParentClass)
-			{
-				// Search through the class hierarchy
-				for (UClass* Class = ParentClass; Class; Class = Class->GetSuperClass())
-				{
-					VariableProperty = Class->FindPropertyByName(VariableNameAsFName);
-					if (VariableProperty)
-					{
-						VariableOwnerClass = Class;
-						FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in parent class: %s"), *Class->GetName());
-						break;
-					}
-				}
-			}
-		}
-
-		// If still not found, search through all properties in the Blueprint class hierarchy
-		if (!VariableProperty)
-		{
-			UClass* SearchClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass : Blueprint->SkeletonGeneratedClass;
-			if (SearchClass)
-			{
-				// Iterate through all properties, including super class properties
-				for (UClass* Class = SearchClass; Class && !VariableProperty; Class = Class->GetSuperClass())
-				{
-					for (TFieldIterator<FProperty> PropIt(Class); PropIt; ++PropIt)
-					{
-						FProperty* TestProp = *PropIt;
-						if (TestProp && TestProp->GetFName() == VariableNameAsFName)
-						{
-							VariableProperty = TestProp;
-							VariableOwnerClass = Class;
-							FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable via property iteration in class %s: %s"), *Class->GetName(), *TestProp->GetName());
-							break;
-						}
-					}
-				}
-			}
-		}
-
-		if (!VariableProperty || !VariableOwnerClass)
-		{
-			FUnrealGraphLogger::LogFormatted(TEXT("  ✗ ERROR: Could not find variable '%s' in Blueprint '%s'"), *VariableName, Blueprint ? *Blueprint->GetName() : TEXT("None"));
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find variable '%s' in Blueprint"), *VariableName);
-			return false;
-		}
-
-		// Set the VariableReference struct using reflection (similar to FunctionReference)
-		FStructProperty* VariableRefProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(TEXT("VariableReference")));
-		if (VariableRefProp && VariableRefProp->Struct)
+		// Serialized member reference: one direct lookup, no class hierarchy walk
+		if (ApplyMemberReference(Node, TEXT("VariableReference"), Context, NodeDescription, /*bIsFunction*/ false))
 		{
-			// Get pointer to VariableReference struct
-			void* VariableRefPtr = VariableRefProp->ContainerPtrToValuePtr<void>(Node);
-			if (VariableRefPtr)
-			{
-				// Set MemberName (the variable name)
-				if (FNameProperty* MemberNameProp = CastField<FNameProperty>(VariableRefProp->Struct->FindPropertyByName(TEXT("MemberName"))))
-				{
-					MemberNameProp->SetPropertyValue_InContainer(VariableRefPtr, VariableNameAsFName);
-					FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Set VariableReference.MemberName = %s"), *VariableName);
-				}
-
-				// Set MemberParent (the class that contains the variable)
-				if (FObjectProperty* MemberParentProp = CastField<FObjectProperty>(VariableRefProp->Struct->FindPropertyByName(TEXT("MemberParent"))))
-				{
-					MemberParentProp->SetObjectPropertyValue_InContainer(VariableRefPtr, VariableOwnerClass);
-					FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Set VariableReference.MemberParent = %s"), VariableOwnerClass ? *VariableOwnerClass->GetName() : TEXT("None"));
-				}
-
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ SUCCESS: VariableReference configured for variable '%s'"), *VariableName);
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set VariableReference for variable '%s' in class '%s'"), *VariableName, VariableOwnerClass ? *VariableOwnerClass->GetName() : TEXT("None"));
-				return true;
-			}
+			return true;
 		}
 
-		FUnrealGraphLogger::Log(TEXT("  ✗ ERROR: Could not set VariableReference property on node"));
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not set VariableReference property on VariableGet node"));
-		return false;
+		return ConfigureVariableReference(Node, Title, TEXT("Get "), Context, NodeDescription);
 	}
 	else if (NodeType == TEXT("K2Node_VariableSet"))
 	{
-		FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Configuring VariableSet Node: %s"), *Title));
+		UNREALGRAPH_LOG_SECTION(Verbose, FString::Printf(TEXT("Configuring VariableSet Node: %s"), *Title));
 		
-		// Extract variable name from title (e.g., "Set In String" -> "In String")
-		FString VariableName = Title;
-		if (VariableName.StartsWith(TEXT("Set ")))
-		{
-			VariableName = VariableName.RightChop(4); // Remove "Set "
-		}
-
-		// Try explicit variableName in JSON (preferred method)
-		FString ExplicitVariableName;
-		if (NodeData->TryGetStringField(TEXT("variableName"), ExplicitVariableName))
-		{
-			VariableName = ExplicitVariableName;
-			FUnrealGraphLogger::LogFormatted(TEXT("  Using explicit variableName from JSON: %s"), *VariableName);
-		}
-		else
-		{
-			FUnrealGraphLogger::LogFormatted(TEXT("  Extracted variable name from title: %s"), *VariableName);
-		}
-
-		if (VariableName.IsEmpty())
-		{
-			FUnrealGraphLogger::Log(TEXT("  ✗ ERROR: Variable name is empty"));
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Variable name is empty for VariableSet node"));
-			return false;
-		}
-
-		FName VariableNameAsFName = *VariableName;
-		FUnrealGraphLogger::LogFormatted(TEXT("  Searching for variable: %s"), *VariableName);
-
-		// Find the variable property in the Blueprint (same logic as VariableGet)
-		FProperty* VariableProperty = nullptr;
-		UClass* VariableOwnerClass = nullptr;
-
-		// First, try to find in the Blueprint's GeneratedClass (fully compiled)
-		if (Blueprint->GeneratedClass)
-		{
-			VariableProperty = Blueprint->GeneratedClass->FindPropertyByName(VariableNameAsFName);
-			if (VariableProperty)
-			{
-				VariableOwnerClass = Blueprint->GeneratedClass;
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in GeneratedClass: %s"), *Blueprint->GeneratedClass->GetName());
-			}
-		}
-
-		// If not found, try SkeletonClass (available earlier in compilation)
-		if (!VariableProperty && Blueprint->SkeletonGeneratedClass)
-		{
-			VariableProperty = Blueprint->SkeletonGeneratedClass->FindPropertyByName(VariableNameAsFName);
-			if (VariableProperty)
-			{
-				VariableOwnerClass = Blueprint->SkeletonGeneratedClass;
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in SkeletonGeneratedClass: %s"), *Blueprint->SkeletonGeneratedClass->GetName());
-			}
-		}
-
-		// If still not found, try searching in parent classes
-		if (!VariableProperty)
-		{
-			UClass* ParentClass = Blueprint->ParentClass;
-			if (ParentClass)
-			{
-				// Search through the class hierarchy
-				for (UClass* Class = ParentClass; Class; Class = Class->GetSuperClass())
-				{
-					VariableProperty = Class->FindPropertyByName(VariableNameAsFName);
-					if (VariableProperty)
-					{
-						VariableOwnerClass = Class;
-						FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable in parent class: %s"), *Class->GetName());
-						break;
-					}
-				}
-			}
-		}
-
-		// If still not found, search through all properties in the Blueprint class hierarchy
-		if (!VariableProperty)
-		{
-			UClass* SearchClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass : Blueprint->SkeletonGeneratedClass;
-			if (SearchClass)
-			{
-				// Iterate through all properties, including super class properties
-				for (UClass* Class = SearchClass; Class && !VariableProperty; Class = Class->GetSuperClass())
-				{
-					for (TFieldIterator<FProperty> PropIt(Class); PropIt; ++PropIt)
-					{
-						FProperty* TestProp = *PropIt;
-						if (TestProp && TestProp->GetFName() == VariableNameAsFName)
-						{
-							VariableProperty = TestProp;
-							VariableOwnerClass = Class;
-							FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Found variable via property iteration in class %s: %s"), *Class->GetName(), *TestProp->GetName());
-							break;
-						}
-					}
-				}
-			}
-		}
-
-		if (!VariableProperty || !VariableOwnerClass)
+		// Serialized member reference: one direct lookup, no class hierarchy walk
+		if (ApplyMemberReference(Node, TEXT("VariableReference"), Context, NodeDescription, /*bIsFunction*/ false))
 		{
-			FUnrealGraphLogger::LogFormatted(TEXT("  ✗ ERROR: Could not find variable '%s' in Blueprint '%s'"), *VariableName, Blueprint ? *Blueprint->GetName() : TEXT("None"));
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find variable '%s' in Blueprint"), *VariableName);
-			return false;
+			return true;
 		}
 
-		// Set the VariableReference struct using reflection (same as VariableGet)
-		FStructProperty* VariableRefProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(TEXT("VariableReference")));
-		if (VariableRefProp && VariableRefProp->Struct)
+		return ConfigureVariableReference(Node, Title, TEXT("Set "), Context, NodeDescription);
+	}
+	else if (NodeType == TEXT("K2Node_Event"))
+	{
+		// Serialized member reference: one direct lookup, no class scan
+		if (ApplyMemberReference(Node, TEXT("EventReference"), Context, NodeDescription, /*bIsFunction*/ true))
 		{
-			// Get pointer to VariableReference struct
-			void* VariableRefPtr = VariableRefProp->ContainerPtrToValuePtr<void>(Node);
-			if (VariableRefPtr)
+			// Standard events shouldn't have CustomFunctionName set
+			if (FNameProperty* CustomFunctionNameProp = CastField<FNameProperty>(Node->GetClass()->FindPropertyByName(TEXT("CustomFunctionName"))))
 			{
-				// Set MemberName (the variable name)
-				if (FNameProperty* MemberNameProp = CastField<FNameProperty>(VariableRefProp->Struct->FindPropertyByName(TEXT("MemberName"))))
-				{
-					MemberNameProp->SetPropertyValue_InContainer(VariableRefPtr, VariableNameAsFName);
-					FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Set VariableReference.MemberName = %s"), *VariableName);
-				}
-
-				// Set MemberParent (the class that contains the variable)
-				if (FObjectProperty* MemberParentProp = CastField<FObjectProperty>(VariableRefProp->Struct->FindPropertyByName(TEXT("MemberParent"))))
-				{
-					MemberParentProp->SetObjectPropertyValue_InContainer(VariableRefPtr, VariableOwnerClass);
-					FUnrealGraphLogger::LogFormatted(TEXT("  ✓ Set VariableReference.MemberParent = %s"), VariableOwnerClass ? *VariableOwnerClass->GetName() : TEXT("None"));
-				}
-
-				FUnrealGraphLogger::LogFormatted(TEXT("  ✓ SUCCESS: VariableReference configured for variable '%s'"), *VariableName);
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set VariableReference for VariableSet variable '%s' in class '%s'"), *VariableName, VariableOwnerClass ? *VariableOwnerClass->GetName() : TEXT("None"));
-				return true;
+				CustomFunctionNameProp->SetPropertyValue_InContainer(Node, NAME_None);
 			}
+			return true;
 		}
 
-		FUnrealGraphLogger::Log(TEXT("  ✗ ERROR: Could not set VariableReference property on node"));
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not set VariableReference property on VariableSet node"));
-		return false;
-	}
-	else if (NodeType == TEXT("K2Node_Event"))
-	{
 		// Extract event name from title (e.g., "Event BeginPlay" -> "BeginPlay")
 		FString EventName = Title;
 		if (EventName.StartsWith(TEXT("Event ")))
@@ -921,19 +1191,18 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 		}
 
 		// Try explicit eventName in JSON
-		FString ExplicitEventName;
-		if (NodeData->TryGetStringField(TEXT("eventName"), ExplicitEventName))
+		if (NodeDescription.EventName != INDEX_NONE)
 		{
-			EventName = ExplicitEventName;
+			EventName = Description.GetString(NodeDescription.EventName);
 		}
 
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Configuring Event node with event: %s"), *EventName);
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Configuring Event node with event: %s"), *EventName);
 		
 		// Check if we have the event class path from serialization (most reliable)
-		FString EventClassPath;
-		FString EventClassName;
-		if (NodeData->TryGetStringField(TEXT("eventClassPath"), EventClassPath))
+		if (NodeDescription.EventClassPath != INDEX_NONE)
 		{
+			const FString& EventClassPath = Description.GetString(NodeDescription.EventClassPath);
+
 			// Load the class from the path
 			UClass* EventClass = LoadClass<UObject>(nullptr, *EventClassPath);
 			if (EventClass)
@@ -967,7 +1236,7 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 								MemberParentProp->SetObjectPropertyValue_InContainer(EventRefPtr, EventClass);
 							}
 							
-							UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set EventReference for %s from serialized class path %s"), 
+							UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set EventReference for %s from serialized class path %s"), 
 								*EventName, *EventClassPath);
 							return true;
 						}
@@ -985,22 +1254,23 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 			EventFunction = ActorClass->FindFunctionByName(*EventName);
 		}
 		
-		// If not found in AActor, search in other common classes
+		// If not found in AActor, prefer an overridable event among the indexed candidates
 		if (!EventFunction)
 		{
-			// Search in all classes
-			for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+			TArray<UFunction*> Candidates;
+			FBlueprintGraphReflectionCache::GetFunctionCandidates(*EventName, Candidates);
+			for (UFunction* Candidate : Candidates)
 			{
-				UClass* TestClass = *ClassIt;
-				if (TestClass && TestClass->IsChildOf(UObject::StaticClass()))
+				if (Candidate->HasAnyFunctionFlags(FUNC_BlueprintEvent))
 				{
-					EventFunction = TestClass->FindFunctionByName(*EventName);
-					if (EventFunction)
-					{
-						break;
-					}
+					EventFunction = Candidate;
+					break;
 				}
 			}
+			if (!EventFunction && Candidates.Num() > 0)
+			{
+				EventFunction = Candidates[0];
+			}
 		}
 		
 		// Set EventReference struct if we found the function
@@ -1030,23 +1300,20 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 					MemberParentProp->SetObjectPropertyValue_InContainer(EventRefPtr, FunctionClass);
 				}
 				
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set EventReference for %s from class %s"), 
+				UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set EventReference for %s from class %s"), 
 					*EventName, *EventFunction->GetOuterUClass()->GetName());
 				return true;
 			}
 		}
 		
 		// Last resort: Set as custom event if we can't find the standard event
-		bool bIsCustomEvent = false;
-		NodeData->TryGetBoolField(TEXT("isCustomEvent"), bIsCustomEvent);
-		
-		if (bIsCustomEvent)
+		if (NodeDescription.bIsCustomEvent)
 		{
 			FNameProperty* CustomFunctionNameProp = CastField<FNameProperty>(Node->GetClass()->FindPropertyByName(TEXT("CustomFunctionName")));
 			if (CustomFunctionNameProp)
 			{
 				CustomFunctionNameProp->SetPropertyValue_InContainer(Node, *EventName);
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Set CustomFunctionName to %s (custom event)"), *EventName);
+				UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set CustomFunctionName to %s (custom event)"), *EventName);
 			}
 		}
 		
@@ -1056,47 +1323,190 @@ bool FBlueprintGraphDeserializer::ConfigureNodeProperties(UEdGraphNode* Node, co
 	return false;
 }
 
-void FBlueprintGraphDeserializer::RestorePinDefaultValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData)
+bool FBlueprintGraphDeserializer::ConfigureVariableReference(UEdGraphNode* Node, const FString& Title, const TCHAR* TitlePrefix, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription)
 {
-	if (!Node || !NodeData.IsValid())
+	const FBlueprintGraphDescription& Description = Context.Description;
+	UBlueprint* Blueprint = Context.Blueprint;
+
+	// Extract variable name from title (e.g., "Get In String" -> "In String")
+	FString VariableName = Title;
+	VariableName.RemoveFromStart(TitlePrefix, ESearchCase::CaseSensitive);
+
+	// Try explicit variableName in JSON (preferred method)
+	if (NodeDescription.VariableName != INDEX_NONE)
 	{
-		return;
+		VariableName = Description.GetString(NodeDescription.VariableName);
+		UNREALGRAPH_LOG(Verbose, TEXT("  Using explicit variableName from JSON: %s"), *VariableName);
+	}
+	else
+	{
+		UNREALGRAPH_LOG(Verbose, TEXT("  Extracted variable name from title: %s"), *VariableName);
 	}
 
-	// Get pins array from JSON
-	const TArray<TSharedPtr<FJsonValue>>* PinsArrayPtr;
-	if (!NodeData->TryGetArrayField(TEXT("pins"), PinsArrayPtr))
+	if (VariableName.IsEmpty())
 	{
-		return;
+		UNREALGRAPH_LOG(Error, TEXT("  ✗ ERROR: Variable name is empty"));
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Variable name is empty for %s node"), *Node->GetClass()->GetName());
+		return false;
 	}
 
-	// Create a map of pin names to default values from JSON
-	TMap<FString, FString> PinDefaultValues;
-	for (const TSharedPtr<FJsonValue>& PinValue : *PinsArrayPtr)
+	const FName VariableNameAsFName = *VariableName;
+	UNREALGRAPH_LOG(Trace, TEXT("  Searching for variable: %s"), *VariableName);
+
+	// Search order: GeneratedClass (fully compiled), SkeletonGeneratedClass (available earlier in compilation),
+	// then the parent class. FindPropertyByName covers inherited properties, and each (class, name) lookup
+	// is cached for the session so repeated variable nodes resolve without walking the class again.
+	UClass* const SearchClasses[] = { Blueprint->GeneratedClass, Blueprint->SkeletonGeneratedClass, Blueprint->ParentClass };
+
+	FProperty* VariableProperty = nullptr;
+	UClass* VariableOwnerClass = nullptr;
+	for (UClass* SearchClass : SearchClasses)
 	{
-		const TSharedPtr<FJsonObject>* PinObjectPtr;
-		if (PinValue->TryGetObject(PinObjectPtr))
+		VariableProperty = FBlueprintGraphReflectionCache::FindClassProperty(SearchClass, VariableNameAsFName);
+		if (VariableProperty)
 		{
-			FString PinName;
-			FString DefaultValue;
-			
-			if ((*PinObjectPtr)->TryGetStringField(TEXT("name"), PinName) &&
-				(*PinObjectPtr)->TryGetStringField(TEXT("defaultValue"), DefaultValue))
-			{
-				PinDefaultValues.Add(PinName, DefaultValue);
-			}
+			VariableOwnerClass = SearchClass;
+			UNREALGRAPH_LOG(Verbose, TEXT("  ✓ Found variable in class: %s"), *SearchClass->GetName());
+			break;
 		}
 	}
 
-	// Restore default values on node pins
-	for (UEdGraphPin* Pin : Node->Pins)
+	if (!VariableProperty || !VariableOwnerClass)
+	{
+		UNREALGRAPH_LOG(Error, TEXT("  ✗ ERROR: Could not find variable '%s' in Blueprint '%s'"), *VariableName, *Blueprint->GetName());
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not find variable '%s' in Blueprint"), *VariableName);
+		return false;
+	}
+
+	FMemberReference* VariableReference = FBlueprintGraphReflectionCache::FindMemberReference(Node, TEXT("VariableReference"));
+	if (!VariableReference)
+	{
+		UNREALGRAPH_LOG(Error, TEXT("  ✗ ERROR: Could not set VariableReference property on node"));
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not set VariableReference property on %s node"), *Node->GetClass()->GetName());
+		return false;
+	}
+
+	// Same MemberName/MemberParent pair the reflection writes used to produce
+	VariableReference->SetExternalMember(VariableNameAsFName, VariableOwnerClass);
+	UNREALGRAPH_LOG(Trace, TEXT("  ✓ Set VariableReference = %s.%s"), *VariableOwnerClass->GetName(), *VariableName);
+
+	UNREALGRAPH_LOG(Verbose, TEXT("  ✓ SUCCESS: VariableReference configured for variable '%s'"), *VariableName);
+	UE_LOG(LogTemp, Verbose, TEXT("UnrealGraph: Set VariableReference for variable '%s' in class '%s'"), *VariableName, *VariableOwnerClass->GetName());
+	return true;
+}
+
+bool FBlueprintGraphDeserializer::ApplyMemberReference(UEdGraphNode* Node, FName ReferencePropertyName, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, bool bIsFunction)
+{
+	const FBlueprintGraphDescription& Description = Context.Description;
+	UBlueprint* Blueprint = Context.Blueprint;
+
+	if (!Node || !Blueprint || !NodeDescription.bHasMemberReference)
+	{
+		// Legacy payload without a member reference
+		return false;
+	}
+
+	FMemberReference* Reference = FBlueprintGraphReflectionCache::FindMemberReference(Node, ReferencePropertyName);
+	const FString& MemberNameString = Description.GetString(NodeDescription.MemberName);
+	if (!Reference || MemberNameString.IsEmpty())
+	{
+		return false;
+	}
+	const FName MemberName(*MemberNameString);
+
+	const FString& ParentPath = Description.GetString(NodeDescription.MemberParent);
+
+	FGuid MemberGuid;
+	if (NodeDescription.MemberGuid != INDEX_NONE)
+	{
+		FGuid::Parse(Description.GetString(NodeDescription.MemberGuid), MemberGuid);
+	}
+
+	const bool bSelfContext = NodeDescription.bSelfContext;
+
+	// Self-context members belong to the Blueprint being pasted into; others name their owner class by path
+	UClass* OwnerClass = nullptr;
+	if (bSelfContext)
+	{
+		OwnerClass = Blueprint->SkeletonGeneratedClass ? Blueprint->SkeletonGeneratedClass : Blueprint->GeneratedClass;
+	}
+	else if (!ParentPath.IsEmpty())
+	{
+		OwnerClass = FindObject<UClass>(nullptr, *ParentPath);
+	}
+
+	if (!OwnerClass)
+	{
+		UNREALGRAPH_LOG(Verbose, TEXT("  Member reference %s: owner class '%s' not found, falling back to name lookup"), *MemberNameString, *ParentPath);
+		return false;
+	}
+
+	// The member must exist on the owner class, by name or (renamed Blueprint members) by GUID, the same
+	// lookup FMemberReference resolves with; anything else would only fail when the Blueprint compiles
+	FName ResolvedName = MemberName;
+	bool bMemberExists = bIsFunction
+		? OwnerClass->FindFunctionByName(MemberName) != nullptr
+		: FBlueprintGraphReflectionCache::FindClassProperty(OwnerClass, MemberName) != nullptr;
+	if (!bMemberExists && MemberGuid.IsValid())
+	{
+		bMemberExists = bIsFunction
+			? UBlueprint::GetFunctionNameFromClassByGuid(OwnerClass, MemberGuid, ResolvedName)
+			: UBlueprint::GetFieldNameFromClassByGuid<FProperty>(OwnerClass, MemberGuid, ResolvedName);
+	}
+	if (!bMemberExists)
+	{
+		UNREALGRAPH_LOG(Verbose, TEXT("  Member reference %s not found on %s, falling back to name lookup"), *MemberNameString, *OwnerClass->GetName());
+		return false;
+	}
+
+	if (bSelfContext)
+	{
+		Reference->SetSelfMember(ResolvedName, MemberGuid);
+	}
+	else
+	{
+		Reference->SetExternalMember(ResolvedName, OwnerClass, MemberGuid);
+	}
+
+	UNREALGRAPH_LOG(Verbose, TEXT("  ✓ Set %s from member reference: %s.%s%s"), *ReferencePropertyName.ToString(),
+		*OwnerClass->GetName(), *ResolvedName.ToString(), bSelfContext ? TEXT(" (self)") : TEXT(""));
+	return true;
+}
+
+void FBlueprintGraphDeserializer::RestorePinDefaultValues(UEdGraphNode* Node, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, const FGraphNodePinIndex& Pins)
+{
+	const FBlueprintGraphDescription& Description = Context.Description;
+
+	if (!Node || NodeDescription.NumPins == 0)
 	{
-		if (Pin && PinDefaultValues.Contains(Pin->PinName.ToString()))
+		return;
+	}
+
+	// Apply in description order, so when the JSON repeats a pin name the last entry wins
+	for (int32 PinIndex = NodeDescription.FirstPin; PinIndex < NodeDescription.FirstPin + NodeDescription.NumPins; ++PinIndex)
+	{
+		const FBlueprintGraphPinDescription& PinDescription = Description.Pins[PinIndex];
+		if (PinDescription.DefaultValue == INDEX_NONE || PinDescription.Name == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FName PinName(*Description.GetString(PinDescription.Name), FNAME_Find);
+		if (PinName.IsNone())
 		{
-			FString DefaultValue = PinDefaultValues[Pin->PinName.ToString()];
+			continue;
+		}
+
+		UEdGraphPin* Pin = Pins.FindPin(PinName, PinDescription.Direction);
+		if (!Pin)
+		{
+			Pin = Pins.FindPin(PinName);
+		}
+		if (Pin)
+		{
+			const FString& DefaultValue = Description.GetString(PinDescription.DefaultValue);
 			Pin->DefaultValue = DefaultValue;
 			Pin->AutogeneratedDefaultValue = DefaultValue;
 		}
 	}
 }
-
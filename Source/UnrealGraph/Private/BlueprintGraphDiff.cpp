@@ -0,0 +1,548 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintGraphDiff.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphSerializer.h"
+#include "UnrealGraphLogger.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+const TCHAR* const FBlueprintGraphDiff::PatchVersion = TEXT("1.0");
+
+namespace
+{
+	/** Case-sensitive string lookup (pin names and ids are compared exactly) */
+	template <typename ValueType>
+	using TCaseSensitiveStringMap = TMap<FString, ValueType, FDefaultSetAllocator, TCaseSensitiveStringMapKeyFuncs<ValueType>>;
+
+	/**
+	 * A string field of two descriptions: equal when both are absent, or both present with the same text
+	 */
+	bool SameString(const FBlueprintGraphDescription& Base, int32 BaseIndex, const FBlueprintGraphDescription& Target, int32 TargetIndex)
+	{
+		return (BaseIndex == INDEX_NONE) == (TargetIndex == INDEX_NONE)
+			&& Base.GetString(BaseIndex).Equals(Target.GetString(TargetIndex), ESearchCase::CaseSensitive);
+	}
+
+	/**
+	 * Whether a node can be updated in place: same class, member and pin layout. Anything else is
+	 * decided while the node is configured and its pins allocated, so the node is re-created.
+	 */
+	bool SameNodeShape(const FBlueprintGraphDescription& Base, const FBlueprintGraphNodeDescription& BaseNode, const FBlueprintGraphDescription& Target, const FBlueprintGraphNodeDescription& TargetNode)
+	{
+		if (!SameString(Base, BaseNode.Type, Target, TargetNode.Type)
+			|| !SameString(Base, BaseNode.ClassPath, Target, TargetNode.ClassPath)
+			|| !SameString(Base, BaseNode.Title, Target, TargetNode.Title)
+			|| !SameString(Base, BaseNode.FunctionName, Target, TargetNode.FunctionName)
+			|| !SameString(Base, BaseNode.VariableName, Target, TargetNode.VariableName)
+			|| !SameString(Base, BaseNode.EventName, Target, TargetNode.EventName)
+			|| !SameString(Base, BaseNode.EventClass, Target, TargetNode.EventClass)
+			|| !SameString(Base, BaseNode.EventClassPath, Target, TargetNode.EventClassPath)
+			|| BaseNode.bHasIsCustomEvent != TargetNode.bHasIsCustomEvent
+			|| BaseNode.bIsCustomEvent != TargetNode.bIsCustomEvent
+			|| BaseNode.bHasMemberReference != TargetNode.bHasMemberReference)
+		{
+			return false;
+		}
+
+		if (BaseNode.bHasMemberReference
+			&& (!SameString(Base, BaseNode.MemberName, Target, TargetNode.MemberName)
+				|| !SameString(Base, BaseNode.MemberParent, Target, TargetNode.MemberParent)
+				|| !SameString(Base, BaseNode.MemberGuid, Target, TargetNode.MemberGuid)
+				|| BaseNode.bSelfContext != TargetNode.bSelfContext))
+		{
+			return false;
+		}
+
+		if (BaseNode.NumPins != TargetNode.NumPins)
+		{
+			return false;
+		}
+		for (int32 PinIndex = 0; PinIndex < BaseNode.NumPins; ++PinIndex)
+		{
+			const FBlueprintGraphPinDescription& BasePin = Base.Pins[BaseNode.FirstPin + PinIndex];
+			const FBlueprintGraphPinDescription& TargetPin = Target.Pins[TargetNode.FirstPin + PinIndex];
+			if (BasePin.Direction != TargetPin.Direction
+				|| !SameString(Base, BasePin.Name, Target, TargetPin.Name)
+				|| !SameString(Base, BasePin.Category, Target, TargetPin.Category)
+				|| !SameString(Base, BasePin.SubCategory, Target, TargetPin.SubCategory))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Index of each node by id; with duplicate ids the first node wins, as when endpoints are resolved */
+	TCaseSensitiveStringMap<int32> IndexNodesById(const FBlueprintGraphDescription& Description)
+	{
+		TCaseSensitiveStringMap<int32> NodeIndexById;
+		NodeIndexById.Reserve(Description.Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Description.Nodes.Num(); ++NodeIndex)
+		{
+			NodeIndexById.FindOrAdd(Description.GetString(Description.Nodes[NodeIndex].Id), NodeIndex);
+		}
+		return NodeIndexById;
+	}
+
+	/** Node id of a connection endpoint, whether it uses the index or the id form */
+	const FString& GetEndpointNodeId(const FBlueprintGraphDescription& Description, const FBlueprintGraphConnectionEndpoint& Endpoint)
+	{
+		return Endpoint.Node != INDEX_NONE ? Description.GetString(Description.Nodes[Endpoint.Node].Id) : Description.GetString(Endpoint.NodeId);
+	}
+
+	/** Pin name of a connection endpoint, whether it uses the index or the name form */
+	const FString& GetEndpointPinName(const FBlueprintGraphDescription& Description, const FBlueprintGraphConnectionEndpoint& Endpoint)
+	{
+		const FBlueprintGraphPinDescription* Pin = Description.GetEndpointPin(Endpoint);
+		return Pin ? Description.GetString(Pin->Name) : Description.GetString(Endpoint.PinName);
+	}
+
+	/** Identity of a link across documents: node ids and pin names of both ends */
+	FString GetLinkKey(const FBlueprintGraphDescription& Description, const FBlueprintGraphConnectionDescription& Connection)
+	{
+		return FString::Printf(TEXT("%s\n%s\n%s\n%s"),
+			*GetEndpointNodeId(Description, Connection.From), *GetEndpointPinName(Description, Connection.From),
+			*GetEndpointNodeId(Description, Connection.To), *GetEndpointPinName(Description, Connection.To));
+	}
+
+	int32 CopyString(const FBlueprintGraphDescription& Source, int32 Index, FBlueprintGraphDescription& Destination)
+	{
+		return Index == INDEX_NONE ? INDEX_NONE : Destination.AddString(Source.GetString(Index));
+	}
+
+	/** Append a node and its pins to another description */
+	void CopyNode(const FBlueprintGraphDescription& Source, const FBlueprintGraphNodeDescription& Node, FBlueprintGraphDescription& Destination)
+	{
+		FBlueprintGraphNodeDescription& Copy = Destination.Nodes.Add_GetRef(Node);
+		Copy.Id = CopyString(Source, Node.Id, Destination);
+		Copy.Type = CopyString(Source, Node.Type, Destination);
+		Copy.ClassPath = CopyString(Source, Node.ClassPath, Destination);
+		Copy.Title = CopyString(Source, Node.Title, Destination);
+		Copy.FunctionName = CopyString(Source, Node.FunctionName, Destination);
+		Copy.VariableName = CopyString(Source, Node.VariableName, Destination);
+		Copy.EventName = CopyString(Source, Node.EventName, Destination);
+		Copy.EventClass = CopyString(Source, Node.EventClass, Destination);
+		Copy.EventClassPath = CopyString(Source, Node.EventClassPath, Destination);
+		Copy.MemberName = CopyString(Source, Node.MemberName, Destination);
+		Copy.MemberParent = CopyString(Source, Node.MemberParent, Destination);
+		Copy.MemberGuid = CopyString(Source, Node.MemberGuid, Destination);
+
+		Copy.FirstPin = Destination.Pins.Num();
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			FBlueprintGraphPinDescription& PinCopy = Destination.Pins.Add_GetRef(Source.Pins[PinIndex]);
+			PinCopy.Name = CopyString(Source, PinCopy.Name, Destination);
+			PinCopy.Category = CopyString(Source, PinCopy.Category, Destination);
+			PinCopy.SubCategory = CopyString(Source, PinCopy.SubCategory, Destination);
+			PinCopy.DefaultValue = CopyString(Source, PinCopy.DefaultValue, Destination);
+		}
+	}
+
+	/** The endpoint in the id/name form, as a node that is already in the graph is referred to */
+	FBlueprintGraphConnectionEndpoint MakeNamedEndpoint(const FBlueprintGraphDescription& Source, const FBlueprintGraphConnectionEndpoint& Endpoint, FBlueprintGraphDescription& Destination)
+	{
+		FBlueprintGraphConnectionEndpoint Named;
+		Named.NodeId = Destination.AddString(GetEndpointNodeId(Source, Endpoint));
+		Named.PinName = Destination.AddString(GetEndpointPinName(Source, Endpoint));
+		return Named;
+	}
+
+	/** Read a fixed-size JSON array such as [id, x, y] */
+	bool ReadTuple(const TSharedPtr<FJsonValue>& Value, int32 NumFields, TArray<const FJsonValue*, TInlineAllocator<4>>& OutFields)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Fields = nullptr;
+		if (!Value.IsValid() || !Value->TryGetArray(Fields) || Fields->Num() != NumFields)
+		{
+			return false;
+		}
+		OutFields.Reset();
+		for (const TSharedPtr<FJsonValue>& Field : *Fields)
+		{
+			OutFields.Add(Field.Get());
+		}
+		return true;
+	}
+}
+
+void FBlueprintGraphDiff::Diff(const FBlueprintGraphDescription& Base, const FBlueprintGraphDescription& Target, FBlueprintGraphPatch& OutPatch)
+{
+	OutPatch.Reset();
+	FBlueprintGraphDescription& Added = OutPatch.Added;
+	Added.Version = CopyString(Target, Target.Version, Added);
+	Added.UnrealVersion = CopyString(Target, Target.UnrealVersion, Added);
+	Added.ExportDate = CopyString(Target, Target.ExportDate, Added);
+
+	const TCaseSensitiveStringMap<int32> BaseIndexById = IndexNodesById(Base);
+	const TCaseSensitiveStringMap<int32> TargetIndexById = IndexNodesById(Target);
+
+	// Base nodes that do not survive (removed or replaced); links to them go away with them
+	TBitArray<> BaseNodeGone(false, Base.Nodes.Num());
+
+	// Position of each target node in Added, INDEX_NONE for nodes that are updated in place
+	TArray<int32> AddedIndexOfTarget;
+	AddedIndexOfTarget.Init(INDEX_NONE, Target.Nodes.Num());
+
+	int32 NumReplaced = 0;
+	for (int32 TargetIndex = 0; TargetIndex < Target.Nodes.Num(); ++TargetIndex)
+	{
+		const FBlueprintGraphNodeDescription& TargetNode = Target.Nodes[TargetIndex];
+		const FString& Id = Target.GetString(TargetNode.Id);
+		const int32* BaseIndex = BaseIndexById.Find(Id);
+		const bool bFirstWithId = TargetIndexById.FindChecked(Id) == TargetIndex;
+
+		if (BaseIndex && bFirstWithId)
+		{
+			const FBlueprintGraphNodeDescription& BaseNode = Base.Nodes[*BaseIndex];
+			if (SameNodeShape(Base, BaseNode, Target, TargetNode))
+			{
+				if (TargetNode.bHasPosition && (!BaseNode.bHasPosition || BaseNode.PositionX != TargetNode.PositionX || BaseNode.PositionY != TargetNode.PositionY))
+				{
+					FBlueprintGraphNodeMove& Move = OutPatch.MovedNodes.AddDefaulted_GetRef();
+					Move.Id = Added.AddString(Id);
+					Move.PositionX = TargetNode.PositionX;
+					Move.PositionY = TargetNode.PositionY;
+				}
+
+				// Same layout, so pins correspond by index
+				for (int32 PinIndex = 0; PinIndex < TargetNode.NumPins; ++PinIndex)
+				{
+					const FBlueprintGraphPinDescription& BasePin = Base.Pins[BaseNode.FirstPin + PinIndex];
+					const FBlueprintGraphPinDescription& TargetPin = Target.Pins[TargetNode.FirstPin + PinIndex];
+					if (!SameString(Base, BasePin.DefaultValue, Target, TargetPin.DefaultValue))
+					{
+						FBlueprintGraphPinDefaultChange& Change = OutPatch.ChangedDefaults.AddDefaulted_GetRef();
+						Change.Id = Added.AddString(Id);
+						Change.PinName = CopyString(Target, TargetPin.Name, Added);
+						Change.Direction = TargetPin.Direction;
+						Change.DefaultValue = CopyString(Target, TargetPin.DefaultValue, Added);
+					}
+				}
+				continue;
+			}
+
+			// Replaced: removed here, re-created from the target below under the same id
+			BaseNodeGone[*BaseIndex] = true;
+			OutPatch.RemovedNodes.Add(Added.AddString(Id));
+			++NumReplaced;
+		}
+
+		AddedIndexOfTarget[TargetIndex] = Added.Nodes.Num();
+		CopyNode(Target, TargetNode, Added);
+	}
+
+	for (int32 BaseIndex = 0; BaseIndex < Base.Nodes.Num(); ++BaseIndex)
+	{
+		const FString& Id = Base.GetString(Base.Nodes[BaseIndex].Id);
+		if (!TargetIndexById.Contains(Id))
+		{
+			BaseNodeGone[BaseIndex] = true;
+			OutPatch.RemovedNodes.Add(Added.AddString(Id));
+		}
+	}
+
+	// Links
+	TCaseSensitiveStringMap<int32> BaseLinks;
+	BaseLinks.Reserve(Base.Connections.Num());
+	for (int32 ConnectionIndex = 0; ConnectionIndex < Base.Connections.Num(); ++ConnectionIndex)
+	{
+		BaseLinks.Add(GetLinkKey(Base, Base.Connections[ConnectionIndex]), ConnectionIndex);
+	}
+
+	auto MakeAddedEndpoint = [&Target, &Added](const FBlueprintGraphConnectionEndpoint& Endpoint, int32 AddedNode)
+	{
+		if (AddedNode == INDEX_NONE)
+		{
+			return MakeNamedEndpoint(Target, Endpoint, Added);
+		}
+
+		// Pins were copied in order, so index-form pins carry over
+		FBlueprintGraphConnectionEndpoint Indexed;
+		Indexed.Node = AddedNode;
+		Indexed.Pin = Endpoint.Pin;
+		Indexed.PinName = Endpoint.Pin == INDEX_NONE ? CopyString(Target, Endpoint.PinName, Added) : INDEX_NONE;
+		return Indexed;
+	};
+
+	TCaseSensitiveStringMap<int32> TargetLinks;
+	TargetLinks.Reserve(Target.Connections.Num());
+	for (const FBlueprintGraphConnectionDescription& Connection : Target.Connections)
+	{
+		const FString Key = GetLinkKey(Target, Connection);
+		TargetLinks.Add(Key, INDEX_NONE);
+
+		const int32 AddedFrom = Connection.From.Node != INDEX_NONE ? AddedIndexOfTarget[Connection.From.Node] : INDEX_NONE;
+		const int32 AddedTo = Connection.To.Node != INDEX_NONE ? AddedIndexOfTarget[Connection.To.Node] : INDEX_NONE;
+
+		// Links of (re-)created nodes are always added; others only when they are new
+		if (AddedFrom == INDEX_NONE && AddedTo == INDEX_NONE && BaseLinks.Contains(Key))
+		{
+			continue;
+		}
+
+		FBlueprintGraphConnectionDescription& AddedLink = Added.Connections.AddDefaulted_GetRef();
+		AddedLink.From = MakeAddedEndpoint(Connection.From, AddedFrom);
+		AddedLink.To = MakeAddedEndpoint(Connection.To, AddedTo);
+	}
+
+	for (const FBlueprintGraphConnectionDescription& Connection : Base.Connections)
+	{
+		const bool bEndpointGone = (Connection.From.Node != INDEX_NONE && BaseNodeGone[Connection.From.Node])
+			|| (Connection.To.Node != INDEX_NONE && BaseNodeGone[Connection.To.Node]);
+		if (bEndpointGone || TargetLinks.Contains(GetLinkKey(Base, Connection)))
+		{
+			continue;
+		}
+
+		FBlueprintGraphConnectionDescription& RemovedLink = OutPatch.RemovedLinks.AddDefaulted_GetRef();
+		RemovedLink.From = MakeNamedEndpoint(Base, Connection.From, Added);
+		RemovedLink.To = MakeNamedEndpoint(Base, Connection.To, Added);
+	}
+
+	Added.FinishBuilding();
+
+	UNREALGRAPH_LOG(Summary, TEXT("Graph diff: %d added, %d removed, %d replaced, %d moved nodes, %d changed defaults, %d added and %d removed links"),
+		Added.Nodes.Num() - NumReplaced, OutPatch.RemovedNodes.Num() - NumReplaced, NumReplaced, OutPatch.MovedNodes.Num(),
+		OutPatch.ChangedDefaults.Num(), Added.Connections.Num(), OutPatch.RemovedLinks.Num());
+}
+
+bool FBlueprintGraphDiff::DiffJson(const FString& BaseJson, const FString& TargetJson, FString& OutPatchJson, FString& OutError, bool bPrettyPrint)
+{
+	FBlueprintGraphDescription Base;
+	FBlueprintGraphDescription Target;
+	if (!FBlueprintGraphJsonReader::ReadGraph(BaseJson, Base, OutError))
+	{
+		OutError = FString::Printf(TEXT("Invalid base graph: %s"), *OutError);
+		return false;
+	}
+	if (!FBlueprintGraphJsonReader::ReadGraph(TargetJson, Target, OutError))
+	{
+		OutError = FString::Printf(TEXT("Invalid target graph: %s"), *OutError);
+		return false;
+	}
+
+	FBlueprintGraphPatch Patch;
+	Diff(Base, Target, Patch);
+	return WritePatchJson(Patch, OutPatchJson, bPrettyPrint);
+}
+
+bool FBlueprintGraphDiff::WritePatchJson(const FBlueprintGraphPatch& Patch, FString& OutJson, bool bPrettyPrint)
+{
+	const FBlueprintGraphDescription& Strings = Patch.Added;
+
+	// The added section is a graph document of its own, embedded as is (condensed: a raw value cannot be re-indented)
+	FString AddedJson;
+	if (Patch.Added.Nodes.Num() > 0 || Patch.Added.Connections.Num() > 0)
+	{
+		if (!FBlueprintGraphSerializer::WriteDescriptionJson(Patch.Added, AddedJson, /*bPrettyPrint*/ false))
+		{
+			return false;
+		}
+	}
+
+	auto WriteTo = [&Patch, &Strings, &AddedJson](auto& Writer)
+	{
+		Writer.WriteObjectStart();
+
+		Writer.WriteObjectStart(TEXT("patch"));
+		Writer.WriteValue(TEXT("version"), PatchVersion);
+		Writer.WriteObjectEnd();
+
+		if (!AddedJson.IsEmpty())
+		{
+			Writer.WriteRawJSONValue(TEXT("added"), AddedJson);
+		}
+
+		if (Patch.RemovedNodes.Num() > 0)
+		{
+			Writer.WriteArrayStart(TEXT("removedNodes"));
+			for (const int32 Id : Patch.RemovedNodes)
+			{
+				Writer.WriteValue(Strings.GetString(Id));
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		if (Patch.MovedNodes.Num() > 0)
+		{
+			Writer.WriteArrayStart(TEXT("movedNodes"));
+			for (const FBlueprintGraphNodeMove& Move : Patch.MovedNodes)
+			{
+				Writer.WriteArrayStart();
+				Writer.WriteValue(Strings.GetString(Move.Id));
+				Writer.WriteValue(Move.PositionX);
+				Writer.WriteValue(Move.PositionY);
+				Writer.WriteArrayEnd();
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		if (Patch.ChangedDefaults.Num() > 0)
+		{
+			Writer.WriteArrayStart(TEXT("changedDefaults"));
+			for (const FBlueprintGraphPinDefaultChange& Change : Patch.ChangedDefaults)
+			{
+				Writer.WriteArrayStart();
+				Writer.WriteValue(Strings.GetString(Change.Id));
+				Writer.WriteValue(Strings.GetString(Change.PinName));
+				Writer.WriteValue(Change.Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
+				if (Change.DefaultValue != INDEX_NONE)
+				{
+					Writer.WriteValue(Strings.GetString(Change.DefaultValue));
+				}
+				else
+				{
+					Writer.WriteNull();
+				}
+				Writer.WriteArrayEnd();
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		if (Patch.RemovedLinks.Num() > 0)
+		{
+			Writer.WriteArrayStart(TEXT("removedLinks"));
+			for (const FBlueprintGraphConnectionDescription& Link : Patch.RemovedLinks)
+			{
+				Writer.WriteArrayStart();
+				Writer.WriteValue(Strings.GetString(Link.From.NodeId));
+				Writer.WriteValue(Strings.GetString(Link.From.PinName));
+				Writer.WriteValue(Strings.GetString(Link.To.NodeId));
+				Writer.WriteValue(Strings.GetString(Link.To.PinName));
+				Writer.WriteArrayEnd();
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		Writer.WriteObjectEnd();
+		return Writer.Close();
+	};
+
+	OutJson.Reset();
+	if (bPrettyPrint)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+		return WriteTo(*Writer);
+	}
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+	return WriteTo(*Writer);
+}
+
+bool FBlueprintGraphDiff::ReadPatchJson(const FString& PatchJson, FBlueprintGraphPatch& OutPatch, FString& OutError)
+{
+	OutPatch.Reset();
+	OutError.Reset();
+
+	// Patches are small; a DOM read keeps this simple
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PatchJson);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Patch is not valid JSON: %s"), *Reader->GetErrorMessage());
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* PatchInfo = nullptr;
+	FString Version;
+	if (!Root->TryGetObjectField(TEXT("patch"), PatchInfo) || !(*PatchInfo)->TryGetStringField(TEXT("version"), Version))
+	{
+		OutError = TEXT("Missing 'patch' object with a version");
+		return false;
+	}
+	if (FCString::Atoi(*Version) != FCString::Atoi(PatchVersion))
+	{
+		OutError = FString::Printf(TEXT("Unsupported patch version %s"), *Version);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* AddedObject = nullptr;
+	if (Root->TryGetObjectField(TEXT("added"), AddedObject))
+	{
+		if (!FBlueprintGraphJsonReader::ReadGraph(*AddedObject, OutPatch.Added, OutError))
+		{
+			OutError = FString::Printf(TEXT("Invalid 'added' graph: %s"), *OutError);
+			return false;
+		}
+	}
+
+	// The remaining strings go into the same table (appended: the table is complete after ReadGraph)
+	auto AddString = [&OutPatch](const FJsonValue* Value)
+	{
+		FString Text;
+		return Value && !Value->IsNull() && Value->TryGetString(Text) ? OutPatch.Added.Strings.Add(MoveTemp(Text)) : INDEX_NONE;
+	};
+
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	TArray<const FJsonValue*, TInlineAllocator<4>> Fields;
+
+	if (Root->TryGetArrayField(TEXT("removedNodes"), Entries))
+	{
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			const int32 Id = AddString(Entry.Get());
+			if (Id == INDEX_NONE)
+			{
+				OutError = TEXT("'removedNodes' entries must be node ids");
+				return false;
+			}
+			OutPatch.RemovedNodes.Add(Id);
+		}
+	}
+
+	if (Root->TryGetArrayField(TEXT("movedNodes"), Entries))
+	{
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			FBlueprintGraphNodeMove Move;
+			if (!ReadTuple(Entry, 3, Fields) || (Move.Id = AddString(Fields[0])) == INDEX_NONE
+				|| !Fields[1]->TryGetNumber(Move.PositionX) || !Fields[2]->TryGetNumber(Move.PositionY))
+			{
+				OutError = TEXT("'movedNodes' entries must be [id, x, y]");
+				return false;
+			}
+			OutPatch.MovedNodes.Add(Move);
+		}
+	}
+
+	if (Root->TryGetArrayField(TEXT("changedDefaults"), Entries))
+	{
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			FBlueprintGraphPinDefaultChange Change;
+			FString Direction;
+			if (!ReadTuple(Entry, 4, Fields) || (Change.Id = AddString(Fields[0])) == INDEX_NONE
+				|| (Change.PinName = AddString(Fields[1])) == INDEX_NONE || !Fields[2]->TryGetString(Direction))
+			{
+				OutError = TEXT("'changedDefaults' entries must be [id, pin, direction, value]");
+				return false;
+			}
+			Change.Direction = Direction == TEXT("output") ? EGPD_Output : EGPD_Input;
+			Change.DefaultValue = AddString(Fields[3]);
+			OutPatch.ChangedDefaults.Add(Change);
+		}
+	}
+
+	if (Root->TryGetArrayField(TEXT("removedLinks"), Entries))
+	{
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			FBlueprintGraphConnectionDescription Link;
+			if (!ReadTuple(Entry, 4, Fields)
+				|| (Link.From.NodeId = AddString(Fields[0])) == INDEX_NONE || (Link.From.PinName = AddString(Fields[1])) == INDEX_NONE
+				|| (Link.To.NodeId = AddString(Fields[2])) == INDEX_NONE || (Link.To.PinName = AddString(Fields[3])) == INDEX_NONE)
+			{
+				OutError = TEXT("'removedLinks' entries must be [from id, from pin, to id, to pin]");
+				return false;
+			}
+			OutPatch.RemovedLinks.Add(Link);
+		}
+	}
+
+	return true;
+}
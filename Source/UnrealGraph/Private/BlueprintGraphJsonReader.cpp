@@ -0,0 +1,993 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphDescription.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+
+namespace
+{
+	/** A scalar token of TJsonReader, read through the same overloads as a FJsonValue */
+	struct FJsonTokenValue
+	{
+		TJsonReader<TCHAR>& Reader;
+		EJsonNotation Notation;
+	};
+
+	/** String value as TryGetStringField sees it: strings, numbers and booleans */
+	void ReadString(FBlueprintGraphDescription& Description, const FJsonTokenValue& Value, int32& OutIndex)
+	{
+		switch (Value.Notation)
+		{
+		case EJsonNotation::String:
+			OutIndex = Description.AddString(Value.Reader.GetValueAsString());
+			break;
+		case EJsonNotation::Number:
+			OutIndex = Description.AddString(FString::SanitizeFloat(Value.Reader.GetValueAsNumber(), 0));
+			break;
+		case EJsonNotation::Boolean:
+			OutIndex = Description.AddString(Value.Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false"));
+			break;
+		default:
+			break;
+		}
+	}
+
+	void ReadString(FBlueprintGraphDescription& Description, const FJsonValue& Value, int32& OutIndex)
+	{
+		FString String;
+		if (Value.TryGetString(String))
+		{
+			OutIndex = Description.AddString(String);
+		}
+	}
+
+	/** Number value as TryGetNumberField sees it: numbers, numeric strings and booleans */
+	void ReadNumber(const FJsonTokenValue& Value, double& OutValue)
+	{
+		switch (Value.Notation)
+		{
+		case EJsonNotation::Number:
+			OutValue = Value.Reader.GetValueAsNumber();
+			break;
+		case EJsonNotation::String:
+			if (Value.Reader.GetValueAsString().IsNumeric())
+			{
+				OutValue = FCString::Atod(*Value.Reader.GetValueAsString());
+			}
+			break;
+		case EJsonNotation::Boolean:
+			OutValue = Value.Reader.GetValueAsBoolean() ? 1.0 : 0.0;
+			break;
+		default:
+			break;
+		}
+	}
+
+	void ReadNumber(const FJsonValue& Value, double& OutValue)
+	{
+		Value.TryGetNumber(OutValue);
+	}
+
+	/** Bool value as TryGetBoolField sees it: booleans and numbers */
+	bool ReadBool(const FJsonTokenValue& Value, bool& OutValue)
+	{
+		switch (Value.Notation)
+		{
+		case EJsonNotation::Boolean:
+			OutValue = Value.Reader.GetValueAsBoolean();
+			return true;
+		case EJsonNotation::Number:
+			OutValue = Value.Reader.GetValueAsNumber() != 0.0;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool ReadBool(const FJsonValue& Value, bool& OutValue)
+	{
+		return Value.TryGetBool(OutValue);
+	}
+
+	bool IsOutputDirection(const FJsonTokenValue& Value)
+	{
+		return Value.Notation == EJsonNotation::String && Value.Reader.GetValueAsString() == TEXT("output");
+	}
+
+	bool IsOutputDirection(const FJsonValue& Value)
+	{
+		return Value.Type == EJson::String && Value.AsString() == TEXT("output");
+	}
+
+	/**
+	 * State and field mapping shared by the token and the object parser. Field names are matched
+	 * case-insensitively and scalar values are converted the same way FJsonObject::TryGet*Field
+	 * converts them, so both parsers accept what the DOM-based reader accepted.
+	 */
+	class FGraphParserBase
+	{
+	public:
+		explicit FGraphParserBase(FBlueprintGraphDescription& InDescription)
+			: Description(InDescription)
+		{
+		}
+
+		const FString& GetError() const
+		{
+			return Error;
+		}
+
+		/** Resolve schema 1.0 endpoints and range-check index endpoints once every node is known */
+		bool FinishConnections()
+		{
+			if (bHasLegacyConnections)
+			{
+				Description.ResolveConnectionEndpoints();
+			}
+
+			for (int32 ConnectionIndex = 0; ConnectionIndex < Description.Connections.Num(); ++ConnectionIndex)
+			{
+				const FBlueprintGraphConnectionDescription& Connection = Description.Connections[ConnectionIndex];
+				for (const FBlueprintGraphConnectionEndpoint* Endpoint : { &Connection.From, &Connection.To })
+				{
+					const bool bNodeInRange = Endpoint->Node == INDEX_NONE || Description.Nodes.IsValidIndex(Endpoint->Node);
+					const bool bPinInRange = Endpoint->Pin == INDEX_NONE || (bNodeInRange && Description.GetEndpointPin(*Endpoint));
+					if (!bNodeInRange || !bPinInRange)
+					{
+						return Fail(FString::Printf(TEXT("Connection %d refers to a node or pin index out of range"), ConnectionIndex));
+					}
+				}
+			}
+			return true;
+		}
+
+	protected:
+		bool Fail(const FString& Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = Message;
+			}
+			return false;
+		}
+
+		template <typename ValueType>
+		void ReadMetadataField(const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("version"))
+			{
+				ReadString(Description, Value, Description.Version);
+			}
+			else if (Key == TEXT("unrealVersion"))
+			{
+				ReadString(Description, Value, Description.UnrealVersion);
+			}
+			else if (Key == TEXT("exportDate"))
+			{
+				ReadString(Description, Value, Description.ExportDate);
+			}
+		}
+
+		/** Scalar node fields; object and array values are handled by the parsers */
+		template <typename ValueType>
+		void ReadNodeField(FBlueprintGraphNodeDescription& Node, const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("id"))
+			{
+				ReadString(Description, Value, Node.Id);
+			}
+			else if (Key == TEXT("type"))
+			{
+				ReadString(Description, Value, Node.Type);
+			}
+			else if (Key == TEXT("classPath"))
+			{
+				ReadString(Description, Value, Node.ClassPath);
+			}
+			else if (Key == TEXT("title"))
+			{
+				ReadString(Description, Value, Node.Title);
+			}
+			else if (Key == TEXT("functionName"))
+			{
+				ReadString(Description, Value, Node.FunctionName);
+			}
+			else if (Key == TEXT("variableName"))
+			{
+				ReadString(Description, Value, Node.VariableName);
+			}
+			else if (Key == TEXT("eventName"))
+			{
+				ReadString(Description, Value, Node.EventName);
+			}
+			else if (Key == TEXT("eventClass"))
+			{
+				ReadString(Description, Value, Node.EventClass);
+			}
+			else if (Key == TEXT("eventClassPath"))
+			{
+				ReadString(Description, Value, Node.EventClassPath);
+			}
+			else if (Key == TEXT("isCustomEvent"))
+			{
+				Node.bHasIsCustomEvent = ReadBool(Value, Node.bIsCustomEvent);
+			}
+		}
+
+		/** Node validation and pin range once every field of a node has been read */
+		bool FinishNode(FBlueprintGraphNodeDescription& Node)
+		{
+			if (Node.Id == INDEX_NONE || Node.Type == INDEX_NONE)
+			{
+				return Fail(FString::Printf(TEXT("Node %d is missing 'id' or 'type'"), Description.Nodes.Num()));
+			}
+			Node.NumPins = Description.Pins.Num() - Node.FirstPin;
+			Description.Nodes.Add(Node);
+			return true;
+		}
+
+		template <typename ValueType>
+		void ReadPositionField(FBlueprintGraphNodeDescription& Node, const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("x"))
+			{
+				ReadNumber(Value, Node.PositionX);
+			}
+			else if (Key == TEXT("y"))
+			{
+				ReadNumber(Value, Node.PositionY);
+			}
+		}
+
+		template <typename ValueType>
+		void ReadMemberReferenceField(FBlueprintGraphNodeDescription& Node, const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("memberName"))
+			{
+				ReadString(Description, Value, Node.MemberName);
+			}
+			else if (Key == TEXT("memberParent"))
+			{
+				ReadString(Description, Value, Node.MemberParent);
+			}
+			else if (Key == TEXT("memberGuid"))
+			{
+				ReadString(Description, Value, Node.MemberGuid);
+			}
+			else if (Key == TEXT("selfContext"))
+			{
+				ReadBool(Value, Node.bSelfContext);
+			}
+		}
+
+		/** Scalar pin fields; object and array values (including schema 1.0 "connectedNodeIds") are not read */
+		template <typename ValueType>
+		void ReadPinField(FBlueprintGraphPinDescription& Pin, const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("name"))
+			{
+				ReadString(Description, Value, Pin.Name);
+			}
+			else if (Key == TEXT("direction"))
+			{
+				Pin.Direction = IsOutputDirection(Value) ? EGPD_Output : EGPD_Input;
+			}
+			else if (Key == TEXT("pinCategory"))
+			{
+				ReadString(Description, Value, Pin.Category);
+			}
+			else if (Key == TEXT("pinSubCategory"))
+			{
+				ReadString(Description, Value, Pin.SubCategory);
+			}
+			else if (Key == TEXT("defaultValue"))
+			{
+				ReadString(Description, Value, Pin.DefaultValue);
+			}
+		}
+
+		/** Numeric element of a [fromNode, fromPin, toNode, toPin] tuple */
+		bool ReadTupleIndex(double Value, bool bIsPin, FBlueprintGraphConnectionEndpoint& Endpoint)
+		{
+			if (Value < 0.0 || Value > MAX_int32 || FMath::FloorToDouble(Value) != Value)
+			{
+				return Fail(FString::Printf(TEXT("Connection %d has an invalid index"), Description.Connections.Num()));
+			}
+			(bIsPin ? Endpoint.Pin : Endpoint.Node) = static_cast<int32>(Value);
+			return true;
+		}
+
+		bool FinishConnectionTuple(const FBlueprintGraphConnectionDescription& Connection, int32 ElementCount)
+		{
+			if (ElementCount != 4 || !Connection.From.IsValid() || !Connection.To.IsValid())
+			{
+				return Fail(FString::Printf(TEXT("Connection %d is not a [fromNode, fromPin, toNode, toPin] tuple"), Description.Connections.Num()));
+			}
+			Description.Connections.Add(Connection);
+			return true;
+		}
+
+		bool FinishLegacyConnection(const FBlueprintGraphConnectionDescription& Connection)
+		{
+			bHasLegacyConnections = true;
+			if (!Connection.From.IsValid() || !Connection.To.IsValid())
+			{
+				return Fail(FString::Printf(TEXT("Connection %d is missing 'from' or 'to' nodeId/pinName"), Description.Connections.Num()));
+			}
+			Description.Connections.Add(Connection);
+			return true;
+		}
+
+		template <typename ValueType>
+		void ReadLegacyEndpointField(FBlueprintGraphConnectionEndpoint& Endpoint, const FString& Key, const ValueType& Value)
+		{
+			if (Key == TEXT("nodeId"))
+			{
+				ReadString(Description, Value, Endpoint.NodeId);
+			}
+			else if (Key == TEXT("pinName"))
+			{
+				ReadString(Description, Value, Endpoint.PinName);
+			}
+		}
+
+		FBlueprintGraphDescription& Description;
+		FString Error;
+		bool bHasLegacyConnections = false;
+	};
+
+	/**
+	 * Recursive descent over TJsonReader tokens
+	 */
+	class FGraphTokenParser : public FGraphParserBase
+	{
+	public:
+		FGraphTokenParser(TJsonReader<TCHAR>& InReader, FBlueprintGraphDescription& InDescription)
+			: FGraphParserBase(InDescription)
+			, Reader(InReader)
+		{
+		}
+
+		bool ParseRoot()
+		{
+			EJsonNotation Notation;
+			if (!Next(Notation) || Notation != EJsonNotation::ObjectStart)
+			{
+				return Fail(TEXT("Root value is not a JSON object"));
+			}
+
+			bool bHasGraph = false;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return bHasGraph || Fail(TEXT("Missing 'graph' object"));
+				}
+
+				const FString& Key = Reader.GetIdentifier();
+				if (Notation == EJsonNotation::ObjectStart && Key == TEXT("metadata"))
+				{
+					if (!ParseMetadata())
+					{
+						return false;
+					}
+				}
+				else if (Notation == EJsonNotation::ObjectStart && Key == TEXT("graph"))
+				{
+					if (!ParseGraph())
+					{
+						return false;
+					}
+					bHasGraph = true;
+				}
+				else if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+	private:
+		bool Next(EJsonNotation& OutNotation)
+		{
+			if (!Reader.ReadNext(OutNotation) || OutNotation == EJsonNotation::Error)
+			{
+				if (Error.IsEmpty())
+				{
+					Error = Reader.GetErrorMessage().IsEmpty() ? TEXT("Unexpected end of JSON") : Reader.GetErrorMessage();
+				}
+				return false;
+			}
+			return true;
+		}
+
+		/** Skip the value that was just opened */
+		bool Skip(EJsonNotation Notation)
+		{
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				return Reader.SkipObject() || Fail(Reader.GetErrorMessage());
+			}
+			if (Notation == EJsonNotation::ArrayStart)
+			{
+				return Reader.SkipArray() || Fail(Reader.GetErrorMessage());
+			}
+			return true;
+		}
+
+		FJsonTokenValue Token(EJsonNotation Notation) const
+		{
+			return FJsonTokenValue{ Reader, Notation };
+		}
+
+		bool ParseMetadata()
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return true;
+				}
+
+				ReadMetadataField(Reader.GetIdentifier(), Token(Notation));
+				if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseGraph()
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return true;
+				}
+
+				const FString& Key = Reader.GetIdentifier();
+				if (Notation == EJsonNotation::ArrayStart && Key == TEXT("nodes"))
+				{
+					if (!ParseArray(&FGraphTokenParser::ParseNode))
+					{
+						return false;
+					}
+				}
+				else if (Notation == EJsonNotation::ArrayStart && Key == TEXT("connections"))
+				{
+					if (!ParseConnections())
+					{
+						return false;
+					}
+				}
+				else if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		/** Parse every object element of the array that was just opened; other elements are ignored */
+		bool ParseArray(bool (FGraphTokenParser::*ParseElement)())
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ArrayEnd)
+				{
+					return true;
+				}
+
+				if (Notation == EJsonNotation::ObjectStart)
+				{
+					if (!(this->*ParseElement)())
+					{
+						return false;
+					}
+				}
+				else if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseNode()
+		{
+			FBlueprintGraphNodeDescription Node;
+			Node.FirstPin = Description.Pins.Num();
+
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return FinishNode(Node);
+				}
+
+				const FString& Key = Reader.GetIdentifier();
+				if (Notation == EJsonNotation::ObjectStart)
+				{
+					const bool bParsed = Key == TEXT("position") ? ParsePosition(Node)
+						: Key == TEXT("memberReference") ? ParseMemberReference(Node)
+						: Skip(Notation);
+					if (!bParsed)
+					{
+						return false;
+					}
+				}
+				else if (Notation == EJsonNotation::ArrayStart)
+				{
+					const bool bParsed = Key == TEXT("pins") ? ParseArray(&FGraphTokenParser::ParsePin) : Skip(Notation);
+					if (!bParsed)
+					{
+						return false;
+					}
+				}
+				else
+				{
+					ReadNodeField(Node, Key, Token(Notation));
+				}
+			}
+			return false;
+		}
+
+		bool ParsePosition(FBlueprintGraphNodeDescription& Node)
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					Node.bHasPosition = true;
+					return true;
+				}
+
+				ReadPositionField(Node, Reader.GetIdentifier(), Token(Notation));
+				if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseMemberReference(FBlueprintGraphNodeDescription& Node)
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					Node.bHasMemberReference = true;
+					return true;
+				}
+
+				ReadMemberReferenceField(Node, Reader.GetIdentifier(), Token(Notation));
+				if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParsePin()
+		{
+			FBlueprintGraphPinDescription Pin;
+
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					Description.Pins.Add(Pin);
+					return true;
+				}
+
+				if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+				{
+					if (!Skip(Notation))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					ReadPinField(Pin, Reader.GetIdentifier(), Token(Notation));
+				}
+			}
+			return false;
+		}
+
+		/** Connections array: [fromNode, fromPin, toNode, toPin] tuples, or schema 1.0 from/to objects */
+		bool ParseConnections()
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ArrayEnd)
+				{
+					return true;
+				}
+
+				const bool bParsed = Notation == EJsonNotation::ArrayStart ? ParseConnectionTuple()
+					: Notation == EJsonNotation::ObjectStart ? ParseLegacyConnection()
+					: Skip(Notation);
+				if (!bParsed)
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseConnectionTuple()
+		{
+			FBlueprintGraphConnectionDescription Connection;
+			FBlueprintGraphConnectionEndpoint* const Endpoints[] = { &Connection.From, &Connection.To };
+
+			int32 ElementCount = 0;
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ArrayEnd)
+				{
+					return FinishConnectionTuple(Connection, ElementCount);
+				}
+
+				if (ElementCount < 4)
+				{
+					FBlueprintGraphConnectionEndpoint& Endpoint = *Endpoints[ElementCount / 2];
+					const bool bIsPin = (ElementCount % 2) == 1;
+					if (Notation == EJsonNotation::Number)
+					{
+						if (!ReadTupleIndex(Reader.GetValueAsNumber(), bIsPin, Endpoint))
+						{
+							return false;
+						}
+					}
+					else if (Notation == EJsonNotation::String)
+					{
+						ReadString(Description, Token(Notation), bIsPin ? Endpoint.PinName : Endpoint.NodeId);
+					}
+				}
+
+				if (!Skip(Notation))
+				{
+					return false;
+				}
+				++ElementCount;
+			}
+			return false;
+		}
+
+		bool ParseLegacyConnection()
+		{
+			FBlueprintGraphConnectionDescription Connection;
+
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return FinishLegacyConnection(Connection);
+				}
+
+				const FString& Key = Reader.GetIdentifier();
+				if (Notation == EJsonNotation::ObjectStart && Key == TEXT("from"))
+				{
+					if (!ParseLegacyEndpoint(Connection.From))
+					{
+						return false;
+					}
+				}
+				else if (Notation == EJsonNotation::ObjectStart && Key == TEXT("to"))
+				{
+					if (!ParseLegacyEndpoint(Connection.To))
+					{
+						return false;
+					}
+				}
+				else if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseLegacyEndpoint(FBlueprintGraphConnectionEndpoint& OutEndpoint)
+		{
+			EJsonNotation Notation;
+			while (Next(Notation))
+			{
+				if (Notation == EJsonNotation::ObjectEnd)
+				{
+					return true;
+				}
+
+				ReadLegacyEndpointField(OutEndpoint, Reader.GetIdentifier(), Token(Notation));
+				if (!Skip(Notation))
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		TJsonReader<TCHAR>& Reader;
+	};
+
+	/**
+	 * Walk over an already parsed FJsonObject, visiting fields in the order the token parser sees them
+	 */
+	class FGraphObjectParser : public FGraphParserBase
+	{
+	public:
+		using FGraphParserBase::FGraphParserBase;
+
+		bool ParseRoot(const FJsonObject& Root)
+		{
+			bool bHasGraph = false;
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Root.Values)
+			{
+				const TSharedPtr<FJsonObject>* Object = nullptr;
+				if (!Field.Value.IsValid() || !Field.Value->TryGetObject(Object))
+				{
+					continue;
+				}
+
+				if (Field.Key == TEXT("metadata"))
+				{
+					for (const TPair<FString, TSharedPtr<FJsonValue>>& MetadataField : (*Object)->Values)
+					{
+						if (MetadataField.Value.IsValid())
+						{
+							ReadMetadataField(MetadataField.Key, *MetadataField.Value);
+						}
+					}
+				}
+				else if (Field.Key == TEXT("graph"))
+				{
+					if (!ParseGraph(**Object))
+					{
+						return false;
+					}
+					bHasGraph = true;
+				}
+			}
+			return bHasGraph || Fail(TEXT("Missing 'graph' object"));
+		}
+
+	private:
+		bool ParseGraph(const FJsonObject& Graph)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Graph.Values)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+				if (!Field.Value.IsValid() || !Field.Value->TryGetArray(Elements))
+				{
+					continue;
+				}
+
+				if (Field.Key == TEXT("nodes"))
+				{
+					for (const TSharedPtr<FJsonValue>& Element : *Elements)
+					{
+						const TSharedPtr<FJsonObject>* Node = nullptr;
+						if (Element.IsValid() && Element->TryGetObject(Node) && !ParseNode(**Node))
+						{
+							return false;
+						}
+					}
+				}
+				else if (Field.Key == TEXT("connections"))
+				{
+					for (const TSharedPtr<FJsonValue>& Element : *Elements)
+					{
+						const TArray<TSharedPtr<FJsonValue>>* Tuple = nullptr;
+						const TSharedPtr<FJsonObject>* Legacy = nullptr;
+						if (!Element.IsValid())
+						{
+							continue;
+						}
+						if (Element->TryGetArray(Tuple))
+						{
+							if (!ParseConnectionTuple(*Tuple))
+							{
+								return false;
+							}
+						}
+						else if (Element->TryGetObject(Legacy) && !ParseLegacyConnection(**Legacy))
+						{
+							return false;
+						}
+					}
+				}
+			}
+			return true;
+		}
+
+		bool ParseNode(const FJsonObject& NodeObject)
+		{
+			FBlueprintGraphNodeDescription Node;
+			Node.FirstPin = Description.Pins.Num();
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : NodeObject.Values)
+			{
+				if (!Field.Value.IsValid())
+				{
+					continue;
+				}
+
+				const FJsonValue& Value = *Field.Value;
+				if (Value.Type == EJson::Object)
+				{
+					const TSharedPtr<FJsonObject>& Object = Value.AsObject();
+					if (Field.Key == TEXT("position"))
+					{
+						for (const TPair<FString, TSharedPtr<FJsonValue>>& PositionField : Object->Values)
+						{
+							if (PositionField.Value.IsValid())
+							{
+								ReadPositionField(Node, PositionField.Key, *PositionField.Value);
+							}
+						}
+						Node.bHasPosition = true;
+					}
+					else if (Field.Key == TEXT("memberReference"))
+					{
+						for (const TPair<FString, TSharedPtr<FJsonValue>>& ReferenceField : Object->Values)
+						{
+							if (ReferenceField.Value.IsValid())
+							{
+								ReadMemberReferenceField(Node, ReferenceField.Key, *ReferenceField.Value);
+							}
+						}
+						Node.bHasMemberReference = true;
+					}
+				}
+				else if (Value.Type == EJson::Array)
+				{
+					if (Field.Key == TEXT("pins"))
+					{
+						for (const TSharedPtr<FJsonValue>& Element : Value.AsArray())
+						{
+							const TSharedPtr<FJsonObject>* PinObject = nullptr;
+							if (Element.IsValid() && Element->TryGetObject(PinObject))
+							{
+								ParsePin(**PinObject);
+							}
+						}
+					}
+				}
+				else
+				{
+					ReadNodeField(Node, Field.Key, Value);
+				}
+			}
+			return FinishNode(Node);
+		}
+
+		void ParsePin(const FJsonObject& PinObject)
+		{
+			FBlueprintGraphPinDescription Pin;
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : PinObject.Values)
+			{
+				if (Field.Value.IsValid() && Field.Value->Type != EJson::Object && Field.Value->Type != EJson::Array)
+				{
+					ReadPinField(Pin, Field.Key, *Field.Value);
+				}
+			}
+			Description.Pins.Add(Pin);
+		}
+
+		bool ParseConnectionTuple(const TArray<TSharedPtr<FJsonValue>>& Elements)
+		{
+			FBlueprintGraphConnectionDescription Connection;
+			FBlueprintGraphConnectionEndpoint* const Endpoints[] = { &Connection.From, &Connection.To };
+
+			for (int32 ElementIndex = 0; ElementIndex < Elements.Num() && ElementIndex < 4; ++ElementIndex)
+			{
+				const TSharedPtr<FJsonValue>& Element = Elements[ElementIndex];
+				FBlueprintGraphConnectionEndpoint& Endpoint = *Endpoints[ElementIndex / 2];
+				const bool bIsPin = (ElementIndex % 2) == 1;
+				if (!Element.IsValid())
+				{
+					continue;
+				}
+				if (Element->Type == EJson::Number)
+				{
+					if (!ReadTupleIndex(Element->AsNumber(), bIsPin, Endpoint))
+					{
+						return false;
+					}
+				}
+				else if (Element->Type == EJson::String)
+				{
+					ReadString(Description, *Element, bIsPin ? Endpoint.PinName : Endpoint.NodeId);
+				}
+			}
+			return FinishConnectionTuple(Connection, Elements.Num());
+		}
+
+		bool ParseLegacyConnection(const FJsonObject& ConnectionObject)
+		{
+			FBlueprintGraphConnectionDescription Connection;
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : ConnectionObject.Values)
+			{
+				const TSharedPtr<FJsonObject>* EndpointObject = nullptr;
+				if (!Field.Value.IsValid() || !Field.Value->TryGetObject(EndpointObject))
+				{
+					continue;
+				}
+
+				FBlueprintGraphConnectionEndpoint* Endpoint = Field.Key == TEXT("from") ? &Connection.From
+					: Field.Key == TEXT("to") ? &Connection.To
+					: nullptr;
+				if (Endpoint)
+				{
+					for (const TPair<FString, TSharedPtr<FJsonValue>>& EndpointField : (*EndpointObject)->Values)
+					{
+						if (EndpointField.Value.IsValid())
+						{
+							ReadLegacyEndpointField(*Endpoint, EndpointField.Key, *EndpointField.Value);
+						}
+					}
+				}
+			}
+			return FinishLegacyConnection(Connection);
+		}
+	};
+}
+
+bool FBlueprintGraphJsonReader::ReadGraph(const FString& JsonText, FBlueprintGraphDescription& OutDescription, FString& OutError)
+{
+	OutDescription.Reset();
+	OutError.Reset();
+
+	TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(JsonText);
+	FGraphTokenParser Parser(*Reader, OutDescription);
+	if (!Parser.ParseRoot() || !Parser.FinishConnections())
+	{
+		OutError = Parser.GetError();
+		OutDescription.Reset();
+		return false;
+	}
+
+	OutDescription.FinishBuilding();
+	return true;
+}
+
+bool FBlueprintGraphJsonReader::ReadGraph(const TSharedPtr<FJsonObject>& JsonData, FBlueprintGraphDescription& OutDescription, FString& OutError)
+{
+	OutDescription.Reset();
+	OutError.Reset();
+
+	if (!JsonData.IsValid())
+	{
+		OutError = TEXT("Invalid JSON object");
+		return false;
+	}
+
+	// Read straight from the tree the caller already holds; printing it for the token parser would cost a full reparse
+	FGraphObjectParser Parser(OutDescription);
+	if (!Parser.ParseRoot(*JsonData) || !Parser.FinishConnections())
+	{
+		OutError = Parser.GetError();
+		OutDescription.Reset();
+		return false;
+	}
+
+	OutDescription.FinishBuilding();
+	return true;
+}
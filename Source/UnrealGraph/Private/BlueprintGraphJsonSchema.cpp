@@ -6,7 +6,26 @@
 
 FString FBlueprintGraphJsonSchema::GetCurrentSchemaVersion()
 {
-	return "1.0";
+	return "2.0";
+}
+
+FString FBlueprintGraphJsonSchema::GetBlueprintSchemaVersion()
+{
+	return "3.0";
+}
+
+int32 FBlueprintGraphJsonSchema::GetSchemaMajorVersion(const TSharedPtr<FJsonObject>& JsonData)
+{
+	const TSharedPtr<FJsonObject>* MetadataObjectPtr;
+	FString Version;
+	if (!JsonData.IsValid() ||
+		!JsonData->TryGetObjectField("metadata", MetadataObjectPtr) ||
+		!(*MetadataObjectPtr)->TryGetStringField("version", Version))
+	{
+		return 1;
+	}
+
+	return FMath::Max(1, FCString::Atoi(*Version));
 }
 
 bool FBlueprintGraphJsonSchema::ValidateJson(const TSharedPtr<FJsonObject>& JsonData)
@@ -57,6 +76,7 @@ bool FBlueprintGraphJsonSchema::ValidateGraph(const TSharedPtr<FJsonObject>& Gra
 	}
 
 	// Validate nodes array (optional, but usually present)
+	TArray<int32> NodePinCounts;
 	const TArray<TSharedPtr<FJsonValue>>* NodesArray;
 	if (GraphObject->TryGetArrayField("nodes", NodesArray))
 	{
@@ -69,6 +89,18 @@ bool FBlueprintGraphJsonSchema::ValidateGraph(const TSharedPtr<FJsonObject>& Gra
 				{
 					return false;
 				}
+
+				// Node and pin indices count object elements only, as the readers do
+				int32 PinCount = 0;
+				const TArray<TSharedPtr<FJsonValue>>* PinsArray;
+				if ((*NodeObjectPtr)->TryGetArrayField("pins", PinsArray))
+				{
+					for (const TSharedPtr<FJsonValue>& PinValue : *PinsArray)
+					{
+						PinCount += PinValue->Type == EJson::Object ? 1 : 0;
+					}
+				}
+				NodePinCounts.Add(PinCount);
 			}
 		}
 	}
@@ -79,8 +111,16 @@ bool FBlueprintGraphJsonSchema::ValidateGraph(const TSharedPtr<FJsonObject>& Gra
 	{
 		for (const TSharedPtr<FJsonValue>& ConnectionValue : *ConnectionsArray)
 		{
+			const TArray<TSharedPtr<FJsonValue>>* TuplePtr;
 			const TSharedPtr<FJsonObject>* ConnectionObjectPtr;
-			if (ConnectionValue->TryGetObject(ConnectionObjectPtr))
+			if (ConnectionValue->Type == EJson::Array && ConnectionValue->TryGetArray(TuplePtr))
+			{
+				if (!ValidateConnectionTuple(*TuplePtr, NodePinCounts))
+				{
+					return false;
+				}
+			}
+			else if (ConnectionValue->TryGetObject(ConnectionObjectPtr))
 			{
 				if (!ValidateConnection(*ConnectionObjectPtr))
 				{
@@ -150,6 +190,53 @@ bool FBlueprintGraphJsonSchema::ValidateConnection(const TSharedPtr<FJsonObject>
 	return true;
 }
 
+bool FBlueprintGraphJsonSchema::ValidateConnectionTuple(const TArray<TSharedPtr<FJsonValue>>& Tuple, const TArray<int32>& NodePinCounts)
+{
+	if (Tuple.Num() != 4)
+	{
+		return false;
+	}
+
+	// Each endpoint is (node index, pin index), (node index, pin name) or (node id, pin name)
+	for (int32 EndpointIndex = 0; EndpointIndex < 2; ++EndpointIndex)
+	{
+		const TSharedPtr<FJsonValue>& NodeValue = Tuple[EndpointIndex * 2];
+		const TSharedPtr<FJsonValue>& PinValue = Tuple[EndpointIndex * 2 + 1];
+		if (!NodeValue.IsValid() || !PinValue.IsValid())
+		{
+			return false;
+		}
+
+		if (NodeValue->Type == EJson::Number)
+		{
+			const double NodeIndex = NodeValue->AsNumber();
+			if (NodeIndex < 0.0 || NodeIndex >= NodePinCounts.Num() || FMath::FloorToDouble(NodeIndex) != NodeIndex)
+			{
+				return false;
+			}
+
+			if (PinValue->Type == EJson::Number)
+			{
+				const double PinIndex = PinValue->AsNumber();
+				if (PinIndex < 0.0 || PinIndex >= NodePinCounts[static_cast<int32>(NodeIndex)] || FMath::FloorToDouble(PinIndex) != PinIndex)
+				{
+					return false;
+				}
+			}
+			else if (PinValue->Type != EJson::String)
+			{
+				return false;
+			}
+		}
+		else if (NodeValue->Type != EJson::String || PinValue->Type != EJson::String)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool FBlueprintGraphJsonSchema::MigrateJson(TSharedPtr<FJsonObject>& JsonData, int32 FromVersion)
 {
 	if (!JsonData.IsValid())
@@ -157,9 +244,147 @@ bool FBlueprintGraphJsonSchema::MigrateJson(TSharedPtr<FJsonObject>& JsonData, i
 		return false;
 	}
 
-	// TODO: Implement migration logic when schema versions change
-	// For now, schema version 1.0, so no migration needed
+	if (FromVersion >= 2)
+	{
+		return true;
+	}
 
+	const TSharedPtr<FJsonObject>* GraphObjectPtr;
+	if (!JsonData->TryGetObjectField("graph", GraphObjectPtr))
+	{
+		return false;
+	}
+
+	// Shallow copy: untouched sections are shared with the original payload
+	TSharedPtr<FJsonObject> Migrated = MakeShareable(new FJsonObject(*JsonData));
+	Migrated->SetObjectField(TEXT("graph"), MigrateGraphToVersion2(*GraphObjectPtr));
+
+	const TSharedPtr<FJsonObject>* MetadataObjectPtr;
+	TSharedPtr<FJsonObject> Metadata = JsonData->TryGetObjectField("metadata", MetadataObjectPtr)
+		? MakeShareable(new FJsonObject(**MetadataObjectPtr))
+		: MakeShareable(new FJsonObject);
+	Metadata->SetStringField(TEXT("version"), GetCurrentSchemaVersion());
+	Migrated->SetObjectField(TEXT("metadata"), Metadata);
+
+	JsonData = Migrated;
 	return true;
 }
 
+TSharedPtr<FJsonObject> FBlueprintGraphJsonSchema::MigrateGraphToVersion2(const TSharedPtr<FJsonObject>& GraphObject)
+{
+	TSharedPtr<FJsonObject> MigratedGraph = MakeShareable(new FJsonObject(*GraphObject));
+
+	// Copy nodes without pin connectedNodeIds, and index node ids and pin names for the connections
+	TMap<FString, int32> NodeIndexById;
+	TArray<TArray<FString>> NodePinNames;
+	TArray<TSharedPtr<FJsonValue>> MigratedNodes;
+
+	const TArray<TSharedPtr<FJsonValue>>* NodesArray;
+	if (GraphObject->TryGetArrayField("nodes", NodesArray))
+	{
+		for (const TSharedPtr<FJsonValue>& NodeValue : *NodesArray)
+		{
+			const TSharedPtr<FJsonObject>* NodeObjectPtr;
+			if (!NodeValue->TryGetObject(NodeObjectPtr))
+			{
+				MigratedNodes.Add(NodeValue);
+				continue;
+			}
+
+			TSharedPtr<FJsonObject> MigratedNode = MakeShareable(new FJsonObject(**NodeObjectPtr));
+			TArray<FString>& PinNames = NodePinNames.AddDefaulted_GetRef();
+
+			const TArray<TSharedPtr<FJsonValue>>* PinsArray;
+			if ((*NodeObjectPtr)->TryGetArrayField("pins", PinsArray))
+			{
+				TArray<TSharedPtr<FJsonValue>> MigratedPins;
+				for (const TSharedPtr<FJsonValue>& PinValue : *PinsArray)
+				{
+					const TSharedPtr<FJsonObject>* PinObjectPtr;
+					if (!PinValue->TryGetObject(PinObjectPtr))
+					{
+						MigratedPins.Add(PinValue);
+						continue;
+					}
+
+					TSharedPtr<FJsonObject> MigratedPin = MakeShareable(new FJsonObject(**PinObjectPtr));
+					MigratedPin->RemoveField(TEXT("connectedNodeIds"));
+					MigratedPins.Add(MakeShareable(new FJsonValueObject(MigratedPin)));
+
+					FString PinName;
+					(*PinObjectPtr)->TryGetStringField("name", PinName);
+					PinNames.Add(PinName);
+				}
+				MigratedNode->SetArrayField(TEXT("pins"), MigratedPins);
+			}
+
+			FString NodeId;
+			if ((*NodeObjectPtr)->TryGetStringField("id", NodeId) && !NodeIndexById.Contains(NodeId))
+			{
+				NodeIndexById.Add(NodeId, NodePinNames.Num() - 1);
+			}
+
+			MigratedNodes.Add(MakeShareable(new FJsonValueObject(MigratedNode)));
+		}
+		MigratedGraph->SetArrayField(TEXT("nodes"), MigratedNodes);
+	}
+
+	auto AppendEndpoint = [&NodeIndexById, &NodePinNames](const TSharedPtr<FJsonObject>& EndpointObject, TArray<TSharedPtr<FJsonValue>>& OutTuple)
+	{
+		FString NodeId, PinName;
+		EndpointObject->TryGetStringField("nodeId", NodeId);
+		EndpointObject->TryGetStringField("pinName", PinName);
+
+		const int32* NodeIndex = NodeIndexById.Find(NodeId);
+		if (!NodeIndex)
+		{
+			// Node outside the document (e.g., already in the target graph): keep the id and name
+			OutTuple.Add(MakeShareable(new FJsonValueString(NodeId)));
+			OutTuple.Add(MakeShareable(new FJsonValueString(PinName)));
+			return;
+		}
+
+		OutTuple.Add(MakeShareable(new FJsonValueNumber(*NodeIndex)));
+		const int32 PinIndex = NodePinNames[*NodeIndex].IndexOfByPredicate([&PinName](const FString& Name)
+		{
+			return Name.Equals(PinName, ESearchCase::CaseSensitive);
+		});
+		if (PinIndex != INDEX_NONE)
+		{
+			OutTuple.Add(MakeShareable(new FJsonValueNumber(PinIndex)));
+		}
+		else
+		{
+			OutTuple.Add(MakeShareable(new FJsonValueString(PinName)));
+		}
+	};
+
+	const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray;
+	if (GraphObject->TryGetArrayField("connections", ConnectionsArray))
+	{
+		TArray<TSharedPtr<FJsonValue>> MigratedConnections;
+		for (const TSharedPtr<FJsonValue>& ConnectionValue : *ConnectionsArray)
+		{
+			const TSharedPtr<FJsonObject>* ConnectionObjectPtr;
+			const TSharedPtr<FJsonObject>* FromObjectPtr;
+			const TSharedPtr<FJsonObject>* ToObjectPtr;
+			if (ConnectionValue->Type != EJson::Object ||
+				!ConnectionValue->TryGetObject(ConnectionObjectPtr) ||
+				!(*ConnectionObjectPtr)->TryGetObjectField("from", FromObjectPtr) ||
+				!(*ConnectionObjectPtr)->TryGetObjectField("to", ToObjectPtr))
+			{
+				// Already a tuple (or not a connection at all): keep as is
+				MigratedConnections.Add(ConnectionValue);
+				continue;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> Tuple;
+			AppendEndpoint(*FromObjectPtr, Tuple);
+			AppendEndpoint(*ToObjectPtr, Tuple);
+			MigratedConnections.Add(MakeShareable(new FJsonValueArray(Tuple)));
+		}
+		MigratedGraph->SetArrayField(TEXT("connections"), MigratedConnections);
+	}
+
+	return MigratedGraph;
+}
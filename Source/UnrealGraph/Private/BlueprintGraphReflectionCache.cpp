@@ -0,0 +1,601 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintGraphReflectionCache.h"
+#include "UnrealGraphLogger.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/MemberReference.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Engine/Blueprint.h"
+#include "Misc/CoreDelegates.h"
+#include "Modules/ModuleManager.h"
+#include "Editor.h"
+
+TMap<const UClass*, FNodePositionAccessor> FBlueprintGraphReflectionCache::PositionAccessors;
+FDelegateHandle FBlueprintGraphReflectionCache::ReloadCompleteHandle;
+FDelegateHandle FBlueprintGraphReflectionCache::BlueprintCompiledHandle;
+FDelegateHandle FBlueprintGraphReflectionCache::BlueprintPreCompileHandle;
+FDelegateHandle FBlueprintGraphReflectionCache::AssetLoadedHandle;
+FDelegateHandle FBlueprintGraphReflectionCache::PostEngineInitHandle;
+FDelegateHandle FBlueprintGraphReflectionCache::ModulesChangedHandle;
+TMap<TPair<const UClass*, FName>, FBlueprintGraphReflectionCache::FClassPropertyEntry> FBlueprintGraphReflectionCache::ClassProperties;
+TMap<FName, TWeakObjectPtr<UClass>> FBlueprintGraphReflectionCache::NodeClassIndex;
+bool FBlueprintGraphReflectionCache::bNodeClassIndexBuilt = false;
+TMap<FName, TArray<TWeakObjectPtr<UFunction>>> FBlueprintGraphReflectionCache::FunctionIndex;
+TSet<FName> FBlueprintGraphReflectionCache::MissedFunctionNames;
+bool FBlueprintGraphReflectionCache::bFunctionIndexBuilt = false;
+TMap<TWeakObjectPtr<UClass>, TArray<FName>> FBlueprintGraphReflectionCache::BlueprintClassFunctionNames;
+TArray<TWeakObjectPtr<UObject>> FBlueprintGraphReflectionCache::PendingFunctionOwners;
+
+namespace
+{
+	bool IsVector2DProperty(const FProperty* Property)
+	{
+		const FStructProperty* StructProp = CastField<FStructProperty>(Property);
+		return StructProp && StructProp->Struct && StructProp->Struct->GetFName() == NAME_Vector2D;
+	}
+
+	/** Stale and intermediate Blueprint classes only hold duplicates of the real class's functions */
+	bool IsIndexableClass(const UClass* Class)
+	{
+		if (!Class || Class->HasAnyClassFlags(CLASS_NewerVersionExists | CLASS_Deprecated))
+		{
+			return false;
+		}
+		const FString ClassName = Class->GetName();
+		return !ClassName.StartsWith(TEXT("SKEL_")) && !ClassName.StartsWith(TEXT("REINST_")) && !ClassName.StartsWith(TEXT("TRASHCLASS_"));
+	}
+}
+
+bool FNodePositionAccessor::Read(const UEdGraphNode* Node, FVector2D& OutPosition) const
+{
+	switch (Kind)
+	{
+	case ENodePositionAccessorKind::EdGraphNodeMembers:
+		OutPosition = FVector2D(static_cast<float>(Node->NodePosX), static_cast<float>(Node->NodePosY));
+		return true;
+
+	case ENodePositionAccessorKind::Vector2DProperty:
+		OutPosition = *PropertyX->ContainerPtrToValuePtr<FVector2D>(Node);
+		return true;
+
+	case ENodePositionAccessorKind::IntXYProperties:
+		OutPosition = FVector2D(
+			static_cast<float>(static_cast<const FIntProperty*>(PropertyX)->GetPropertyValue_InContainer(Node)),
+			static_cast<float>(static_cast<const FIntProperty*>(PropertyY)->GetPropertyValue_InContainer(Node)));
+		return true;
+
+	case ENodePositionAccessorKind::FloatXYProperties:
+		OutPosition = FVector2D(
+			static_cast<const FFloatProperty*>(PropertyX)->GetPropertyValue_InContainer(Node),
+			static_cast<const FFloatProperty*>(PropertyY)->GetPropertyValue_InContainer(Node));
+		return true;
+
+	case ENodePositionAccessorKind::Vector2DScan:
+	{
+		// Same rule as the original property iteration: a (0,0) value does not count as found
+		const FVector2D& Value = *PropertyX->ContainerPtrToValuePtr<FVector2D>(Node);
+		if (Value.X != 0.0f || Value.Y != 0.0f)
+		{
+			OutPosition = Value;
+			return true;
+		}
+		return false;
+	}
+
+	default:
+		return false;
+	}
+}
+
+void FBlueprintGraphReflectionCache::Startup()
+{
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+
+	// Plugin modules bring their own node classes (AnimGraph, KismetNodes, ...)
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason)
+	{
+		InvalidateClassIndices();
+	});
+
+	// Blueprints loaded after the function index was built add their generated class to it
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddLambda([](UObject* Asset)
+	{
+		if (Asset && (Asset->IsA<UBlueprint>() || Asset->IsA<UClass>()))
+		{
+			QueueFunctionOwner(Asset);
+		}
+	});
+
+	// GEditor does not exist yet when Default-phase modules start up
+	if (GEditor)
+	{
+		RegisterEditorHooks();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&FBlueprintGraphReflectionCache::RegisterEditorHooks);
+	}
+}
+
+void FBlueprintGraphReflectionCache::Shutdown()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	ReloadCompleteHandle.Reset();
+	PostEngineInitHandle.Reset();
+	ModulesChangedHandle.Reset();
+	AssetLoadedHandle.Reset();
+	BlueprintCompiledHandle.Reset();
+	BlueprintPreCompileHandle.Reset();
+
+	Invalidate();
+}
+
+void FBlueprintGraphReflectionCache::RegisterEditorHooks()
+{
+	if (GEditor && !BlueprintCompiledHandle.IsValid())
+	{
+		// A compile changes one Blueprint's members: re-index its class instead of rescanning every class.
+		// The Blueprint is queued rather than its class, which a first compile has not created yet.
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddLambda([](UBlueprint* Blueprint)
+		{
+			QueueFunctionOwner(Blueprint);
+		});
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddStatic(&FBlueprintGraphReflectionCache::InvalidateMemberCaches);
+	}
+}
+
+void FBlueprintGraphReflectionCache::Invalidate()
+{
+	InvalidateMemberCaches();
+	InvalidateClassIndices();
+}
+
+void FBlueprintGraphReflectionCache::InvalidateMemberCaches()
+{
+	PositionAccessors.Empty();
+	ClassProperties.Empty();
+}
+
+void FBlueprintGraphReflectionCache::InvalidateClassIndices()
+{
+	NodeClassIndex.Empty();
+	bNodeClassIndexBuilt = false;
+
+	FunctionIndex.Empty();
+	MissedFunctionNames.Empty();
+	BlueprintClassFunctionNames.Empty();
+	PendingFunctionOwners.Empty();
+	bFunctionIndexBuilt = false;
+}
+
+void FBlueprintGraphReflectionCache::QueueFunctionOwner(UObject* ClassOrBlueprint)
+{
+	// Classes loaded before the first lookup are picked up by the full build
+	if (bFunctionIndexBuilt && ClassOrBlueprint)
+	{
+		PendingFunctionOwners.AddUnique(ClassOrBlueprint);
+	}
+}
+
+void FBlueprintGraphReflectionCache::UpdateFunctionIndex()
+{
+	if (!bFunctionIndexBuilt)
+	{
+		BuildFunctionIndex();
+		return;
+	}
+
+	if (PendingFunctionOwners.Num() == 0)
+	{
+		return;
+	}
+
+	TSet<FName> ChangedNames;
+	for (const TWeakObjectPtr<UObject>& PendingOwner : PendingFunctionOwners)
+	{
+		UObject* Owner = PendingOwner.Get();
+		const UBlueprint* Blueprint = Cast<UBlueprint>(Owner);
+		UClass* Class = Blueprint ? Blueprint->GeneratedClass.Get() : Cast<UClass>(Owner);
+		if (!Class)
+		{
+			continue;
+		}
+
+		// Drop what an earlier version of the class contributed; recompiled functions move to a trash class
+		if (const TArray<FName>* PreviousNames = BlueprintClassFunctionNames.Find(Class))
+		{
+			for (const FName& Name : *PreviousNames)
+			{
+				if (TArray<TWeakObjectPtr<UFunction>>* Candidates = FunctionIndex.Find(Name))
+				{
+					Candidates->RemoveAll([Class](const TWeakObjectPtr<UFunction>& Candidate)
+					{
+						const UFunction* Function = Candidate.Get();
+						return !Function || Function->GetOuterUClass() == Class || !IsIndexableClass(Function->GetOuterUClass());
+					});
+					if (Candidates->Num() == 0)
+					{
+						FunctionIndex.Remove(Name);
+					}
+				}
+				ChangedNames.Add(Name);
+			}
+		}
+
+		IndexClassFunctions(Class, ChangedNames);
+	}
+	PendingFunctionOwners.Reset();
+
+	for (const FName& Name : ChangedNames)
+	{
+		// A name the new classes declare is no longer a known miss
+		MissedFunctionNames.Remove(Name);
+		if (TArray<TWeakObjectPtr<UFunction>>* Candidates = FunctionIndex.Find(Name))
+		{
+			SortFunctionCandidates(*Candidates);
+		}
+	}
+
+	UNREALGRAPH_LOG(Verbose, TEXT("Updated function index: %d names changed"), ChangedNames.Num());
+}
+
+UClass* FBlueprintGraphReflectionCache::FindNodeClass(FName ClassName)
+{
+	if (ClassName.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (!bNodeClassIndexBuilt)
+	{
+		BuildNodeClassIndex();
+	}
+
+	const TWeakObjectPtr<UClass>* Found = NodeClassIndex.Find(ClassName);
+	return Found ? Found->Get() : nullptr;
+}
+
+void FBlueprintGraphReflectionCache::BuildNodeClassIndex()
+{
+	NodeClassIndex.Reset();
+
+	// Walks the derived-class hash rather than every object in memory
+	TArray<UClass*> NodeClasses;
+	GetDerivedClasses(UEdGraphNode::StaticClass(), NodeClasses, /*bRecursive*/ true);
+	NodeClasses.Add(UEdGraphNode::StaticClass());
+
+	for (UClass* NodeClass : NodeClasses)
+	{
+		if (!NodeClass || NodeClass->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			continue;
+		}
+
+		// Keep the first class registered under a name; duplicates are reported for diagnosis
+		const FName ClassName = NodeClass->GetFName();
+		if (const TWeakObjectPtr<UClass>* Existing = NodeClassIndex.Find(ClassName))
+		{
+			UNREALGRAPH_LOG(Trace, TEXT("  Duplicate node class name %s: keeping %s, ignoring %s"),
+				*ClassName.ToString(), Existing->IsValid() ? *(*Existing)->GetPathName() : TEXT("None"), *NodeClass->GetPathName());
+			continue;
+		}
+		NodeClassIndex.Add(ClassName, NodeClass);
+	}
+
+	bNodeClassIndexBuilt = true;
+	UNREALGRAPH_LOG(Verbose, TEXT("Built node class index with %d classes"), NodeClassIndex.Num());
+}
+
+const FNodePositionAccessor& FBlueprintGraphReflectionCache::GetPositionAccessor(const UClass* NodeClass)
+{
+	if (const FNodePositionAccessor* Existing = PositionAccessors.Find(NodeClass))
+	{
+		return *Existing;
+	}
+
+	return PositionAccessors.Add(NodeClass, ResolvePositionAccessor(NodeClass));
+}
+
+UFunction* FBlueprintGraphReflectionCache::FindFunction(FName FunctionName)
+{
+	if (FunctionName.IsNone())
+	{
+		return nullptr;
+	}
+
+	UpdateFunctionIndex();
+	if (MissedFunctionNames.Contains(FunctionName))
+	{
+		return nullptr;
+	}
+
+	if (const TArray<TWeakObjectPtr<UFunction>>* Candidates = FunctionIndex.Find(FunctionName))
+	{
+		for (const TWeakObjectPtr<UFunction>& Candidate : *Candidates)
+		{
+			if (UFunction* Function = Candidate.Get())
+			{
+				if (Candidates->Num() > 1)
+				{
+					UNREALGRAPH_LOG(Verbose, TEXT("  Function name %s is ambiguous (%d candidates), using %s"),
+						*FunctionName.ToString(), Candidates->Num(), *Function->GetPathName());
+				}
+				return Function;
+			}
+		}
+	}
+
+	MissedFunctionNames.Add(FunctionName);
+	return nullptr;
+}
+
+void FBlueprintGraphReflectionCache::GetFunctionCandidates(FName FunctionName, TArray<UFunction*>& OutCandidates)
+{
+	OutCandidates.Reset();
+	if (FunctionName.IsNone())
+	{
+		return;
+	}
+
+	UpdateFunctionIndex();
+	if (MissedFunctionNames.Contains(FunctionName))
+	{
+		return;
+	}
+
+	if (const TArray<TWeakObjectPtr<UFunction>>* Candidates = FunctionIndex.Find(FunctionName))
+	{
+		for (const TWeakObjectPtr<UFunction>& Candidate : *Candidates)
+		{
+			if (UFunction* Function = Candidate.Get())
+			{
+				OutCandidates.Add(Function);
+			}
+		}
+	}
+
+	if (OutCandidates.Num() == 0)
+	{
+		MissedFunctionNames.Add(FunctionName);
+	}
+}
+
+FProperty* FBlueprintGraphReflectionCache::FindClassProperty(const UClass* Class, FName PropertyName)
+{
+	if (!Class || PropertyName.IsNone())
+	{
+		return nullptr;
+	}
+
+	const TPair<const UClass*, FName> Key(Class, PropertyName);
+	if (const FClassPropertyEntry* Existing = ClassProperties.Find(Key))
+	{
+		if (Existing->Class.Get() == Class)
+		{
+			return Existing->Property;
+		}
+	}
+
+	// FindPropertyByName walks the whole property chain, super classes included
+	FClassPropertyEntry& Entry = ClassProperties.Add(Key);
+	Entry.Class = Class;
+	Entry.Property = Class->FindPropertyByName(PropertyName);
+	return Entry.Property;
+}
+
+FMemberReference* FBlueprintGraphReflectionCache::FindMemberReference(UEdGraphNode* Node, FName ReferencePropertyName)
+{
+	if (!Node)
+	{
+		return nullptr;
+	}
+
+	FStructProperty* ReferenceProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(ReferencePropertyName));
+	if (!ReferenceProp || ReferenceProp->Struct != FMemberReference::StaticStruct())
+	{
+		return nullptr;
+	}
+
+	return ReferenceProp->ContainerPtrToValuePtr<FMemberReference>(Node);
+}
+
+int32 FBlueprintGraphReflectionCache::GetFunctionRank(const UFunction* Function)
+{
+	const UClass* OwnerClass = Function->GetOuterUClass();
+	if (OwnerClass == UKismetSystemLibrary::StaticClass())
+	{
+		return 0;
+	}
+	if (OwnerClass && OwnerClass->IsChildOf(UBlueprintFunctionLibrary::StaticClass()))
+	{
+		return 1;
+	}
+	if (Function->HasAnyFunctionFlags(FUNC_Static))
+	{
+		return 2;
+	}
+	if (Function->HasAnyFunctionFlags(FUNC_BlueprintCallable | FUNC_BlueprintPure))
+	{
+		return 3;
+	}
+	if (OwnerClass && OwnerClass->HasAnyClassFlags(CLASS_Native))
+	{
+		return 4;
+	}
+	return 5;
+}
+
+void FBlueprintGraphReflectionCache::BuildFunctionIndex()
+{
+	FunctionIndex.Reset();
+	MissedFunctionNames.Reset();
+	BlueprintClassFunctionNames.Reset();
+	PendingFunctionOwners.Reset();
+
+	TSet<FName> IndexedNames;
+	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		IndexClassFunctions(*ClassIt, IndexedNames);
+	}
+
+	for (TPair<FName, TArray<TWeakObjectPtr<UFunction>>>& Pair : FunctionIndex)
+	{
+		SortFunctionCandidates(Pair.Value);
+	}
+
+	bFunctionIndexBuilt = true;
+	UNREALGRAPH_LOG(Verbose, TEXT("Built function index with %d names"), FunctionIndex.Num());
+}
+
+void FBlueprintGraphReflectionCache::IndexClassFunctions(UClass* Class, TSet<FName>& OutIndexedNames)
+{
+	if (!IsIndexableClass(Class))
+	{
+		return;
+	}
+
+	// Blueprint classes are re-indexed on load and compile, so remember what they contributed
+	TArray<FName>* ClassNames = Class->HasAnyClassFlags(CLASS_Native) ? nullptr : &BlueprintClassFunctionNames.FindOrAdd(Class);
+	if (ClassNames)
+	{
+		ClassNames->Reset();
+	}
+
+	for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+	{
+		const FName Name = FuncIt->GetFName();
+		FunctionIndex.FindOrAdd(Name).AddUnique(*FuncIt);
+		OutIndexedNames.Add(Name);
+		if (ClassNames)
+		{
+			ClassNames->Add(Name);
+		}
+	}
+}
+
+void FBlueprintGraphReflectionCache::SortFunctionCandidates(TArray<TWeakObjectPtr<UFunction>>& Candidates)
+{
+	// Functions of unloaded classes cannot be ranked
+	Candidates.RemoveAll([](const TWeakObjectPtr<UFunction>& Candidate) { return !Candidate.IsValid(); });
+
+	// Rank candidates sharing a name; ties are broken by path for a deterministic choice
+	if (Candidates.Num() > 1)
+	{
+		Candidates.Sort([](const TWeakObjectPtr<UFunction>& A, const TWeakObjectPtr<UFunction>& B)
+		{
+			const int32 RankA = GetFunctionRank(A.Get());
+			const int32 RankB = GetFunctionRank(B.Get());
+			return RankA != RankB ? RankA < RankB : A->GetPathName() < B->GetPathName();
+		});
+	}
+}
+
+FNodePositionAccessor FBlueprintGraphReflectionCache::ResolvePositionAccessor(const UClass* NodeClass)
+{
+	FNodePositionAccessor Accessor;
+	if (!NodeClass)
+	{
+		return Accessor;
+	}
+
+	UNREALGRAPH_LOG_SECTION(Trace, FString::Printf(TEXT("Resolving Position Accessor for Class: %s"), *NodeClass->GetName()));
+
+	// Method 1: Vector2D property under one of the known names (FindPropertyByName already walks base classes)
+	const FName PositionPropertyNames[] = {
+		TEXT("NodePos"),
+		TEXT("NodePosition"),
+		TEXT("Position"),
+		TEXT("Pos")
+	};
+
+	for (const FName& PropName : PositionPropertyNames)
+	{
+		FProperty* PosProp = NodeClass->FindPropertyByName(PropName);
+		if (IsVector2DProperty(PosProp))
+		{
+			Accessor.Kind = ENodePositionAccessorKind::Vector2DProperty;
+			Accessor.PropertyX = PosProp;
+			UNREALGRAPH_LOG(Trace, TEXT("  ✓ Using Vector2D property %s"), *PropName.ToString());
+			return Accessor;
+		}
+	}
+
+	// Fast path: every graph node stores its position in UEdGraphNode::NodePosX/NodePosY
+	if (NodeClass->IsChildOf(UEdGraphNode::StaticClass()))
+	{
+		Accessor.Kind = ENodePositionAccessorKind::EdGraphNodeMembers;
+		UNREALGRAPH_LOG(Trace, TEXT("  ✓ Using UEdGraphNode::NodePosX/NodePosY"));
+		return Accessor;
+	}
+
+	// Method 2: Separate X and Y properties - IntProperty first (this is what Unreal actually uses), then FloatProperty
+	const TCHAR* XNames[] = { TEXT("NodePosX"), TEXT("PosX"), TEXT("PositionX") };
+	const TCHAR* YNames[] = { TEXT("NodePosY"), TEXT("PosY"), TEXT("PositionY") };
+
+	const FIntProperty* IntX = nullptr;
+	const FIntProperty* IntY = nullptr;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(XNames) && !(IntX && IntY); ++Index)
+	{
+		IntX = IntX ? IntX : FindFProperty<FIntProperty>(NodeClass, XNames[Index]);
+		IntY = IntY ? IntY : FindFProperty<FIntProperty>(NodeClass, YNames[Index]);
+	}
+	if (IntX && IntY)
+	{
+		Accessor.Kind = ENodePositionAccessorKind::IntXYProperties;
+		Accessor.PropertyX = IntX;
+		Accessor.PropertyY = IntY;
+		UNREALGRAPH_LOG(Trace, TEXT("  ✓ Using IntProperty pair %s/%s"), *IntX->GetName(), *IntY->GetName());
+		return Accessor;
+	}
+
+	const FFloatProperty* FloatX = nullptr;
+	const FFloatProperty* FloatY = nullptr;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(XNames) && !(FloatX && FloatY); ++Index)
+	{
+		FloatX = FloatX ? FloatX : FindFProperty<FFloatProperty>(NodeClass, XNames[Index]);
+		FloatY = FloatY ? FloatY : FindFProperty<FFloatProperty>(NodeClass, YNames[Index]);
+	}
+	if (FloatX && FloatY)
+	{
+		Accessor.Kind = ENodePositionAccessorKind::FloatXYProperties;
+		Accessor.PropertyX = FloatX;
+		Accessor.PropertyY = FloatY;
+		UNREALGRAPH_LOG(Trace, TEXT("  ✓ Using FloatProperty pair %s/%s"), *FloatX->GetName(), *FloatY->GetName());
+		return Accessor;
+	}
+
+	// Method 3: Any Vector2D property whose name looks like a position
+	for (TFieldIterator<FProperty> PropIt(NodeClass); PropIt; ++PropIt)
+	{
+		FProperty* Prop = *PropIt;
+		const FString PropNameStr = Prop->GetName();
+		if (IsVector2DProperty(Prop) && (PropNameStr.Contains(TEXT("Pos")) || PropNameStr.Contains(TEXT("Position"))))
+		{
+			Accessor.Kind = ENodePositionAccessorKind::Vector2DScan;
+			Accessor.PropertyX = Prop;
+			UNREALGRAPH_LOG(Trace, TEXT("  ✓ Using Vector2D property found by iteration: %s"), *PropNameStr);
+			return Accessor;
+		}
+	}
+
+	UNREALGRAPH_LOG(Trace, TEXT("  ✗ No position property found"));
+	return Accessor;
+}
@@ -2,9 +2,17 @@
 
 #include "BlueprintGraphSerializer.h"
 #include "UnrealGraphLogger.h"
+#include "BlueprintGraphReflectionCache.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphContentHash.h"
+#include "BlueprintGraphBinaryFormat.h"
+#include "BlueprintGraphJsonSchema.h"
+#include "Engine/MemberReference.h"
+#include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Internationalization/Text.h"
@@ -14,6 +22,280 @@
 #include "UObject/PropertyAccessUtil.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+
+namespace UnrealGraphSerializer
+{
+	static int32 UseStreamingWriter = 1;
+	static FAutoConsoleVariableRef CVarUseStreamingWriter(
+		TEXT("UnrealGraph.Serialize.Streaming"),
+		UseStreamingWriter,
+		TEXT("Editor commands serialize graphs with the streaming JSON writer (1) or build a FJsonObject DOM first (0). Both produce identical output."),
+		ECVF_Default
+	);
+
+	static int32 ParallelEncodeMinNodes = 1000;
+	static FAutoConsoleVariableRef CVarParallelEncodeMinNodes(
+		TEXT("UnrealGraph.Serialize.ParallelMinNodes"),
+		ParallelEncodeMinNodes,
+		TEXT("Node count from which graphs are snapshotted on the game thread and encoded to JSON or binary on worker threads (0 disables)."),
+		ECVF_Default
+	);
+
+	/** Nodes encoded per parallel task; large enough to amortize task and writer setup */
+	static constexpr int32 ParallelEncodeChunkSize = 64;
+}
+
+namespace
+{
+	/**
+	 * Member fields of function, variable and event nodes.
+	 * Gathered once so the DOM and streaming writers emit the same fields in the same order.
+	 */
+	struct FNodeMemberFields
+	{
+		FString FunctionName;
+		FString VariableName;
+		FString EventName;
+		FString EventClass;
+		FString EventClassPath;
+		const FMemberReference* MemberReference = nullptr;
+		bool bIsCustomEvent = false;
+	};
+
+	FNodeMemberFields GatherNodeMemberFields(UEdGraphNode* Node)
+	{
+		FNodeMemberFields Fields;
+		const FName NodeTypeName = Node->GetClass()->GetFName();
+
+		// K2Node_CallFunction
+		if (NodeTypeName == TEXT("K2Node_CallFunction"))
+		{
+			Fields.MemberReference = FBlueprintGraphReflectionCache::FindMemberReference(Node, TEXT("FunctionReference"));
+			if (Fields.MemberReference && !Fields.MemberReference->GetMemberName().IsNone())
+			{
+				Fields.FunctionName = Fields.MemberReference->GetMemberName().ToString();
+			}
+		}
+		// K2Node_VariableGet and K2Node_VariableSet
+		else if (NodeTypeName == TEXT("K2Node_VariableGet") || NodeTypeName == TEXT("K2Node_VariableSet"))
+		{
+			Fields.MemberReference = FBlueprintGraphReflectionCache::FindMemberReference(Node, TEXT("VariableReference"));
+			if (Fields.MemberReference && !Fields.MemberReference->GetMemberName().IsNone())
+			{
+				Fields.VariableName = Fields.MemberReference->GetMemberName().ToString();
+			}
+		}
+		// K2Node_Event: EventReference first (standard events like BeginPlay), then CustomFunctionName
+		else if (NodeTypeName == TEXT("K2Node_Event"))
+		{
+			Fields.MemberReference = FBlueprintGraphReflectionCache::FindMemberReference(Node, TEXT("EventReference"));
+			if (Fields.MemberReference && !Fields.MemberReference->GetMemberName().IsNone())
+			{
+				Fields.EventName = Fields.MemberReference->GetMemberName().ToString();
+
+				// The class containing the event - important for standard events
+				if (UClass* ParentClass = Fields.MemberReference->GetMemberParentClass())
+				{
+					Fields.EventClass = ParentClass->GetName();
+					Fields.EventClassPath = ParentClass->GetPathName();
+				}
+			}
+			else if (FNameProperty* EventNameProp = CastField<FNameProperty>(Node->GetClass()->FindPropertyByName(TEXT("CustomFunctionName"))))
+			{
+				const FName EventName = EventNameProp->GetPropertyValue_InContainer(Node);
+				if (!EventName.IsNone())
+				{
+					Fields.EventName = EventName.ToString();
+					Fields.bIsCustomEvent = true;
+				}
+			}
+		}
+
+		// Unset references are not written
+		if (Fields.MemberReference && Fields.MemberReference->GetMemberName().IsNone())
+		{
+			Fields.MemberReference = nullptr;
+		}
+
+		return Fields;
+	}
+
+	/**
+	 * Read a node position through the accessor resolved once per node class, logging failures
+	 */
+	FVector2D ReadNodePosition(UEdGraphNode* Node)
+	{
+		FVector2D NodePosition(0.0f, 0.0f);
+		const bool bPositionFound = FBlueprintGraphReflectionCache::GetPositionAccessor(Node->GetClass()).Read(Node, NodePosition);
+
+		if (!bPositionFound)
+		{
+			UNREALGRAPH_LOG(Error, TEXT("✗ FAILED: Node position not found for %s, serializing as (0,0)"), *Node->GetName());
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Node position not found for %s, serializing as (0,0)"), *Node->GetName());
+		}
+		else
+		{
+			UNREALGRAPH_LOG(Verbose, TEXT("Position for node %s: (%.1f, %.1f)"), *Node->GetName(), NodePosition.X, NodePosition.Y);
+		}
+
+		return NodePosition;
+	}
+
+	/**
+	 * Dense node indices as written to "nodes" (null entries are skipped) and the index of every pin among
+	 * the non-null pins of its node, as written to "pins"; connections refer to endpoints by these.
+	 * Built once per write, so each endpoint is a lookup rather than a scan of its node's pins.
+	 */
+	struct FEndpointIndices
+	{
+		TMap<const UEdGraphNode*, int32> Nodes;
+		TMap<const UEdGraphPin*, int32> Pins;
+
+		template <typename NodeArrayType>
+		explicit FEndpointIndices(const NodeArrayType& InNodes)
+		{
+			Nodes.Reserve(InNodes.Num());
+			for (const UEdGraphNode* Node : InNodes)
+			{
+				if (!Node)
+				{
+					continue;
+				}
+
+				Nodes.Add(Node, Nodes.Num());
+				int32 PinIndex = 0;
+				for (const UEdGraphPin* Pin : Node->Pins)
+				{
+					if (Pin)
+					{
+						Pins.Add(Pin, PinIndex++);
+					}
+				}
+			}
+		}
+
+		/**
+		 * Index form of an endpoint
+		 * @return False if the pin's node is not among the indexed nodes (the endpoint is written by id and pin name)
+		 */
+		bool Find(const UEdGraphPin* Pin, int32& OutNodeIndex, int32& OutPinIndex) const
+		{
+			const int32* NodeIndex = Nodes.Find(Pin->GetOwningNode());
+			if (!NodeIndex)
+			{
+				return false;
+			}
+			OutNodeIndex = *NodeIndex;
+			const int32* PinIndex = Pins.Find(Pin);
+			OutPinIndex = PinIndex ? *PinIndex : INDEX_NONE;
+			return true;
+		}
+	};
+
+	/**
+	 * Text TJsonWriter emits before an element of an array whose elements are at IndentLevel.
+	 * Used to join elements encoded by separate writers (started at IndentLevel) into one array.
+	 */
+	FString GetJsonArrayElementPrefix(bool bFirstElement, int32 IndentLevel, bool bPrettyPrint)
+	{
+		FString Prefix = bFirstElement ? FString() : FString(TEXT(","));
+		if (bPrettyPrint)
+		{
+			Prefix += LINE_TERMINATOR;
+			Prefix += FString::ChrN(IndentLevel, TEXT('\t'));
+		}
+		return Prefix;
+	}
+
+	/**
+	 * Join array chunks (each holding prefixed elements, see GetJsonArrayElementPrefix) into a JSON array value
+	 */
+	FString JoinJsonArrayChunks(TArray<FString>& Chunks, int32 IndentLevel, bool bPrettyPrint)
+	{
+		int32 Length = 2;
+		bool bEmpty = true;
+		for (const FString& Chunk : Chunks)
+		{
+			Length += Chunk.Len();
+			bEmpty &= Chunk.IsEmpty();
+		}
+
+		FString ArrayJson;
+		ArrayJson.Reserve(Length + IndentLevel + 2);
+		ArrayJson += TEXT("[");
+		for (FString& Chunk : Chunks)
+		{
+			ArrayJson += Chunk;
+			Chunk.Empty();
+		}
+		if (!bEmpty && bPrettyPrint)
+		{
+			ArrayJson += LINE_TERMINATOR;
+			ArrayJson += FString::ChrN(IndentLevel - 1, TEXT('\t'));
+		}
+		ArrayJson += TEXT("]");
+		return ArrayJson;
+	}
+
+	/**
+	 * Number the strings a Blueprint document refers to from its graphs, nodes and pins, in order of first use.
+	 * Metadata strings stay inline (so the export date can be restamped in place) and are left out.
+	 * @param OutReferences Document string index of each description string, INDEX_NONE when unused
+	 * @param OutStrings Description string index of each document string
+	 */
+	void BuildStringReferences(const FBlueprintDescription& Description, TArray<int32>& OutReferences, TArray<int32>& OutStrings)
+	{
+		const FBlueprintGraphDescription& Content = Description.Content;
+		OutReferences.Init(INDEX_NONE, Content.Strings.Num());
+		OutStrings.Reset();
+
+		auto Reference = [&OutReferences, &OutStrings](int32 StringIndex)
+		{
+			if (OutReferences.IsValidIndex(StringIndex) && OutReferences[StringIndex] == INDEX_NONE)
+			{
+				OutReferences[StringIndex] = OutStrings.Add(StringIndex);
+			}
+		};
+
+		for (const FBlueprintGraphSectionDescription& Section : Description.Graphs)
+		{
+			Reference(Section.Name);
+			Reference(Section.Kind);
+
+			for (int32 NodeIndex = Section.FirstNode; NodeIndex < Section.FirstNode + Section.NumNodes; ++NodeIndex)
+			{
+				// Same fields and order as WriteDescriptionNode
+				const FBlueprintGraphNodeDescription& Node = Content.Nodes[NodeIndex];
+				for (int32 StringIndex : { Node.Id, Node.Type, Node.ClassPath, Node.Title,
+					Node.FunctionName, Node.VariableName, Node.EventName, Node.EventClass, Node.EventClassPath })
+				{
+					Reference(StringIndex);
+				}
+
+				if (Node.bHasMemberReference)
+				{
+					Reference(Node.MemberName);
+					Reference(Node.MemberParent);
+					Reference(Node.MemberGuid);
+				}
+
+				for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+				{
+					const FBlueprintGraphPinDescription& Pin = Content.Pins[PinIndex];
+					Reference(Pin.Name);
+					Reference(Pin.Category);
+					Reference(Pin.SubCategory);
+					Reference(Pin.DefaultValue);
+				}
+			}
+		}
+	}
+}
 
 TSharedPtr<FJsonObject> FBlueprintGraphSerializer::SerializeGraph(UEdGraph* Graph)
 {
@@ -24,14 +306,14 @@ TSharedPtr<FJsonObject> FBlueprintGraphSerializer::SerializeGraph(UEdGraph* Grap
 
 	// Initialize logger for this serialization session
 	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Serialization"));
-	FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Serializing Graph: %s"), *Graph->GetName()));
-	FUnrealGraphLogger::LogFormatted(TEXT("Graph has %d nodes"), Graph->Nodes.Num());
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Serializing Graph: %s"), *Graph->GetName()));
+	UNREALGRAPH_LOG(Summary, TEXT("Graph has %d nodes"), Graph->Nodes.Num());
 
 	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
 
 	// Add metadata
 	TSharedPtr<FJsonObject> MetadataObject = MakeShareable(new FJsonObject);
-	MetadataObject->SetStringField(TEXT("version"), TEXT("1.0"));
+	MetadataObject->SetStringField(TEXT("version"), FBlueprintGraphJsonSchema::GetCurrentSchemaVersion());
 	MetadataObject->SetStringField(TEXT("unrealVersion"), TEXT("5.3.0"));
 	MetadataObject->SetStringField(TEXT("exportDate"), FDateTime::Now().ToIso8601());
 	RootObject->SetObjectField(TEXT("metadata"), MetadataObject);
@@ -61,8 +343,8 @@ TSharedPtr<FJsonObject> FBlueprintGraphSerializer::SerializeGraph(UEdGraph* Grap
 	RootObject->SetObjectField(TEXT("graph"), GraphObject);
 
 	// Log completion and shutdown logger
-	FUnrealGraphLogger::LogSection(TEXT("Serialization Complete"));
-	FUnrealGraphLogger::LogFormatted(TEXT("Successfully serialized %d nodes and %d connections"), NodesArray.Num(), ConnectionsArray.Num());
+	UNREALGRAPH_LOG_SECTION(Summary, TEXT("Serialization Complete"));
+	UNREALGRAPH_LOG(Summary, TEXT("Successfully serialized %d nodes and %d connections"), NodesArray.Num(), ConnectionsArray.Num());
 	FUnrealGraphLogger::Shutdown();
 
 	return RootObject;
@@ -80,232 +362,21 @@ TSharedPtr<FJsonObject> FBlueprintGraphSerializer::SerializeNode(UEdGraphNode* N
 	// Basic node information
 	NodeObject->SetStringField(TEXT("id"), GetNodeId(Node));
 	NodeObject->SetStringField(TEXT("type"), GetNodeClassName(Node));
+	NodeObject->SetStringField(TEXT("classPath"), Node->GetClass()->GetPathName());
 	NodeObject->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
 
 	// Log node details for analysis
-	FUnrealGraphLogger::LogNodeDetails(Node);
-
-	// Position - Get node position
-	FUnrealGraphLogger::LogSection(FString::Printf(TEXT("Position Detection for Node: %s"), *Node->GetName()));
-	TSharedPtr<FJsonObject> PositionObject = MakeShareable(new FJsonObject);
-	FVector2D NodePosition(0.0f, 0.0f);
-	bool bPositionFound = false;
-	
-	// Method 1: Try multiple property name variations
-	FUnrealGraphLogger::Log(TEXT("Method 1: Searching for Vector2D position properties..."));
-	const TArray<FName> PositionPropertyNames = {
-		TEXT("NodePos"),
-		TEXT("NodePosition"),
-		TEXT("Position"),
-		TEXT("Pos")
-	};
-	
-	for (const FName& PropName : PositionPropertyNames)
-	{
-		FUnrealGraphLogger::LogFormatted(TEXT("  Checking property: %s"), *PropName.ToString());
-		
-		// Try in current class
-		if (FProperty* PosProp = Node->GetClass()->FindPropertyByName(PropName))
-		{
-			FUnrealGraphLogger::LogFormatted(TEXT("    Found property '%s' in class '%s'"), *PropName.ToString(), *Node->GetClass()->GetName());
-			
-			if (FStructProperty* StructProp = CastField<FStructProperty>(PosProp))
-			{
-				if (StructProp->Struct && StructProp->Struct->GetFName() == NAME_Vector2D)
-				{
-					const FVector2D* PosPtr = StructProp->ContainerPtrToValuePtr<FVector2D>(Node);
-					if (PosPtr)
-					{
-						NodePosition = *PosPtr;
-						bPositionFound = true;
-						FUnrealGraphLogger::LogFormatted(TEXT("    ✓ SUCCESS: Found position via property %s: (%.1f, %.1f)"), 
-							*PropName.ToString(), NodePosition.X, NodePosition.Y);
-						UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found position via property %s: (%.1f, %.1f)"), 
-							*PropName.ToString(), NodePosition.X, NodePosition.Y);
-						break;
-					}
-					else
-					{
-						FUnrealGraphLogger::Log(TEXT("    ✗ Property found but pointer is null"));
-					}
-				}
-				else
-				{
-					FUnrealGraphLogger::LogFormatted(TEXT("    ✗ Property found but not Vector2D type"));
-				}
-			}
-		}
-		else
-		{
-			FUnrealGraphLogger::Log(TEXT("    ✗ Property not found in current class"));
-		}
-		
-		// Try through all base classes
-		if (!bPositionFound)
-		{
-			FUnrealGraphLogger::Log(TEXT("    Checking base classes..."));
-			for (UClass* Class = Node->GetClass(); Class && !bPositionFound; Class = Class->GetSuperClass())
-			{
-				if (FProperty* PosProp = Class->FindPropertyByName(PropName))
-				{
-					FUnrealGraphLogger::LogFormatted(TEXT("      Found property '%s' in base class '%s'"), *PropName.ToString(), *Class->GetName());
-					
-					if (FStructProperty* StructProp = CastField<FStructProperty>(PosProp))
-					{
-						if (StructProp->Struct && StructProp->Struct->GetFName() == NAME_Vector2D)
-						{
-							const FVector2D* PosPtr = StructProp->ContainerPtrToValuePtr<FVector2D>(Node);
-							if (PosPtr)
-							{
-								NodePosition = *PosPtr;
-								bPositionFound = true;
-								FUnrealGraphLogger::LogFormatted(TEXT("      ✓ SUCCESS: Found position via property %s in class %s: (%.1f, %.1f)"), 
-									*PropName.ToString(), *Class->GetName(), NodePosition.X, NodePosition.Y);
-								UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found position via property %s in class %s: (%.1f, %.1f)"), 
-									*PropName.ToString(), *Class->GetName(), NodePosition.X, NodePosition.Y);
-								break;
-							}
-						}
-					}
-				}
-			}
-		}
-		
-		if (bPositionFound)
-		{
-			break;
-		}
-	}
-	
-	// Method 2: Try separate X and Y properties (NodePosX, NodePosY)
-	if (!bPositionFound)
-	{
-		FUnrealGraphLogger::Log(TEXT("Method 2: Searching for separate X/Y position properties..."));
-		float PosX = 0.0f;
-		float PosY = 0.0f;
-		bool bHasX = false;
-		bool bHasY = false;
-		
-		// Try to find NodePosX - NOTE: It's an IntProperty, not FloatProperty!
-		for (const FString& XName : { TEXT("NodePosX"), TEXT("PosX"), TEXT("PositionX") })
-		{
-			// Try IntProperty first (this is what Unreal actually uses!)
-			if (FIntProperty* XProp = FindFProperty<FIntProperty>(Node->GetClass(), *XName))
-			{
-				int32 IntValue = XProp->GetPropertyValue_InContainer(Node);
-				PosX = static_cast<float>(IntValue);
-				bHasX = true;
-				FUnrealGraphLogger::LogFormatted(TEXT("  Found X position via IntProperty %s: %d (%.1f)"), *XName, IntValue, PosX);
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found X position via IntProperty %s: %d"), *XName, IntValue);
-				break;
-			}
-			// Fallback to FloatProperty (in case some nodes use it)
-			else if (FFloatProperty* XPropFloat = FindFProperty<FFloatProperty>(Node->GetClass(), *XName))
-			{
-				PosX = XPropFloat->GetPropertyValue_InContainer(Node);
-				bHasX = true;
-				FUnrealGraphLogger::LogFormatted(TEXT("  Found X position via FloatProperty %s: %.1f"), *XName, PosX);
-				break;
-			}
-		}
-		
-		// Try to find NodePosY - NOTE: It's an IntProperty, not FloatProperty!
-		for (const FString& YName : { TEXT("NodePosY"), TEXT("PosY"), TEXT("PositionY") })
-		{
-			// Try IntProperty first (this is what Unreal actually uses!)
-			if (FIntProperty* YProp = FindFProperty<FIntProperty>(Node->GetClass(), *YName))
-			{
-				int32 IntValue = YProp->GetPropertyValue_InContainer(Node);
-				PosY = static_cast<float>(IntValue);
-				bHasY = true;
-				FUnrealGraphLogger::LogFormatted(TEXT("  Found Y position via IntProperty %s: %d (%.1f)"), *YName, IntValue, PosY);
-				UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found Y position via IntProperty %s: %d"), *YName, IntValue);
-				break;
-			}
-			// Fallback to FloatProperty (in case some nodes use it)
-			else if (FFloatProperty* YPropFloat = FindFProperty<FFloatProperty>(Node->GetClass(), *YName))
-			{
-				PosY = YPropFloat->GetPropertyValue_InContainer(Node);
-				bHasY = true;
-				FUnrealGraphLogger::LogFormatted(TEXT("  Found Y position via FloatProperty %s: %.1f"), *YName, PosY);
-				break;
-			}
-		}
-		
-		if (bHasX && bHasY)
-		{
-			NodePosition = FVector2D(PosX, PosY);
-			bPositionFound = true;
-			UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found position via separate X/Y properties: (%.1f, %.1f)"), 
-				NodePosition.X, NodePosition.Y);
-		}
-	}
-	
-	// Method 3: Iterate through all properties to find any Vector2D
-	if (!bPositionFound)
+	if (UNREALGRAPH_LOG_ACTIVE(Trace))
 	{
-		FUnrealGraphLogger::Log(TEXT("Method 3: Iterating through all properties to find Vector2D..."));
-		int32 Vector2DCount = 0;
-		
-		for (TFieldIterator<FProperty> PropIt(Node->GetClass()); PropIt && !bPositionFound; ++PropIt)
-		{
-			FProperty* Prop = *PropIt;
-			if (FStructProperty* StructProp = CastField<FStructProperty>(Prop))
-			{
-				if (StructProp->Struct && StructProp->Struct->GetFName() == NAME_Vector2D)
-				{
-					Vector2DCount++;
-					FName PropName = Prop->GetFName();
-					FString PropNameStr = PropName.ToString();
-					
-					FUnrealGraphLogger::LogFormatted(TEXT("  Found Vector2D property: %s"), *PropNameStr);
-					
-					if (PropNameStr.Contains(TEXT("Pos")) || PropNameStr.Contains(TEXT("Position")))
-					{
-						const FVector2D* PosPtr = StructProp->ContainerPtrToValuePtr<FVector2D>(Node);
-						if (PosPtr)
-						{
-							FUnrealGraphLogger::LogFormatted(TEXT("    Property value: (%.1f, %.1f)"), PosPtr->X, PosPtr->Y);
-							
-							if (PosPtr->X != 0.0f || PosPtr->Y != 0.0f)
-							{
-								NodePosition = *PosPtr;
-								bPositionFound = true;
-								FUnrealGraphLogger::LogFormatted(TEXT("    ✓ SUCCESS: Found position via property iteration: %s = (%.1f, %.1f)"), 
-									*PropNameStr, NodePosition.X, NodePosition.Y);
-								UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Found position via property iteration: %s = (%.1f, %.1f)"), 
-									*PropNameStr, NodePosition.X, NodePosition.Y);
-								break;
-							}
-							else
-							{
-								FUnrealGraphLogger::Log(TEXT("    ✗ Position is (0,0) - skipping"));
-							}
-						}
-					}
-				}
-			}
-		}
-		
-		FUnrealGraphLogger::LogFormatted(TEXT("  Total Vector2D properties found: %d"), Vector2DCount);
+		FUnrealGraphLogger::LogNodeDetails(Node);
 	}
-	
-	// Serialize position (even if (0,0) - deserialization can still use it)
+
+	// Position - Serialized even if (0,0); deserialization can still use it
+	const FVector2D NodePosition = ReadNodePosition(Node);
+	TSharedPtr<FJsonObject> PositionObject = MakeShareable(new FJsonObject);
 	PositionObject->SetNumberField(TEXT("x"), static_cast<double>(NodePosition.X));
 	PositionObject->SetNumberField(TEXT("y"), static_cast<double>(NodePosition.Y));
 	NodeObject->SetObjectField(TEXT("position"), PositionObject);
-	
-	if (!bPositionFound && NodePosition.X == 0.0f && NodePosition.Y == 0.0f)
-	{
-		FUnrealGraphLogger::Log(TEXT("✗ FAILED: Node position not found, serializing as (0,0)"));
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Node position not found for %s, serializing as (0,0)"), *Node->GetName());
-	}
-	else if (bPositionFound)
-	{
-		FUnrealGraphLogger::LogFormatted(TEXT("✓ SUCCESS: Final position: (%.1f, %.1f)"), NodePosition.X, NodePosition.Y);
-		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Serializing node %s position: (%.1f, %.1f)"), 
-			*Node->GetName(), NodePosition.X, NodePosition.Y);
-	}
 
 	// Comment - Serialize node comment
 	// TODO: Fix NodeComment serialization - FText conversion needs proper API
@@ -358,20 +429,7 @@ TSharedPtr<FJsonObject> FBlueprintGraphSerializer::SerializePin(UEdGraphPin* Pin
 		PinObject->SetStringField(TEXT("defaultValue"), Pin->DefaultValue);
 	}
 
-	// Store connected node IDs (will be used for connections array)
-	TArray<TSharedPtr<FJsonValue>> ConnectedNodeIds;
-	for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-	{
-		if (LinkedPin && LinkedPin->GetOwningNode())
-		{
-			ConnectedNodeIds.Add(MakeShareable(new FJsonValueString(GetNodeId(LinkedPin->GetOwningNode()))));
-		}
-	}
-	if (ConnectedNodeIds.Num() > 0)
-	{
-		PinObject->SetArrayField(TEXT("connectedNodeIds"), ConnectedNodeIds);
-	}
-
+	// Links are only written to the graph's "connections" array
 	return PinObject;
 }
 
@@ -384,7 +442,25 @@ TArray<TSharedPtr<FJsonValue>> FBlueprintGraphSerializer::SerializeConnections(U
 		return ConnectionsArray;
 	}
 
-	// Iterate through all nodes and their pins to find connections
+	const FEndpointIndices EndpointIndices(Graph->Nodes);
+
+	// One [fromNode, fromPin, toNode, toPin] tuple per link, from the output side
+	auto AddEndpoint = [&EndpointIndices](UEdGraphPin* Pin, TArray<TSharedPtr<FJsonValue>>& Tuple)
+	{
+		int32 NodeIndex, PinIndex;
+		if (EndpointIndices.Find(Pin, NodeIndex, PinIndex))
+		{
+			Tuple.Add(MakeShareable(new FJsonValueNumber(NodeIndex)));
+			Tuple.Add(MakeShareable(new FJsonValueNumber(PinIndex)));
+		}
+		else
+		{
+			// Linked node that is not part of this graph: refer to it by id and pin name
+			Tuple.Add(MakeShareable(new FJsonValueString(GetNodeId(Pin->GetOwningNode()))));
+			Tuple.Add(MakeShareable(new FJsonValueString(Pin->PinName.ToString())));
+		}
+	};
+
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
 		if (!Node)
@@ -399,26 +475,14 @@ TArray<TSharedPtr<FJsonValue>> FBlueprintGraphSerializer::SerializeConnections(U
 				continue;
 			}
 
-			// Create connection entries for each linked pin
 			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
 			{
 				if (LinkedPin && LinkedPin->GetOwningNode())
 				{
-					TSharedPtr<FJsonObject> ConnectionObject = MakeShareable(new FJsonObject);
-
-					// From pin
-					TSharedPtr<FJsonObject> FromObject = MakeShareable(new FJsonObject);
-					FromObject->SetStringField(TEXT("nodeId"), GetNodeId(Node));
-					FromObject->SetStringField(TEXT("pinName"), Pin->PinName.ToString());
-					ConnectionObject->SetObjectField(TEXT("from"), FromObject);
-
-					// To pin
-					TSharedPtr<FJsonObject> ToObject = MakeShareable(new FJsonObject);
-					ToObject->SetStringField(TEXT("nodeId"), GetNodeId(LinkedPin->GetOwningNode()));
-					ToObject->SetStringField(TEXT("pinName"), LinkedPin->PinName.ToString());
-					ConnectionObject->SetObjectField(TEXT("to"), ToObject);
-
-					ConnectionsArray.Add(MakeShareable(new FJsonValueObject(ConnectionObject)));
+					TArray<TSharedPtr<FJsonValue>> Tuple;
+					AddEndpoint(Pin, Tuple);
+					AddEndpoint(LinkedPin, Tuple);
+					ConnectionsArray.Add(MakeShareable(new FJsonValueArray(Tuple)));
 				}
 			}
 		}
@@ -462,107 +526,54 @@ void FBlueprintGraphSerializer::SerializeNodeProperties(UEdGraphNode* Node, TSha
 		return;
 	}
 
-	FString NodeTypeName = GetNodeClassName(Node);
+	const FNodeMemberFields Fields = GatherNodeMemberFields(Node);
 
-	// Serialize properties for K2Node_CallFunction
-	if (NodeTypeName == TEXT("K2Node_CallFunction"))
+	if (!Fields.FunctionName.IsEmpty())
 	{
-		// Try to get function reference using reflection
-		if (FObjectProperty* FunctionProp = CastField<FObjectProperty>(Node->GetClass()->FindPropertyByName(TEXT("FunctionReference"))))
-		{
-			// FunctionReference is a struct, need to access it differently
-		}
-		else if (FStructProperty* FunctionRefProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(TEXT("FunctionReference"))))
-		{
-			// Access the function reference struct and extract member name
-			void* FunctionRefPtr = FunctionRefProp->ContainerPtrToValuePtr<void>(Node);
-			if (FunctionRefPtr)
-			{
-				// Try to get MemberName from the struct
-				if (FNameProperty* MemberNameProp = CastField<FNameProperty>(FunctionRefProp->Struct->FindPropertyByName(TEXT("MemberName"))))
-				{
-					FName MemberName = MemberNameProp->GetPropertyValue_InContainer(FunctionRefPtr);
-					if (!MemberName.IsNone())
-					{
-						NodeObject->SetStringField(TEXT("functionName"), MemberName.ToString());
-					}
-				}
-			}
-		}
+		NodeObject->SetStringField(TEXT("functionName"), Fields.FunctionName);
+	}
+	if (!Fields.VariableName.IsEmpty())
+	{
+		NodeObject->SetStringField(TEXT("variableName"), Fields.VariableName);
+	}
+	if (!Fields.EventName.IsEmpty())
+	{
+		NodeObject->SetStringField(TEXT("eventName"), Fields.EventName);
+	}
+	if (!Fields.EventClass.IsEmpty())
+	{
+		NodeObject->SetStringField(TEXT("eventClass"), Fields.EventClass);
+		NodeObject->SetStringField(TEXT("eventClassPath"), Fields.EventClassPath);
+	}
+	if (Fields.MemberReference)
+	{
+		SerializeMemberReference(*Fields.MemberReference, NodeObject);
+	}
+	if (Fields.bIsCustomEvent)
+	{
+		NodeObject->SetBoolField(TEXT("isCustomEvent"), true);
 	}
+}
+
+void FBlueprintGraphSerializer::SerializeMemberReference(const FMemberReference& Reference, TSharedPtr<FJsonObject>& NodeObject)
+{
+	TSharedPtr<FJsonObject> ReferenceObject = MakeShareable(new FJsonObject);
+	ReferenceObject->SetStringField(TEXT("memberName"), Reference.GetMemberName().ToString());
 
-	// Serialize properties for K2Node_VariableGet and K2Node_VariableSet
-	else if (NodeTypeName == TEXT("K2Node_VariableGet") || NodeTypeName == TEXT("K2Node_VariableSet"))
+	// Self-context members have no parent; they resolve against the Blueprint being pasted into
+	if (UClass* ParentClass = Reference.GetMemberParentClass())
 	{
-		// Try to get variable reference
-		if (FStructProperty* VariableRefProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(TEXT("VariableReference"))))
-		{
-			void* VariableRefPtr = VariableRefProp->ContainerPtrToValuePtr<void>(Node);
-			if (VariableRefPtr)
-			{
-				if (FNameProperty* MemberNameProp = CastField<FNameProperty>(VariableRefProp->Struct->FindPropertyByName(TEXT("MemberName"))))
-				{
-					FName MemberName = MemberNameProp->GetPropertyValue_InContainer(VariableRefPtr);
-					if (!MemberName.IsNone())
-					{
-						NodeObject->SetStringField(TEXT("variableName"), MemberName.ToString());
-					}
-				}
-			}
-		}
+		ReferenceObject->SetStringField(TEXT("memberParent"), ParentClass->GetPathName());
 	}
 
-	// Serialize properties for K2Node_Event
-	else if (NodeTypeName == TEXT("K2Node_Event"))
+	if (Reference.GetMemberGuid().IsValid())
 	{
-		// Try EventReference first (for standard events like BeginPlay)
-		FStructProperty* EventRefProp = CastField<FStructProperty>(Node->GetClass()->FindPropertyByName(TEXT("EventReference")));
-		if (EventRefProp && EventRefProp->Struct)
-		{
-			void* EventRefPtr = EventRefProp->ContainerPtrToValuePtr<void>(Node);
-			if (EventRefPtr)
-			{
-				// Get MemberName (event function name)
-				if (FNameProperty* MemberNameProp = CastField<FNameProperty>(EventRefProp->Struct->FindPropertyByName(TEXT("MemberName"))))
-				{
-					FName MemberName = MemberNameProp->GetPropertyValue_InContainer(EventRefPtr);
-					if (!MemberName.IsNone())
-					{
-						NodeObject->SetStringField(TEXT("eventName"), MemberName.ToString());
-						
-						// Get MemberParent (the class containing the event) - important for standard events
-						if (FObjectProperty* MemberParentProp = CastField<FObjectProperty>(EventRefProp->Struct->FindPropertyByName(TEXT("MemberParent"))))
-						{
-							UObject* MemberParent = MemberParentProp->GetObjectPropertyValue_InContainer(EventRefPtr);
-							if (MemberParent)
-							{
-								UClass* ParentClass = Cast<UClass>(MemberParent);
-								if (ParentClass)
-								{
-									NodeObject->SetStringField(TEXT("eventClass"), ParentClass->GetName());
-									NodeObject->SetStringField(TEXT("eventClassPath"), ParentClass->GetPathName());
-								}
-							}
-						}
-					}
-				}
-			}
-		}
-		
-		// Fallback: Try CustomFunctionName (for custom events)
-		if (!NodeObject->HasField(TEXT("eventName")))
-		{
-			if (FNameProperty* EventNameProp = CastField<FNameProperty>(Node->GetClass()->FindPropertyByName(TEXT("CustomFunctionName"))))
-			{
-				FName EventName = EventNameProp->GetPropertyValue_InContainer(Node);
-				if (!EventName.IsNone())
-				{
-					NodeObject->SetStringField(TEXT("eventName"), EventName.ToString());
-					NodeObject->SetBoolField(TEXT("isCustomEvent"), true);
-				}
-			}
-		}
+		ReferenceObject->SetStringField(TEXT("memberGuid"), Reference.GetMemberGuid().ToString());
 	}
+
+	ReferenceObject->SetBoolField(TEXT("selfContext"), Reference.IsSelfContext());
+
+	NodeObject->SetObjectField(TEXT("memberReference"), ReferenceObject);
 }
 
 FString FBlueprintGraphSerializer::JsonToString(const TSharedPtr<FJsonObject>& JsonObject, bool bPrettyPrint)
@@ -573,11 +584,939 @@ FString FBlueprintGraphSerializer::JsonToString(const TSharedPtr<FJsonObject>& J
 	}
 
 	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	if (bPrettyPrint)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	}
+	else
+	{
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	}
 
-	// If pretty printing is needed, we can format manually or use a different writer
-	// For now, return the basic serialization
 	return OutputString;
 }
 
+template <class WriterType>
+void FBlueprintGraphSerializer::WritePin(UEdGraphPin* Pin, WriterType& Writer)
+{
+	Writer.WriteObjectStart();
+
+	Writer.WriteValue(TEXT("name"), Pin->PinName.ToString());
+	Writer.WriteValue(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
+
+	Writer.WriteValue(TEXT("pinCategory"), Pin->PinType.PinCategory.ToString());
+	if (!Pin->PinType.PinSubCategory.IsNone())
+	{
+		Writer.WriteValue(TEXT("pinSubCategory"), Pin->PinType.PinSubCategory.ToString());
+	}
+
+	if (!Pin->DefaultValue.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("defaultValue"), Pin->DefaultValue);
+	}
+
+	Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FBlueprintGraphSerializer::WriteNode(UEdGraphNode* Node, WriterType& Writer)
+{
+	Writer.WriteObjectStart();
+
+	// Basic node information
+	Writer.WriteValue(TEXT("id"), GetNodeId(Node));
+	Writer.WriteValue(TEXT("type"), GetNodeClassName(Node));
+	Writer.WriteValue(TEXT("classPath"), Node->GetClass()->GetPathName());
+	Writer.WriteValue(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+
+	if (UNREALGRAPH_LOG_ACTIVE(Trace))
+	{
+		FUnrealGraphLogger::LogNodeDetails(Node);
+	}
+
+	const FVector2D NodePosition = ReadNodePosition(Node);
+	Writer.WriteObjectStart(TEXT("position"));
+	Writer.WriteValue(TEXT("x"), static_cast<double>(NodePosition.X));
+	Writer.WriteValue(TEXT("y"), static_cast<double>(NodePosition.Y));
+	Writer.WriteObjectEnd();
+
+	// Node-specific properties, same order as SerializeNodeProperties
+	const FNodeMemberFields Fields = GatherNodeMemberFields(Node);
+	if (!Fields.FunctionName.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("functionName"), Fields.FunctionName);
+	}
+	if (!Fields.VariableName.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("variableName"), Fields.VariableName);
+	}
+	if (!Fields.EventName.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("eventName"), Fields.EventName);
+	}
+	if (!Fields.EventClass.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("eventClass"), Fields.EventClass);
+		Writer.WriteValue(TEXT("eventClassPath"), Fields.EventClassPath);
+	}
+	if (Fields.MemberReference)
+	{
+		const FMemberReference& Reference = *Fields.MemberReference;
+		Writer.WriteObjectStart(TEXT("memberReference"));
+		Writer.WriteValue(TEXT("memberName"), Reference.GetMemberName().ToString());
+		if (UClass* ParentClass = Reference.GetMemberParentClass())
+		{
+			Writer.WriteValue(TEXT("memberParent"), ParentClass->GetPathName());
+		}
+		if (Reference.GetMemberGuid().IsValid())
+		{
+			Writer.WriteValue(TEXT("memberGuid"), Reference.GetMemberGuid().ToString());
+		}
+		Writer.WriteValue(TEXT("selfContext"), Reference.IsSelfContext());
+		Writer.WriteObjectEnd();
+	}
+	if (Fields.bIsCustomEvent)
+	{
+		Writer.WriteValue(TEXT("isCustomEvent"), true);
+	}
+
+	Writer.WriteArrayStart(TEXT("pins"));
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		if (Pin)
+		{
+			WritePin(Pin, Writer);
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+bool FBlueprintGraphSerializer::WriteGraph(UEdGraph* Graph, WriterType& Writer)
+{
+	// Mirrors SerializeGraph + JsonToString field for field; keep the two in sync
+	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Serialization"));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Serializing Graph: %s"), *Graph->GetName()));
+	UNREALGRAPH_LOG(Summary, TEXT("Graph has %d nodes (streaming writer)"), Graph->Nodes.Num());
+
+	Writer.WriteObjectStart();
+
+	Writer.WriteObjectStart(TEXT("metadata"));
+	Writer.WriteValue(TEXT("version"), FBlueprintGraphJsonSchema::GetCurrentSchemaVersion());
+	Writer.WriteValue(TEXT("unrealVersion"), TEXT("5.3.0"));
+	Writer.WriteValue(TEXT("exportDate"), FDateTime::Now().ToIso8601());
+	Writer.WriteObjectEnd();
+
+	Writer.WriteObjectStart(TEXT("graph"));
+
+	int32 NodeCount = 0;
+	Writer.WriteArrayStart(TEXT("nodes"));
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			WriteNode(Node, Writer);
+			++NodeCount;
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	const FEndpointIndices EndpointIndices(Graph->Nodes);
+	auto WriteEndpoint = [&EndpointIndices, &Writer](UEdGraphPin* Pin)
+	{
+		int32 NodeIndex, PinIndex;
+		if (EndpointIndices.Find(Pin, NodeIndex, PinIndex))
+		{
+			Writer.WriteValue(NodeIndex);
+			Writer.WriteValue(PinIndex);
+		}
+		else
+		{
+			Writer.WriteValue(GetNodeId(Pin->GetOwningNode()));
+			Writer.WriteValue(Pin->PinName.ToString());
+		}
+	};
+
+	int32 ConnectionCount = 0;
+	Writer.WriteArrayStart(TEXT("connections"));
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output)
+			{
+				continue;
+			}
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (LinkedPin && LinkedPin->GetOwningNode())
+				{
+					Writer.WriteArrayStart();
+					WriteEndpoint(Pin);
+					WriteEndpoint(LinkedPin);
+					Writer.WriteArrayEnd();
+					++ConnectionCount;
+				}
+			}
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+	Writer.WriteObjectEnd();
+	const bool bClosed = Writer.Close();
+
+	UNREALGRAPH_LOG_SECTION(Summary, TEXT("Serialization Complete"));
+	UNREALGRAPH_LOG(Summary, TEXT("Successfully serialized %d nodes and %d connections"), NodeCount, ConnectionCount);
+	FUnrealGraphLogger::Shutdown();
+
+	return bClosed;
+}
+
+template <class WriterType>
+void FBlueprintGraphSerializer::WriteDescriptionNode(const FBlueprintGraphDescription& Description, const FBlueprintGraphNodeDescription& Node, WriterType& Writer,
+	const FBlueprintGraphNodeHashes* Hashes, const TArray<int32>* StringReferences)
+{
+	auto WriteOptional = [&Description, &Writer, StringReferences](const TCHAR* Field, int32 StringIndex)
+	{
+		if (StringIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		if (StringReferences)
+		{
+			Writer.WriteValue(Field, (*StringReferences)[StringIndex]);
+		}
+		else
+		{
+			Writer.WriteValue(Field, Description.GetString(StringIndex));
+		}
+	};
+
+	Writer.WriteObjectStart();
+
+	WriteOptional(TEXT("id"), Node.Id);
+	if (Hashes)
+	{
+		Writer.WriteValue(TEXT("contentHash"), FBlueprintGraphContentHash::ToString(Hashes->Content));
+		Writer.WriteValue(TEXT("layoutHash"), FBlueprintGraphContentHash::ToString(Hashes->Layout));
+	}
+	WriteOptional(TEXT("type"), Node.Type);
+	WriteOptional(TEXT("classPath"), Node.ClassPath);
+	WriteOptional(TEXT("title"), Node.Title);
+
+	if (Node.bHasPosition)
+	{
+		Writer.WriteObjectStart(TEXT("position"));
+		Writer.WriteValue(TEXT("x"), Node.PositionX);
+		Writer.WriteValue(TEXT("y"), Node.PositionY);
+		Writer.WriteObjectEnd();
+	}
+
+	WriteOptional(TEXT("functionName"), Node.FunctionName);
+	WriteOptional(TEXT("variableName"), Node.VariableName);
+	WriteOptional(TEXT("eventName"), Node.EventName);
+	WriteOptional(TEXT("eventClass"), Node.EventClass);
+	WriteOptional(TEXT("eventClassPath"), Node.EventClassPath);
+
+	if (Node.bHasMemberReference)
+	{
+		Writer.WriteObjectStart(TEXT("memberReference"));
+		WriteOptional(TEXT("memberName"), Node.MemberName);
+		WriteOptional(TEXT("memberParent"), Node.MemberParent);
+		WriteOptional(TEXT("memberGuid"), Node.MemberGuid);
+		Writer.WriteValue(TEXT("selfContext"), Node.bSelfContext);
+		Writer.WriteObjectEnd();
+	}
+
+	if (Node.bHasIsCustomEvent)
+	{
+		Writer.WriteValue(TEXT("isCustomEvent"), Node.bIsCustomEvent);
+	}
+
+	Writer.WriteArrayStart(TEXT("pins"));
+	for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+	{
+		const FBlueprintGraphPinDescription& Pin = Description.Pins[PinIndex];
+		Writer.WriteObjectStart();
+
+		WriteOptional(TEXT("name"), Pin.Name);
+		Writer.WriteValue(TEXT("direction"), Pin.Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
+		WriteOptional(TEXT("pinCategory"), Pin.Category);
+		WriteOptional(TEXT("pinSubCategory"), Pin.SubCategory);
+		WriteOptional(TEXT("defaultValue"), Pin.DefaultValue);
+
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FBlueprintGraphSerializer::WriteDescriptionConnection(const FBlueprintGraphDescription& Description, const FBlueprintGraphConnectionDescription& Connection, WriterType& Writer)
+{
+	auto WriteEndpoint = [&Description, &Writer](const FBlueprintGraphConnectionEndpoint& Endpoint)
+	{
+		if (Endpoint.Node != INDEX_NONE)
+		{
+			Writer.WriteValue(Endpoint.Node);
+		}
+		else
+		{
+			Writer.WriteValue(Description.GetString(Endpoint.NodeId));
+		}
+
+		if (Endpoint.Pin != INDEX_NONE)
+		{
+			Writer.WriteValue(Endpoint.Pin);
+		}
+		else
+		{
+			Writer.WriteValue(Description.GetString(Endpoint.PinName));
+		}
+	};
+
+	Writer.WriteArrayStart();
+	WriteEndpoint(Connection.From);
+	WriteEndpoint(Connection.To);
+	Writer.WriteArrayEnd();
+}
+
+template <class WriterType>
+bool FBlueprintGraphSerializer::WriteDescription(const FBlueprintGraphDescription& Description, WriterType& Writer, const FString* NodesJson)
+{
+	auto WriteOptional = [&Description, &Writer](const TCHAR* Field, int32 StringIndex)
+	{
+		if (StringIndex != INDEX_NONE)
+		{
+			Writer.WriteValue(Field, Description.GetString(StringIndex));
+		}
+	};
+
+	Writer.WriteObjectStart();
+
+	Writer.WriteObjectStart(TEXT("metadata"));
+	WriteOptional(TEXT("version"), Description.Version);
+	WriteOptional(TEXT("unrealVersion"), Description.UnrealVersion);
+	WriteOptional(TEXT("exportDate"), Description.ExportDate);
+	Writer.WriteObjectEnd();
+
+	Writer.WriteObjectStart(TEXT("graph"));
+
+	if (NodesJson)
+	{
+		// Node objects encoded ahead of time (see WriteDescriptionJsonParallel)
+		Writer.WriteRawJSONValue(TEXT("nodes"), *NodesJson);
+	}
+	else
+	{
+		Writer.WriteArrayStart(TEXT("nodes"));
+		for (const FBlueprintGraphNodeDescription& Node : Description.Nodes)
+		{
+			WriteDescriptionNode(Description, Node, Writer);
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	Writer.WriteArrayStart(TEXT("connections"));
+	for (const FBlueprintGraphConnectionDescription& Connection : Description.Connections)
+	{
+		WriteDescriptionConnection(Description, Connection, Writer);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+	Writer.WriteObjectEnd();
+	return Writer.Close();
+}
+
+template <class PrintPolicy>
+bool FBlueprintGraphSerializer::WriteDescriptionJsonParallel(const FBlueprintGraphDescription& Description, FString& OutJson, bool bPrettyPrint)
+{
+	// Node objects sit at indent level 3 (root, graph, nodes array). Each chunk is written by its own writer
+	// started at that level, and the chunks are joined with the separators the single writer would emit.
+	constexpr int32 NodeIndentLevel = 3;
+
+	const int32 NumNodes = Description.Nodes.Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumNodes, UnrealGraphSerializer::ParallelEncodeChunkSize);
+	TArray<FString> Chunks;
+	Chunks.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&Description, &Chunks, NumNodes, bPrettyPrint](int32 ChunkIndex)
+	{
+		const int32 FirstNode = ChunkIndex * UnrealGraphSerializer::ParallelEncodeChunkSize;
+		const int32 EndNode = FMath::Min(FirstNode + UnrealGraphSerializer::ParallelEncodeChunkSize, NumNodes);
+
+		FString& Chunk = Chunks[ChunkIndex];
+		Chunk.Reserve((EndNode - FirstNode) * 2048);
+		for (int32 NodeIndex = FirstNode; NodeIndex < EndNode; ++NodeIndex)
+		{
+			Chunk += GetJsonArrayElementPrefix(NodeIndex == 0, NodeIndentLevel, bPrettyPrint);
+
+			FString NodeJson;
+			TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> Writer = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(&NodeJson, NodeIndentLevel);
+			WriteDescriptionNode(Description, Description.Nodes[NodeIndex], *Writer);
+			Writer->Close();
+			Chunk += NodeJson;
+		}
+	});
+
+	const FString NodesJson = JoinJsonArrayChunks(Chunks, NodeIndentLevel, bPrettyPrint);
+
+	OutJson.Reserve(NodesJson.Len() + Description.Connections.Num() * 64 + 1024);
+	TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> Writer = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(&OutJson);
+	return WriteDescription(Description, *Writer, &NodesJson);
+}
+
+template <class PrintPolicy>
+bool FBlueprintGraphSerializer::WriteBlueprintDescriptionJsonImpl(const FBlueprintDescription& Description, FString& OutJson, bool bPrettyPrint, FBlueprintHashes& OutHashes)
+{
+	const FBlueprintGraphDescription& Content = Description.Content;
+
+	// Graph, node and pin strings are written once, to "strings", and referred to by index
+	TArray<int32> StringReferences;
+	TArray<int32> DocumentStrings;
+	BuildStringReferences(Description, StringReferences, DocumentStrings);
+
+	// Graph objects sit at indent level 2 (root, graphs array); each graph is encoded by its own writer
+	constexpr int32 GraphIndentLevel = 2;
+
+	TArray<FString> GraphChunks;
+	GraphChunks.SetNum(Description.Graphs.Num());
+	OutHashes.Graphs.SetNum(Description.Graphs.Num());
+	ParallelFor(Description.Graphs.Num(), [&Description, &Content, &StringReferences, &GraphChunks, &OutHashes, bPrettyPrint](int32 GraphIndex)
+	{
+		const FBlueprintGraphSectionDescription& Section = Description.Graphs[GraphIndex];
+
+		// Hashed on the same worker, from the same snapshot, right before the graph is written
+		FBlueprintGraphHashes& GraphHashes = OutHashes.Graphs[GraphIndex];
+		FBlueprintGraphContentHash::HashGraph(Content, Section, GraphHashes);
+
+		FString GraphJson;
+		GraphJson.Reserve(Section.NumNodes * 2048 + 256);
+		TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> Writer = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(&GraphJson, GraphIndentLevel);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), StringReferences[Section.Name]);
+		Writer->WriteValue(TEXT("kind"), StringReferences[Section.Kind]);
+		if (Section.ParentGraph != INDEX_NONE)
+		{
+			Writer->WriteValue(TEXT("parentGraph"), Section.ParentGraph);
+		}
+		Writer->WriteValue(TEXT("contentHash"), FBlueprintGraphContentHash::ToString(GraphHashes.ContentRoot));
+		Writer->WriteValue(TEXT("layoutHash"), FBlueprintGraphContentHash::ToString(GraphHashes.LayoutRoot));
+
+		Writer->WriteArrayStart(TEXT("nodes"));
+		for (int32 NodeIndex = 0; NodeIndex < Section.NumNodes; ++NodeIndex)
+		{
+			WriteDescriptionNode(Content, Content.Nodes[Section.FirstNode + NodeIndex], *Writer, &GraphHashes.Nodes[NodeIndex], &StringReferences);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("connections"));
+		for (int32 ConnectionIndex = Section.FirstConnection; ConnectionIndex < Section.FirstConnection + Section.NumConnections; ++ConnectionIndex)
+		{
+			WriteDescriptionConnection(Content, Content.Connections[ConnectionIndex], *Writer);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		GraphChunks[GraphIndex] = GetJsonArrayElementPrefix(GraphIndex == 0, GraphIndentLevel, bPrettyPrint) + GraphJson;
+	});
+
+	const FString GraphsJson = JoinJsonArrayChunks(GraphChunks, GraphIndentLevel, bPrettyPrint);
+	FBlueprintGraphContentHash::FinishBlueprint(Description, OutHashes);
+
+	int32 StringsLength = 0;
+	for (int32 StringIndex : DocumentStrings)
+	{
+		StringsLength += Content.GetString(StringIndex).Len() + 8;
+	}
+
+	OutJson.Reserve(GraphsJson.Len() + StringsLength + 512);
+	TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> Writer = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(&OutJson);
+
+	Writer->WriteObjectStart();
+
+	Writer->WriteObjectStart(TEXT("metadata"));
+	Writer->WriteValue(TEXT("version"), Content.GetString(Content.Version));
+	Writer->WriteValue(TEXT("unrealVersion"), Content.GetString(Content.UnrealVersion));
+	Writer->WriteValue(TEXT("exportDate"), Content.GetString(Content.ExportDate));
+	Writer->WriteValue(TEXT("blueprint"), Content.GetString(Description.BlueprintPath));
+	Writer->WriteValue(TEXT("contentHash"), FBlueprintGraphContentHash::ToString(OutHashes.ContentRoot));
+	Writer->WriteValue(TEXT("layoutHash"), FBlueprintGraphContentHash::ToString(OutHashes.LayoutRoot));
+	Writer->WriteObjectEnd();
+
+	Writer->WriteArrayStart(TEXT("strings"));
+	for (int32 StringIndex : DocumentStrings)
+	{
+		Writer->WriteValue(Content.GetString(StringIndex));
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteRawJSONValue(TEXT("graphs"), GraphsJson);
+
+	Writer->WriteObjectEnd();
+	return Writer->Close();
+}
+
+bool FBlueprintGraphSerializer::ShouldEncodeInParallel(int32 NumNodes)
+{
+	return UnrealGraphSerializer::ParallelEncodeMinNodes > 0 && NumNodes >= UnrealGraphSerializer::ParallelEncodeMinNodes;
+}
+
+int32 FBlueprintGraphSerializer::GetParallelEncodeChunkSize()
+{
+	return UnrealGraphSerializer::ParallelEncodeChunkSize;
+}
+
+bool FBlueprintGraphSerializer::IsStreamingWriterEnabled()
+{
+	return UnrealGraphSerializer::UseStreamingWriter != 0;
+}
+
+bool FBlueprintGraphSerializer::SerializeGraphToString(UEdGraph* Graph, FString& OutJson, bool bPrettyPrint)
+{
+	if (Graph && ShouldEncodeInParallel(Graph->Nodes.Num()))
+	{
+		// Only the snapshot reads UObjects; encoding runs on worker threads
+		FBlueprintGraphDescription Description;
+		return DescribeGraph(Graph, Description) && WriteDescriptionJson(Description, OutJson, bPrettyPrint);
+	}
+
+	if (IsStreamingWriterEnabled())
+	{
+		return WriteGraphJson(Graph, OutJson, bPrettyPrint);
+	}
+
+	OutJson = JsonToString(SerializeGraph(Graph), bPrettyPrint);
+	return !OutJson.IsEmpty();
+}
+
+bool FBlueprintGraphSerializer::WriteGraphJson(UEdGraph* Graph, FString& OutJson, bool bPrettyPrint)
+{
+	OutJson.Reset();
+	if (!Graph)
+	{
+		return false;
+	}
+
+	// Rough size per node (pins included) so the buffer rarely has to grow
+	OutJson.Reserve(Graph->Nodes.Num() * 2048);
+
+	if (bPrettyPrint)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+		return WriteGraph(Graph, *Writer);
+	}
+
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+	return WriteGraph(Graph, *Writer);
+}
+
+bool FBlueprintGraphSerializer::WriteGraphJsonUtf8(UEdGraph* Graph, TArray<uint8>& OutUtf8, bool bPrettyPrint)
+{
+	OutUtf8.Reset();
+	if (!Graph)
+	{
+		return false;
+	}
+
+	OutUtf8.Reserve(Graph->Nodes.Num() * 2048);
+	FMemoryWriter Archive(OutUtf8);
+
+	if (bPrettyPrint)
+	{
+		TSharedRef<TJsonWriter<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+		return WriteGraph(Graph, *Writer);
+	}
+
+	TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+	return WriteGraph(Graph, *Writer);
+}
+
+bool FBlueprintGraphSerializer::DescribeGraph(UEdGraph* Graph, FBlueprintGraphDescription& OutDescription)
+{
+	OutDescription.Reset();
+	if (!Graph)
+	{
+		return false;
+	}
+
+	// Same content as WriteGraph
+	OutDescription.Version = OutDescription.AddString(FBlueprintGraphJsonSchema::GetCurrentSchemaVersion());
+	OutDescription.UnrealVersion = OutDescription.AddString(TEXT("5.3.0"));
+	OutDescription.ExportDate = OutDescription.AddString(FDateTime::Now().ToIso8601());
+
+	AppendGraphDescription(Graph, OutDescription);
+
+	OutDescription.FinishBuilding();
+	return true;
+}
+
+bool FBlueprintGraphSerializer::DescribeNodes(const TArray<UEdGraphNode*>& Nodes, bool bIncludeBoundaryLinks, FBlueprintGraphDescription& OutDescription)
+{
+	OutDescription.Reset();
+
+	OutDescription.Version = OutDescription.AddString(FBlueprintGraphJsonSchema::GetCurrentSchemaVersion());
+	OutDescription.UnrealVersion = OutDescription.AddString(TEXT("5.3.0"));
+	OutDescription.ExportDate = OutDescription.AddString(FDateTime::Now().ToIso8601());
+
+	AppendNodesDescription(Nodes, bIncludeBoundaryLinks, bIncludeBoundaryLinks, OutDescription);
+
+	OutDescription.FinishBuilding();
+	return true;
+}
+
+bool FBlueprintGraphSerializer::SerializeNodesToString(const TArray<UEdGraphNode*>& Nodes, FString& OutJson, bool bIncludeBoundaryLinks, bool bPrettyPrint)
+{
+	OutJson.Reset();
+
+	FBlueprintGraphDescription Description;
+	return DescribeNodes(Nodes, bIncludeBoundaryLinks, Description) && WriteDescriptionJson(Description, OutJson, bPrettyPrint);
+}
+
+void FBlueprintGraphSerializer::CollectReachableNodes(const TArray<UEdGraphNode*>& Roots, EBlueprintGraphReachDirection Direction, bool bFollowExec, bool bFollowData, TArray<UEdGraphNode*>& OutNodes)
+{
+	OutNodes.Reset();
+
+	TSet<const UEdGraphNode*> Visited;
+	for (UEdGraphNode* Root : Roots)
+	{
+		if (Root && !Visited.Contains(Root))
+		{
+			Visited.Add(Root);
+			OutNodes.Add(Root);
+		}
+	}
+
+	// OutNodes doubles as the breadth-first queue
+	const EEdGraphPinDirection FollowedDirection = Direction == EBlueprintGraphReachDirection::Forward ? EGPD_Output : EGPD_Input;
+	for (int32 QueueIndex = 0; QueueIndex < OutNodes.Num(); ++QueueIndex)
+	{
+		for (UEdGraphPin* Pin : OutNodes[QueueIndex]->Pins)
+		{
+			if (!Pin || Pin->Direction != FollowedDirection || Pin->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+
+			const bool bExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+			if (bExec ? !bFollowExec : !bFollowData)
+			{
+				continue;
+			}
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+				if (!LinkedNode)
+				{
+					continue;
+				}
+
+				bool bAlreadyVisited = false;
+				Visited.Add(LinkedNode, &bAlreadyVisited);
+				if (!bAlreadyVisited)
+				{
+					OutNodes.Add(LinkedNode);
+				}
+			}
+		}
+	}
+}
+
+bool FBlueprintGraphSerializer::SerializeReachableToString(const TArray<UEdGraphNode*>& Roots, EBlueprintGraphReachDirection Direction, bool bFollowExec, bool bFollowData,
+	FString& OutJson, bool bIncludeBoundaryLinks, bool bPrettyPrint)
+{
+	TArray<UEdGraphNode*> Nodes;
+	CollectReachableNodes(Roots, Direction, bFollowExec, bFollowData, Nodes);
+	return SerializeNodesToString(Nodes, OutJson, bIncludeBoundaryLinks, bPrettyPrint);
+}
+
+void FBlueprintGraphSerializer::AppendGraphDescription(UEdGraph* Graph, FBlueprintGraphDescription& OutDescription)
+{
+	AppendNodesDescription(Graph->Nodes, /*bIncludeBoundaryLinks*/ true, /*bIncludeIncomingLinks*/ false, OutDescription);
+}
+
+template <typename NodeArrayType>
+void FBlueprintGraphSerializer::AppendNodesDescription(const NodeArrayType& Nodes, bool bIncludeBoundaryLinks, bool bIncludeIncomingLinks, FBlueprintGraphDescription& OutDescription)
+{
+	// Connection node indices are relative to the first node
+	const FEndpointIndices EndpointIndices(Nodes);
+
+	OutDescription.Nodes.Reserve(OutDescription.Nodes.Num() + Nodes.Num());
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		FBlueprintGraphNodeDescription& NodeDescription = OutDescription.Nodes.AddDefaulted_GetRef();
+		NodeDescription.Id = OutDescription.AddString(GetNodeId(Node));
+		NodeDescription.Type = OutDescription.AddString(GetNodeClassName(Node));
+		NodeDescription.ClassPath = OutDescription.AddString(Node->GetClass()->GetPathName());
+		NodeDescription.Title = OutDescription.AddString(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+
+		const FVector2D NodePosition = ReadNodePosition(Node);
+		NodeDescription.PositionX = static_cast<double>(NodePosition.X);
+		NodeDescription.PositionY = static_cast<double>(NodePosition.Y);
+		NodeDescription.bHasPosition = true;
+
+		const FNodeMemberFields Fields = GatherNodeMemberFields(Node);
+		auto AddOptional = [&OutDescription](const FString& Value)
+		{
+			return Value.IsEmpty() ? INDEX_NONE : OutDescription.AddString(Value);
+		};
+		NodeDescription.FunctionName = AddOptional(Fields.FunctionName);
+		NodeDescription.VariableName = AddOptional(Fields.VariableName);
+		NodeDescription.EventName = AddOptional(Fields.EventName);
+		if (!Fields.EventClass.IsEmpty())
+		{
+			NodeDescription.EventClass = OutDescription.AddString(Fields.EventClass);
+			NodeDescription.EventClassPath = OutDescription.AddString(Fields.EventClassPath);
+		}
+		if (Fields.MemberReference)
+		{
+			const FMemberReference& Reference = *Fields.MemberReference;
+			NodeDescription.bHasMemberReference = true;
+			NodeDescription.MemberName = OutDescription.AddString(Reference.GetMemberName().ToString());
+			if (UClass* ParentClass = Reference.GetMemberParentClass())
+			{
+				NodeDescription.MemberParent = OutDescription.AddString(ParentClass->GetPathName());
+			}
+			if (Reference.GetMemberGuid().IsValid())
+			{
+				NodeDescription.MemberGuid = OutDescription.AddString(Reference.GetMemberGuid().ToString());
+			}
+			NodeDescription.bSelfContext = Reference.IsSelfContext();
+		}
+		NodeDescription.bHasIsCustomEvent = Fields.bIsCustomEvent;
+		NodeDescription.bIsCustomEvent = Fields.bIsCustomEvent;
+
+		NodeDescription.FirstPin = OutDescription.Pins.Num();
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin)
+			{
+				continue;
+			}
+
+			FBlueprintGraphPinDescription& PinDescription = OutDescription.Pins.AddDefaulted_GetRef();
+			PinDescription.Name = OutDescription.AddString(Pin->PinName.ToString());
+			PinDescription.Direction = Pin->Direction;
+			PinDescription.Category = OutDescription.AddString(Pin->PinType.PinCategory.ToString());
+			if (!Pin->PinType.PinSubCategory.IsNone())
+			{
+				PinDescription.SubCategory = OutDescription.AddString(Pin->PinType.PinSubCategory.ToString());
+			}
+			PinDescription.DefaultValue = AddOptional(Pin->DefaultValue);
+		}
+		NodeDescription.NumPins = OutDescription.Pins.Num() - NodeDescription.FirstPin;
+	}
+
+	auto DescribeEndpoint = [&EndpointIndices, &OutDescription](UEdGraphPin* Pin)
+	{
+		FBlueprintGraphConnectionEndpoint Endpoint;
+		if (!EndpointIndices.Find(Pin, Endpoint.Node, Endpoint.Pin))
+		{
+			Endpoint.NodeId = OutDescription.AddString(GetNodeId(Pin->GetOwningNode()));
+			Endpoint.PinName = OutDescription.AddString(Pin->PinName.ToString());
+		}
+		return Endpoint;
+	};
+
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin)
+			{
+				continue;
+			}
+
+			// Links are written from the output side; an input pin only contributes links whose output
+			// side is outside the set, which would otherwise be missed
+			const bool bOutput = Pin->Direction == EGPD_Output;
+			if (!bOutput && !bIncludeIncomingLinks)
+			{
+				continue;
+			}
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (!LinkedPin || !LinkedPin->GetOwningNode())
+				{
+					continue;
+				}
+
+				const bool bInternal = EndpointIndices.Nodes.Contains(LinkedPin->GetOwningNode());
+				if (bInternal ? !bOutput : !bIncludeBoundaryLinks)
+				{
+					continue;
+				}
+
+				FBlueprintGraphConnectionDescription& Connection = OutDescription.Connections.AddDefaulted_GetRef();
+				Connection.From = DescribeEndpoint(bOutput ? Pin : LinkedPin);
+				Connection.To = DescribeEndpoint(bOutput ? LinkedPin : Pin);
+			}
+		}
+	}
+}
+
+bool FBlueprintGraphSerializer::SerializeGraphToBinary(UEdGraph* Graph, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+
+	FBlueprintGraphDescription Description;
+	if (!DescribeGraph(Graph, Description))
+	{
+		return false;
+	}
+
+	FBlueprintGraphBinaryFormat::Encode(Description, OutBytes);
+	return true;
+}
+
+bool FBlueprintGraphSerializer::DescribeBlueprint(UBlueprint* Blueprint, FBlueprintDescription& OutDescription)
+{
+	OutDescription.Reset();
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	FBlueprintGraphDescription& Content = OutDescription.Content;
+	Content.Version = Content.AddString(FBlueprintGraphJsonSchema::GetBlueprintSchemaVersion());
+	Content.UnrealVersion = Content.AddString(TEXT("5.3.0"));
+	Content.ExportDate = Content.AddString(FDateTime::Now().ToIso8601());
+	OutDescription.BlueprintPath = Content.AddString(Blueprint->GetPathName());
+
+	auto AddGraphs = [&OutDescription](const TArray<TObjectPtr<UEdGraph>>& Graphs, const TCHAR* Kind)
+	{
+		for (UEdGraph* Graph : Graphs)
+		{
+			AppendBlueprintGraph(Graph, Kind, INDEX_NONE, OutDescription);
+		}
+	};
+
+	AddGraphs(Blueprint->UbergraphPages, TEXT("ubergraph"));
+	AddGraphs(Blueprint->FunctionGraphs, TEXT("function"));
+	AddGraphs(Blueprint->MacroGraphs, TEXT("macro"));
+	AddGraphs(Blueprint->DelegateSignatureGraphs, TEXT("delegate"));
+	for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
+	{
+		AddGraphs(Interface.Graphs, TEXT("interface"));
+	}
+
+	Content.FinishBuilding();
+	OutDescription.Graphs.Shrink();
+	return true;
+}
+
+void FBlueprintGraphSerializer::AppendBlueprintGraph(UEdGraph* Graph, const TCHAR* Kind, int32 ParentGraph, FBlueprintDescription& OutDescription)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	FBlueprintGraphDescription& Content = OutDescription.Content;
+	const int32 GraphIndex = OutDescription.Graphs.Num();
+
+	FBlueprintGraphSectionDescription& Section = OutDescription.Graphs.AddDefaulted_GetRef();
+	Section.Name = Content.AddString(Graph->GetName());
+	Section.Kind = Content.AddString(Kind);
+	Section.ParentGraph = ParentGraph;
+	Section.FirstNode = Content.Nodes.Num();
+	Section.FirstConnection = Content.Connections.Num();
+
+	AppendGraphDescription(Graph, Content);
+	Section.NumNodes = Content.Nodes.Num() - Section.FirstNode;
+	Section.NumConnections = Content.Connections.Num() - Section.FirstConnection;
+
+	// Collapsed graphs, composite nodes and the like
+	for (UEdGraph* SubGraph : Graph->SubGraphs)
+	{
+		AppendBlueprintGraph(SubGraph, TEXT("subgraph"), GraphIndex, OutDescription);
+	}
+}
+
+bool FBlueprintGraphSerializer::WriteBlueprintDescriptionJson(const FBlueprintDescription& Description, FString& OutJson, bool bPrettyPrint, FBlueprintHashes* OutHashes)
+{
+	OutJson.Reset();
+
+	FBlueprintHashes Hashes;
+	const bool bWritten = bPrettyPrint
+		? WriteBlueprintDescriptionJsonImpl<TPrettyJsonPrintPolicy<TCHAR>>(Description, OutJson, true, Hashes)
+		: WriteBlueprintDescriptionJsonImpl<TCondensedJsonPrintPolicy<TCHAR>>(Description, OutJson, false, Hashes);
+
+	if (OutHashes)
+	{
+		*OutHashes = MoveTemp(Hashes);
+	}
+	return bWritten;
+}
+
+bool FBlueprintGraphSerializer::SerializeBlueprint(UBlueprint* Blueprint, FString& OutJson, bool bPrettyPrint)
+{
+	OutJson.Reset();
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	// One logger session for the whole Blueprint
+	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_BlueprintExport"));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Serializing Blueprint: %s"), *Blueprint->GetName()));
+
+	FBlueprintDescription Description;
+	const bool bSerialized = DescribeBlueprint(Blueprint, Description) && WriteBlueprintDescriptionJson(Description, OutJson, bPrettyPrint);
+
+	UNREALGRAPH_LOG(Summary, TEXT("Serialized %d graphs, %d nodes, %d connections, %d unique strings"),
+		Description.Graphs.Num(), Description.Content.Nodes.Num(), Description.Content.Connections.Num(), Description.Content.Strings.Num());
+	FUnrealGraphLogger::Shutdown();
+
+	return bSerialized;
+}
+
+bool FBlueprintGraphSerializer::WriteDescriptionJson(const FBlueprintGraphDescription& Description, FString& OutJson, bool bPrettyPrint)
+{
+	OutJson.Reset();
+
+	if (ShouldEncodeInParallel(Description.Nodes.Num()))
+	{
+		return bPrettyPrint
+			? WriteDescriptionJsonParallel<TPrettyJsonPrintPolicy<TCHAR>>(Description, OutJson, true)
+			: WriteDescriptionJsonParallel<TCondensedJsonPrintPolicy<TCHAR>>(Description, OutJson, false);
+	}
+
+	if (bPrettyPrint)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+		return WriteDescription(Description, *Writer);
+	}
+
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+	return WriteDescription(Description, *Writer);
+}
@@ -17,8 +17,9 @@ FUnrealGraphCommands::FUnrealGraphCommands()
 
 void FUnrealGraphCommands::RegisterCommands()
 {
-	UI_COMMAND(CopyAsJSON, "Copy Graph as JSON", "Copy the selected Blueprint graph as JSON", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::C));
+	UI_COMMAND(CopyAsJSON, "Copy Graph as JSON", "Copy the selected nodes (or the whole graph when nothing is selected) as JSON", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::C));
 	UI_COMMAND(PasteFromJSON, "Paste Graph from JSON", "Paste a Blueprint graph from JSON", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::V));
+	UI_COMMAND(CopyBlueprintAsJSON, "Copy Blueprint as JSON", "Copy every graph of the Blueprint (event graphs, functions, macros, delegates, collapsed graphs) as one JSON document", EUserInterfaceActionType::Button, FInputChord());
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealGraphExportCache.h"
+#include "BlueprintGraphJsonSchema.h"
+#include "BlueprintGraphSerializer.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "DerivedDataCacheInterface.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/Blake3.h"
+#include "IO/IoHash.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace UnrealGraphExportCache
+{
+	/** Leading bytes of a cache entry ("UGEC") */
+	static constexpr uint32 EntryMagic = 0x43454755;
+
+	/** Generation read from the generation file (written by Purge), empty until first use */
+	static FString Generation;
+
+	/** Module binary stamps by module name (see GetModuleStamp) */
+	static TMap<FName, FString> ModuleStamps;
+
+	/** Module holding the serializer; its binary is part of every key */
+	static const FName SerializerModuleName(TEXT("UnrealGraph"));
+
+	static FAutoConsoleCommand PurgeCommand(
+		TEXT("UnrealGraph.ExportCache.Purge"),
+		TEXT("Delete the local UnrealGraph export cache and start a new cache generation, so no cached export is reused."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FUnrealGraphExportCache::Purge();
+		}));
+
+	void HashString(FBlake3& Hasher, FStringView Text)
+	{
+		const FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+		Hasher.Update(Utf8.Get(), Utf8.Length());
+
+		// Separator, so adjacent strings cannot run into each other
+		const uint8 Zero = 0;
+		Hasher.Update(&Zero, 1);
+	}
+
+	void HashPackage(FBlake3& Hasher, FName PackageName, const FIoHash& SavedHash)
+	{
+		HashString(Hasher, PackageName.ToString());
+		Hasher.Update(SavedHash.GetBytes(), sizeof(FIoHash::ByteArray));
+	}
+}
+
+FUnrealGraphExportCache::FUnrealGraphExportCache(bool bAllowDDC)
+	: bUseDDC(bAllowDDC && GetDerivedDataCache() != nullptr)
+{
+}
+
+bool FUnrealGraphExportCache::BuildKey(const IAssetRegistry& AssetRegistry, FName PackageName, bool bPrettyPrint, FString& OutKey)
+{
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return false;
+	}
+
+	FBlake3 Hasher;
+	UnrealGraphExportCache::HashPackage(Hasher, PackageName, PackageData->GetPackageSavedHash());
+
+	// Exported titles, pin types and member references also come from the packages the Blueprint
+	// depends on (parent classes, structs, function libraries); a change there changes the key too.
+	// Script packages have no saved hash: the binary of their code module stands in for it.
+	TArray<FAssetIdentifier> Dependencies;
+	AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	Dependencies.Sort([](const FAssetIdentifier& A, const FAssetIdentifier& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+	for (const FAssetIdentifier& Dependency : Dependencies)
+	{
+		const TOptional<FAssetPackageData> DependencyData = AssetRegistry.GetAssetPackageDataCopy(Dependency.PackageName);
+		UnrealGraphExportCache::HashPackage(Hasher, Dependency.PackageName, DependencyData.IsSet() ? DependencyData->GetPackageSavedHash() : FIoHash::Zero);
+
+		FNameBuilder DependencyName(Dependency.PackageName);
+		const FStringView ScriptPrefix = TEXTVIEW("/Script/");
+		if (DependencyName.ToView().StartsWith(ScriptPrefix))
+		{
+			UnrealGraphExportCache::HashString(Hasher, GetModuleStamp(FName(DependencyName.ToView().RightChop(ScriptPrefix.Len()))));
+		}
+	}
+
+	// The serializer itself: a rebuilt plugin may export the same Blueprint differently
+	UnrealGraphExportCache::HashString(Hasher, GetModuleStamp(UnrealGraphExportCache::SerializerModuleName));
+
+	UnrealGraphExportCache::HashString(Hasher, FBlueprintGraphJsonSchema::GetCurrentSchemaVersion());
+	UnrealGraphExportCache::HashString(Hasher, FBlueprintGraphJsonSchema::GetBlueprintSchemaVersion());
+	UnrealGraphExportCache::HashString(Hasher, FString::Printf(TEXT("%d.%d"), FBlueprintGraphSerializer::OutputVersion, CacheVersion));
+	UnrealGraphExportCache::HashString(Hasher, FEngineVersion::Current().ToString());
+	UnrealGraphExportCache::HashString(Hasher, FApp::GetBuildVersion());
+	UnrealGraphExportCache::HashString(Hasher, bPrettyPrint ? TEXT("pretty") : TEXT("condensed"));
+	UnrealGraphExportCache::HashString(Hasher, GetGeneration());
+
+	OutKey = LexToString(FIoHash(Hasher.Finalize()));
+	return true;
+}
+
+bool FUnrealGraphExportCache::Get(const FString& Key, FCachedBlueprintExport& OutExport)
+{
+	TArray<uint8> Bytes;
+	const bool bFound = bUseDDC
+		? GetDerivedDataCacheRef().GetSynchronous(*GetDDCKey(Key), Bytes, Key)
+		: FFileHelper::LoadFileToArray(Bytes, *GetLocalEntryPath(Key), FILEREAD_Silent);
+
+	bool bValid = false;
+	if (bFound)
+	{
+		FMemoryReader Reader(Bytes);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Reader << Magic << Version;
+		if (Magic == UnrealGraphExportCache::EntryMagic && Version == CacheVersion)
+		{
+			Reader << OutExport.NumGraphs << OutExport.NumNodes << OutExport.ContentHash << OutExport.Json;
+			bValid = !Reader.IsError();
+		}
+	}
+
+	if (bValid)
+	{
+		RestampExportDate(OutExport.Json);
+		++NumHits;
+	}
+	else
+	{
+		if (bFound)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Ignoring invalid export cache entry %s"), *Key);
+		}
+		++NumMisses;
+	}
+	return bValid;
+}
+
+void FUnrealGraphExportCache::Put(const FString& Key, const FCachedBlueprintExport& Export)
+{
+	TArray<uint8> Bytes;
+	Bytes.Reserve(Export.Json.Num() + 32);
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = UnrealGraphExportCache::EntryMagic;
+	int32 Version = CacheVersion;
+	int32 NumGraphs = Export.NumGraphs;
+	int32 NumNodes = Export.NumNodes;
+	uint64 ContentHash = Export.ContentHash;
+	Writer << Magic << Version << NumGraphs << NumNodes << ContentHash;
+	Writer << const_cast<TArray<uint8>&>(Export.Json);
+
+	if (bUseDDC)
+	{
+		GetDerivedDataCacheRef().Put(*GetDDCKey(Key), Bytes, Key);
+		return;
+	}
+
+	// Written under a unique name and moved into place, so shards exporting in parallel never read a partial entry
+	const FString EntryPath = GetLocalEntryPath(Key);
+	const FString TempPath = EntryPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*EntryPath, *TempPath, /*bReplace*/ true))
+	{
+		IFileManager::Get().Delete(*TempPath, /*RequireExists*/ false, /*EvenReadOnly*/ false, /*Quiet*/ true);
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Could not write export cache entry %s"), *EntryPath);
+	}
+}
+
+bool FUnrealGraphExportCache::Purge()
+{
+	const FString CacheDirectory = GetCacheDirectory();
+	const bool bDeleted = !IFileManager::Get().DirectoryExists(*CacheDirectory)
+		|| IFileManager::Get().DeleteDirectory(*CacheDirectory, /*RequireExists*/ false, /*Tree*/ true);
+
+	UnrealGraphExportCache::Generation = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	const bool bSaved = FFileHelper::SaveStringToFile(UnrealGraphExportCache::Generation, *FPaths::Combine(CacheDirectory, TEXT("Generation.txt")));
+
+	if (bDeleted && bSaved)
+	{
+		UE_LOG(LogTemp, Display, TEXT("UnrealGraph: Purged the export cache (new generation %s)"), *UnrealGraphExportCache::Generation);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Could not purge the export cache in %s"), *CacheDirectory);
+	}
+	return bDeleted && bSaved;
+}
+
+FString FUnrealGraphExportCache::GetCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealGraph"), TEXT("ExportCache"));
+}
+
+FString FUnrealGraphExportCache::GetGeneration()
+{
+	if (UnrealGraphExportCache::Generation.IsEmpty())
+	{
+		const FString GenerationFile = FPaths::Combine(GetCacheDirectory(), TEXT("Generation.txt"));
+		FFileHelper::LoadFileToString(UnrealGraphExportCache::Generation, *GenerationFile);
+		UnrealGraphExportCache::Generation.TrimStartAndEndInline();
+
+		// Never purged: a fixed generation, so machines sharing a DDC share entries
+		if (UnrealGraphExportCache::Generation.IsEmpty())
+		{
+			UnrealGraphExportCache::Generation = TEXT("0");
+		}
+	}
+	return UnrealGraphExportCache::Generation;
+}
+
+FString FUnrealGraphExportCache::GetLocalEntryPath(const FString& Key)
+{
+	// Two-character fan-out keeps directories small on large projects
+	return FPaths::Combine(GetCacheDirectory(), Key.Left(2), Key + TEXT(".bin"));
+}
+
+FString FUnrealGraphExportCache::GetDDCKey(const FString& Key)
+{
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("UNREALGRAPH_EXPORT"), *FString::Printf(TEXT("%d"), CacheVersion), *Key);
+}
+
+const FString& FUnrealGraphExportCache::GetModuleStamp(FName ModuleName)
+{
+	if (const FString* Existing = UnrealGraphExportCache::ModuleStamps.Find(ModuleName))
+	{
+		return *Existing;
+	}
+
+	FString Stamp;
+	const FString ModuleFile = FModuleManager::Get().GetModuleFilename(ModuleName);
+	if (!ModuleFile.IsEmpty())
+	{
+		const int64 Size = IFileManager::Get().FileSize(*ModuleFile);
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*ModuleFile);
+		Stamp = FString::Printf(TEXT("%lld:%lld"), Size, TimeStamp.GetTicks());
+	}
+	return UnrealGraphExportCache::ModuleStamps.Add(ModuleName, MoveTemp(Stamp));
+}
+
+void FUnrealGraphExportCache::RestampExportDate(TArray<uint8>& Json)
+{
+	// The date is the first "exportDate" in the document (metadata comes before the graphs) and
+	// ISO 8601 dates from FDateTime all have the same length, so it is replaced in place
+	static const char Key[] = "\"exportDate\"";
+	const int32 KeyLen = UE_ARRAY_COUNT(Key) - 1;
+	const FTCHARToUTF8 Now(*FDateTime::Now().ToIso8601());
+
+	for (int32 Index = 0; Index + KeyLen <= Json.Num(); ++Index)
+	{
+		if (FMemory::Memcmp(Json.GetData() + Index, Key, KeyLen) != 0)
+		{
+			continue;
+		}
+
+		// Skip the separator (": " or ":") up to the opening quote of the value
+		int32 ValueStart = Index + KeyLen;
+		while (ValueStart < Json.Num() && Json[ValueStart] != '"')
+		{
+			++ValueStart;
+		}
+		++ValueStart;
+
+		int32 ValueEnd = ValueStart;
+		while (ValueEnd < Json.Num() && Json[ValueEnd] != '"')
+		{
+			++ValueEnd;
+		}
+
+		if (ValueEnd < Json.Num() && ValueEnd - ValueStart == Now.Length())
+		{
+			FMemory::Memcpy(Json.GetData() + ValueStart, Now.Get(), Now.Length());
+		}
+		return;
+	}
+}
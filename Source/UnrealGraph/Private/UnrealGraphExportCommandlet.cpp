@@ -0,0 +1,484 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealGraphExportCommandlet.h"
+#include "UnrealGraphExportCache.h"
+#include "BlueprintGraphSerializer.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphContentHash.h"
+#include "UnrealGraphLogger.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Package.h"
+#include "HAL/PlatformMemory.h"
+
+namespace
+{
+	/**
+	 * How the export cache served an asset, written to the report as "cache"
+	 */
+	enum class EAssetCacheStatus : uint8
+	{
+		/** Caching disabled (-NoCache) */
+		Off,
+		Hit,
+		Miss,
+
+		/** No content key (the package has no saved hash), so the asset was neither looked up nor stored */
+		Uncacheable
+	};
+
+	const TCHAR* LexToString(EAssetCacheStatus Status)
+	{
+		switch (Status)
+		{
+		case EAssetCacheStatus::Hit:			return TEXT("hit");
+		case EAssetCacheStatus::Miss:			return TEXT("miss");
+		case EAssetCacheStatus::Uncacheable:	return TEXT("uncacheable");
+		default:								return TEXT("off");
+		}
+	}
+
+	/**
+	 * Outcome of exporting one asset, as written to the report
+	 */
+	struct FAssetExportResult
+	{
+		FString PackageName;
+		FString OutputFile;
+		FString Error;
+		bool bSucceeded = false;
+		EAssetCacheStatus CacheStatus = EAssetCacheStatus::Off;
+		int32 NumGraphs = 0;
+		int32 NumNodes = 0;
+		uint64 ContentHash = 0;
+		int64 Bytes = 0;
+		double CacheSeconds = 0.0;
+		double LoadSeconds = 0.0;
+		double SerializeSeconds = 0.0;
+		double WriteSeconds = 0.0;
+
+		double GetTotalSeconds() const
+		{
+			return CacheSeconds + LoadSeconds + SerializeSeconds + WriteSeconds;
+		}
+	};
+
+	/**
+	 * Read a list parameter such as -Paths=/Game/A+/Game/B (entries separated by '+' or ',')
+	 */
+	TArray<FString> ParseListParam(const FString& Params, const TCHAR* Key)
+	{
+		TArray<FString> Entries;
+		FString Value;
+		if (FParse::Value(*Params, Key, Value, /*bShouldStopOnSeparator*/ false))
+		{
+			Value.ReplaceInline(TEXT(","), TEXT("+"));
+			Value.ParseIntoArray(Entries, TEXT("+"), /*bCullEmpty*/ true);
+			for (FString& Entry : Entries)
+			{
+				Entry.TrimStartAndEndInline();
+			}
+		}
+		return Entries;
+	}
+
+	/**
+	 * Shard of a package. Hashes the lower-case package name, so the assignment does not depend on
+	 * enumeration order or on which other assets exist.
+	 */
+	int32 GetShardForPackage(const FName PackageName, int32 ShardCount)
+	{
+		return static_cast<int32>(FCrc::StrCrc32(*PackageName.ToString().ToLower()) % static_cast<uint32>(ShardCount));
+	}
+
+	/**
+	 * Write an exported document to <OutputDir>/<package path>.json
+	 */
+	bool WriteExportFile(const FString& OutputDir, FAssetExportResult& Result, const TArray<uint8>& Json)
+	{
+		// /Game/Folder/BP_Asset -> <OutputDir>/Game/Folder/BP_Asset.json
+		const double WriteStart = FPlatformTime::Seconds();
+		Result.OutputFile = FPaths::Combine(OutputDir, Result.PackageName.RightChop(1) + TEXT(".json"));
+		if (!FFileHelper::SaveArrayToFile(Json, *Result.OutputFile))
+		{
+			Result.Error = TEXT("Failed to write output file");
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Failed to write %s"), *Result.OutputFile);
+			return false;
+		}
+		Result.WriteSeconds = FPlatformTime::Seconds() - WriteStart;
+		Result.Bytes = Json.Num();
+		return true;
+	}
+
+	bool WriteReport(const FString& ReportFile, const TArray<FAssetExportResult>& Results, int32 ShardIndex, int32 ShardCount, const TCHAR* CacheMode, const FUnrealGraphExportCache& Cache, double TotalSeconds)
+	{
+		int32 NumSucceeded = 0;
+		int32 NumUncacheable = 0;
+		int64 TotalBytes = 0;
+		for (const FAssetExportResult& Result : Results)
+		{
+			NumSucceeded += Result.bSucceeded ? 1 : 0;
+			NumUncacheable += Result.CacheStatus == EAssetCacheStatus::Uncacheable ? 1 : 0;
+			TotalBytes += Result.Bytes;
+		}
+
+		FString ReportJson;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&ReportJson);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("shardIndex"), ShardIndex);
+		Writer->WriteValue(TEXT("shardCount"), ShardCount);
+		Writer->WriteValue(TEXT("assets"), Results.Num());
+		Writer->WriteValue(TEXT("succeeded"), NumSucceeded);
+		Writer->WriteValue(TEXT("failed"), Results.Num() - NumSucceeded);
+		Writer->WriteValue(TEXT("totalBytes"), static_cast<double>(TotalBytes));
+		Writer->WriteValue(TEXT("totalSeconds"), TotalSeconds);
+
+		Writer->WriteObjectStart(TEXT("cache"));
+		Writer->WriteValue(TEXT("mode"), CacheMode);
+		Writer->WriteValue(TEXT("hits"), Cache.GetNumHits());
+		Writer->WriteValue(TEXT("misses"), Cache.GetNumMisses());
+		Writer->WriteValue(TEXT("uncacheable"), NumUncacheable);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteArrayStart(TEXT("results"));
+		for (const FAssetExportResult& Result : Results)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("package"), Result.PackageName);
+			Writer->WriteValue(TEXT("status"), Result.bSucceeded ? TEXT("ok") : TEXT("failed"));
+			if (!Result.Error.IsEmpty())
+			{
+				Writer->WriteValue(TEXT("error"), Result.Error);
+			}
+			if (Result.bSucceeded)
+			{
+				Writer->WriteValue(TEXT("file"), Result.OutputFile);
+				Writer->WriteValue(TEXT("graphs"), Result.NumGraphs);
+				Writer->WriteValue(TEXT("nodes"), Result.NumNodes);
+				Writer->WriteValue(TEXT("contentHash"), FBlueprintGraphContentHash::ToString(Result.ContentHash));
+				Writer->WriteValue(TEXT("bytes"), static_cast<double>(Result.Bytes));
+			}
+			Writer->WriteValue(TEXT("cache"), LexToString(Result.CacheStatus));
+			Writer->WriteValue(TEXT("cacheMs"), Result.CacheSeconds * 1000.0);
+			Writer->WriteValue(TEXT("loadMs"), Result.LoadSeconds * 1000.0);
+			Writer->WriteValue(TEXT("serializeMs"), Result.SerializeSeconds * 1000.0);
+			Writer->WriteValue(TEXT("writeMs"), Result.WriteSeconds * 1000.0);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return FFileHelper::SaveStringToFile(ReportJson, *ReportFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
+
+UUnrealGraphExportCommandlet::UUnrealGraphExportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UUnrealGraphExportCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Options
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("OutputDir="), OutputDir))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: -OutputDir=<dir> is required"));
+		return 1;
+	}
+	OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+
+	TArray<FString> PackagePaths = ParseListParam(Params, TEXT("Paths="));
+	if (PackagePaths.Num() == 0)
+	{
+		PackagePaths.Add(TEXT("/Game"));
+	}
+
+	TArray<FString> ClassPaths = ParseListParam(Params, TEXT("Classes="));
+	if (ClassPaths.Num() == 0)
+	{
+		ClassPaths.Add(UBlueprint::StaticClass()->GetPathName());
+	}
+
+	int32 ShardIndex = 0;
+	int32 ShardCount = 1;
+	FParse::Value(*Params, TEXT("ShardIndex="), ShardIndex);
+	FParse::Value(*Params, TEXT("ShardCount="), ShardCount);
+	if (ShardCount < 1 || ShardIndex < 0 || ShardIndex >= ShardCount)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Invalid shard %d of %d"), ShardIndex, ShardCount);
+		return 1;
+	}
+
+	FString ReportFile = FPaths::Combine(OutputDir, FString::Printf(TEXT("UnrealGraphExport_Shard%d.json"), ShardIndex));
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+
+	const bool bPrettyPrint = !FParse::Param(*Params, TEXT("Condensed"));
+
+	int32 MaxInFlight = 16;
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	MaxInFlight = FMath::Max(MaxInFlight, 1);
+
+	// Default ceiling: half of physical memory
+	uint64 MemoryCeilingMB = FPlatformMemory::GetConstants().TotalPhysical / (2 * 1024 * 1024);
+	FParse::Value(*Params, TEXT("MemoryCeilingMB="), MemoryCeilingMB);
+	const uint64 MemoryCeilingBytes = MemoryCeilingMB * 1024 * 1024;
+
+	const bool bUseCache = !FParse::Param(*Params, TEXT("NoCache"));
+	if (FParse::Param(*Params, TEXT("PurgeCache")))
+	{
+		FUnrealGraphExportCache::Purge();
+	}
+	FUnrealGraphExportCache Cache(/*bAllowDDC*/ !FParse::Param(*Params, TEXT("LocalCache")));
+	const TCHAR* CacheMode = !bUseCache ? TEXT("off") : Cache.IsUsingDDC() ? TEXT("ddc") : TEXT("local");
+
+	// Enumerate assets
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(/*bSynchronousSearch*/ true);
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+	for (const FString& ClassPath : ClassPaths)
+	{
+		const FTopLevelAssetPath ClassAssetPath(ClassPath);
+		if (!ClassAssetPath.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Invalid class path '%s' (expected e.g. /Script/Engine.Blueprint)"), *ClassPath);
+			return 1;
+		}
+		Filter.ClassPaths.Add(ClassAssetPath);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	const int32 NumFound = Assets.Num();
+
+	Assets.RemoveAll([ShardIndex, ShardCount](const FAssetData& Asset)
+	{
+		return GetShardForPackage(Asset.PackageName, ShardCount) != ShardIndex;
+	});
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport: %d assets match, exporting %d in shard %d of %d to %s"),
+		NumFound, Assets.Num(), ShardIndex, ShardCount, *OutputDir);
+
+	// One log session for the whole run
+	FUnrealGraphLogger::Initialize(FString::Printf(TEXT("UnrealGraph_Export_Shard%d"), ShardIndex));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Exporting %d assets (shard %d of %d)"), Assets.Num(), ShardIndex, ShardCount));
+
+	TArray<FAssetExportResult> Results;
+	Results.Reserve(Assets.Num());
+
+	// Cache hits are written straight away, without loading their package; only misses enter the load pipeline.
+	// CacheKeys stays parallel to Assets (empty where the asset cannot be cached).
+	TArray<FString> CacheKeys;
+	if (bUseCache)
+	{
+		TArray<FAssetData> Misses;
+		int32 NumUncacheable = 0;
+		for (const FAssetData& Asset : Assets)
+		{
+			const double CacheStart = FPlatformTime::Seconds();
+			FString Key;
+			FCachedBlueprintExport Cached;
+			// Assets without a key are not looked up, so the cache counts neither a hit nor a miss for them
+			const bool bHasKey = FUnrealGraphExportCache::BuildKey(AssetRegistry, Asset.PackageName, bPrettyPrint, Key);
+			NumUncacheable += bHasKey ? 0 : 1;
+			if (!bHasKey || !Cache.Get(Key, Cached))
+			{
+				Misses.Add(Asset);
+				CacheKeys.Add(MoveTemp(Key));
+				continue;
+			}
+
+			FAssetExportResult& Result = Results.AddDefaulted_GetRef();
+			Result.PackageName = Asset.PackageName.ToString();
+			Result.CacheStatus = EAssetCacheStatus::Hit;
+			Result.NumGraphs = Cached.NumGraphs;
+			Result.NumNodes = Cached.NumNodes;
+			Result.ContentHash = Cached.ContentHash;
+			Result.CacheSeconds = FPlatformTime::Seconds() - CacheStart;
+			Result.bSucceeded = WriteExportFile(OutputDir, Result, Cached.Json);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport: %d cache hits, %d assets to export (%d uncacheable, %s cache)"),
+			Assets.Num() - Misses.Num(), Misses.Num(), NumUncacheable, CacheMode);
+		UNREALGRAPH_LOG(Summary, TEXT("%d cache hits, %d assets to export (%d uncacheable)"), Assets.Num() - Misses.Num(), Misses.Num(), NumUncacheable);
+		Assets = MoveTemp(Misses);
+	}
+
+	// Loads are issued ahead of the asset being exported, up to MaxInFlight, so packages stream in while
+	// earlier ones are serialized. Completion is recorded per asset; assets are exported in order.
+	TArray<int32> LoadRequestIds;
+	LoadRequestIds.Init(INDEX_NONE, Assets.Num());
+	TArray<EAsyncLoadingResult::Type> LoadResults;
+	LoadResults.Init(EAsyncLoadingResult::Failed, Assets.Num());
+
+	auto IssueLoad = [&Assets, &LoadRequestIds, &LoadResults](int32 AssetIndex)
+	{
+		EAsyncLoadingResult::Type* LoadResult = &LoadResults[AssetIndex];
+		LoadRequestIds[AssetIndex] = LoadPackageAsync(Assets[AssetIndex].PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateLambda([LoadResult](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				*LoadResult = Result;
+			}));
+	};
+
+	int32 NextToLoad = 0;
+	int32 NumCollections = 0;
+	bool bDraining = false;
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		// Over the ceiling: stop issuing loads, export what is in flight, then collect garbage before refilling
+		if (!bDraining && FPlatformMemory::GetStats().UsedPhysical > MemoryCeilingBytes)
+		{
+			bDraining = true;
+		}
+		if (bDraining && NextToLoad == AssetIndex)
+		{
+			const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+			++NumCollections;
+			bDraining = false;
+
+			UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport: %d/%d assets processed, garbage collected (%llu -> %llu MB)"),
+				AssetIndex, Assets.Num(), UsedBefore / (1024 * 1024), UsedAfter / (1024 * 1024));
+			if (UsedAfter > MemoryCeilingBytes)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UnrealGraphExport: Memory use is still above the ceiling of %llu MB after garbage collection"), MemoryCeilingBytes / (1024 * 1024));
+			}
+		}
+
+		while (!bDraining && NextToLoad < Assets.Num() && NextToLoad - AssetIndex < MaxInFlight)
+		{
+			IssueLoad(NextToLoad++);
+		}
+
+		const FAssetData& Asset = Assets[AssetIndex];
+		FAssetExportResult& Result = Results.AddDefaulted_GetRef();
+		Result.PackageName = Asset.PackageName.ToString();
+		if (bUseCache)
+		{
+			Result.CacheStatus = CacheKeys[AssetIndex].IsEmpty() ? EAssetCacheStatus::Uncacheable : EAssetCacheStatus::Miss;
+		}
+
+		// Time spent waiting for this package; the loads behind it keep progressing meanwhile
+		double PhaseStart = FPlatformTime::Seconds();
+		FlushAsyncLoading(LoadRequestIds[AssetIndex]);
+		Result.LoadSeconds = FPlatformTime::Seconds() - PhaseStart;
+
+		UBlueprint* Blueprint = LoadResults[AssetIndex] == EAsyncLoadingResult::Succeeded ? Cast<UBlueprint>(Asset.FastGetAsset(/*bLoad*/ false)) : nullptr;
+		if (!Blueprint)
+		{
+			Result.Error = TEXT("Failed to load Blueprint");
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Failed to load %s"), *Result.PackageName);
+			continue;
+		}
+
+		PhaseStart = FPlatformTime::Seconds();
+		FBlueprintDescription Description;
+		FString Json;
+		FBlueprintHashes Hashes;
+		const bool bSerialized = FBlueprintGraphSerializer::DescribeBlueprint(Blueprint, Description)
+			&& FBlueprintGraphSerializer::WriteBlueprintDescriptionJson(Description, Json, bPrettyPrint, &Hashes);
+		Result.SerializeSeconds = FPlatformTime::Seconds() - PhaseStart;
+		if (!bSerialized)
+		{
+			Result.Error = TEXT("Failed to serialize");
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Failed to serialize %s"), *Result.PackageName);
+			continue;
+		}
+		Result.NumGraphs = Description.Graphs.Num();
+		Result.NumNodes = Description.Content.Nodes.Num();
+		Result.ContentHash = Hashes.ContentRoot;
+
+		FCachedBlueprintExport Export;
+		Export.NumGraphs = Result.NumGraphs;
+		Export.NumNodes = Result.NumNodes;
+		Export.ContentHash = Result.ContentHash;
+		const FTCHARToUTF8 JsonUtf8(*Json, Json.Len());
+		Export.Json.Append(reinterpret_cast<const uint8*>(JsonUtf8.Get()), JsonUtf8.Length());
+
+		if (!WriteExportFile(OutputDir, Result, Export.Json))
+		{
+			continue;
+		}
+		Result.bSucceeded = true;
+
+		if (bUseCache && !CacheKeys[AssetIndex].IsEmpty())
+		{
+			Cache.Put(CacheKeys[AssetIndex], Export);
+		}
+
+		UNREALGRAPH_LOG(Summary, TEXT("%s: %d graphs, %d nodes, %lld bytes, %.1f ms"),
+			*Result.PackageName, Result.NumGraphs, Result.NumNodes, Result.Bytes, Result.GetTotalSeconds() * 1000.0);
+	}
+
+	FUnrealGraphLogger::Shutdown();
+
+	// Summary
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	const int32 NumFailed = Results.FilterByPredicate([](const FAssetExportResult& Result) { return !Result.bSucceeded; }).Num();
+
+	TArray<const FAssetExportResult*> Slowest;
+	for (const FAssetExportResult& Result : Results)
+	{
+		Slowest.Add(&Result);
+	}
+	Slowest.Sort([](const FAssetExportResult& A, const FAssetExportResult& B)
+	{
+		return A.GetTotalSeconds() > B.GetTotalSeconds();
+	});
+	if (Slowest.Num() > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport: Slowest assets:"));
+	}
+	for (int32 Index = 0; Index < FMath::Min(Slowest.Num(), 10); ++Index)
+	{
+		const FAssetExportResult& Result = *Slowest[Index];
+		UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport:   %8.1f ms (load %.1f, serialize %.1f, write %.1f)  %s"),
+			Result.GetTotalSeconds() * 1000.0, Result.LoadSeconds * 1000.0, Result.SerializeSeconds * 1000.0, Result.WriteSeconds * 1000.0, *Result.PackageName);
+	}
+
+	Results.Sort([](const FAssetExportResult& A, const FAssetExportResult& B)
+	{
+		return A.PackageName < B.PackageName;
+	});
+	if (!WriteReport(ReportFile, Results, ShardIndex, ShardCount, CacheMode, Cache, TotalSeconds))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphExport: Failed to write report %s"), *ReportFile);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealGraphExport: Exported %d/%d assets in %.1f s (%d failed, %d cache hits, %d cache misses, %d garbage collections), report: %s"),
+		Results.Num() - NumFailed, Results.Num(), TotalSeconds, NumFailed, Cache.GetNumHits(), Cache.GetNumMisses(), NumCollections, *ReportFile);
+
+	return NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,487 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealGraphImportCommandlet.h"
+#include "BlueprintGraphDeserializer.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphBinaryFormat.h"
+#include "UnrealGraphLogger.h"
+#include "Editor.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/**
+	 * One manifest entry and the outcome of applying it, as written to the report
+	 */
+	struct FFileImportResult
+	{
+		FString File;
+		FString AssetPath;
+		FString GraphName;
+		FString Error;
+		bool bSucceeded = false;
+		FGraphDeserializeStats Stats;
+		double ApplySeconds = 0.0;
+
+		/** Applied, but some nodes or connections could not be created */
+		bool IsPartial() const
+		{
+			return bSucceeded && (Stats.NodesFailed > 0 || Stats.ConnectionsFailed > 0);
+		}
+	};
+
+	/**
+	 * One Blueprint touched by the manifest: its entries, and how loading, compiling and saving went
+	 */
+	struct FBlueprintImportResult
+	{
+		FString AssetPath;
+		TArray<int32> Files;
+		FString Error;
+		bool bSucceeded = false;
+		bool bCompileErrors = false;
+		double LoadSeconds = 0.0;
+		double CompileSeconds = 0.0;
+		double SaveSeconds = 0.0;
+	};
+
+	/**
+	 * Read the manifest entries. Every entry needs "file" and "asset"; "graph" is optional.
+	 */
+	bool ReadManifest(const FString& ManifestFile, TArray<FFileImportResult>& OutEntries, FString& OutError)
+	{
+		FString ManifestText;
+		if (!FFileHelper::LoadFileToString(ManifestText, *ManifestFile))
+		{
+			OutError = FString::Printf(TEXT("Could not read manifest %s"), *ManifestFile);
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> Manifest;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ManifestText);
+		if (!FJsonSerializer::Deserialize(Reader, Manifest) || !Manifest.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Manifest is not valid JSON: %s"), *Reader->GetErrorMessage());
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+		if (!Manifest->TryGetArrayField(TEXT("entries"), Entries))
+		{
+			OutError = TEXT("Manifest has no \"entries\" array");
+			return false;
+		}
+
+		const FString ManifestDir = FPaths::GetPath(FPaths::ConvertRelativePathToFull(ManifestFile));
+		for (int32 Index = 0; Index < Entries->Num(); ++Index)
+		{
+			const TSharedPtr<FJsonObject>* Entry = nullptr;
+			FFileImportResult Result;
+			if (!(*Entries)[Index]->TryGetObject(Entry)
+				|| !(*Entry)->TryGetStringField(TEXT("file"), Result.File)
+				|| !(*Entry)->TryGetStringField(TEXT("asset"), Result.AssetPath))
+			{
+				OutError = FString::Printf(TEXT("Manifest entry %d needs \"file\" and \"asset\""), Index);
+				return false;
+			}
+			(*Entry)->TryGetStringField(TEXT("graph"), Result.GraphName);
+
+			if (FPaths::IsRelative(Result.File))
+			{
+				Result.File = FPaths::Combine(ManifestDir, Result.File);
+			}
+			OutEntries.Add(MoveTemp(Result));
+		}
+		return true;
+	}
+
+	/**
+	 * Load a Blueprint by package name (/Game/BP/BP_Door) or object path (/Game/BP/BP_Door.BP_Door)
+	 */
+	UBlueprint* LoadBlueprint(const FString& AssetPath)
+	{
+		FString ObjectPath = AssetPath;
+		if (!ObjectPath.Contains(TEXT(".")))
+		{
+			ObjectPath += TEXT(".") + FPackageName::GetShortName(AssetPath);
+		}
+		return LoadObject<UBlueprint>(nullptr, *ObjectPath);
+	}
+
+	/**
+	 * Find a graph of a Blueprint by name (FName comparison, case-insensitive); an empty name selects the first event graph
+	 */
+	UEdGraph* FindTargetGraph(UBlueprint* Blueprint, const FString& GraphName)
+	{
+		if (GraphName.IsEmpty())
+		{
+			return Blueprint->UbergraphPages.Num() > 0 ? Blueprint->UbergraphPages[0].Get() : nullptr;
+		}
+
+		const FName Name(*GraphName, FNAME_Find);
+		if (Name.IsNone())
+		{
+			return nullptr;
+		}
+
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+		for (UEdGraph* Graph : Graphs)
+		{
+			if (Graph && Graph->GetFName() == Name)
+			{
+				return Graph;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Read a graph file, JSON or binary (detected by its magic)
+	 */
+	bool ReadGraphFile(const FString& File, FBlueprintGraphDescription& OutDescription, FString& OutError)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *File))
+		{
+			OutError = TEXT("Could not read file");
+			return false;
+		}
+
+		if (FBlueprintGraphBinaryFormat::IsBinaryGraph(Bytes))
+		{
+			return FBlueprintGraphBinaryFormat::Decode(Bytes, OutDescription, OutError);
+		}
+
+		FString JsonText;
+		FFileHelper::BufferToString(JsonText, Bytes.GetData(), Bytes.Num());
+		return FBlueprintGraphJsonReader::ReadGraph(JsonText, OutDescription, OutError);
+	}
+
+	bool SavePackage(UPackage* Package)
+	{
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		return UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs);
+	}
+
+	bool WriteReport(const FString& ReportFile, const FString& ManifestFile, const TArray<FFileImportResult>& Files, const TArray<FBlueprintImportResult>& Blueprints, double TotalSeconds)
+	{
+		int32 NumSucceeded = 0;
+		int32 NumPartial = 0;
+		FGraphDeserializeStats Totals;
+		for (const FFileImportResult& Result : Files)
+		{
+			NumSucceeded += Result.bSucceeded ? 1 : 0;
+			NumPartial += Result.IsPartial() ? 1 : 0;
+			Totals.NodesCreated += Result.Stats.NodesCreated;
+			Totals.NodesFailed += Result.Stats.NodesFailed;
+			Totals.ConnectionsCreated += Result.Stats.ConnectionsCreated;
+			Totals.ConnectionsFailed += Result.Stats.ConnectionsFailed;
+		}
+		const int32 NumBlueprintsSucceeded = Blueprints.FilterByPredicate([](const FBlueprintImportResult& Result) { return Result.bSucceeded; }).Num();
+
+		FString ReportJson;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&ReportJson);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("manifest"), ManifestFile);
+		Writer->WriteValue(TEXT("files"), Files.Num());
+		Writer->WriteValue(TEXT("succeeded"), NumSucceeded);
+		Writer->WriteValue(TEXT("partial"), NumPartial);
+		Writer->WriteValue(TEXT("failed"), Files.Num() - NumSucceeded);
+		Writer->WriteValue(TEXT("nodesCreated"), Totals.NodesCreated);
+		Writer->WriteValue(TEXT("nodesFailed"), Totals.NodesFailed);
+		Writer->WriteValue(TEXT("connectionsCreated"), Totals.ConnectionsCreated);
+		Writer->WriteValue(TEXT("connectionsFailed"), Totals.ConnectionsFailed);
+		Writer->WriteValue(TEXT("blueprints"), Blueprints.Num());
+		Writer->WriteValue(TEXT("blueprintsFailed"), Blueprints.Num() - NumBlueprintsSucceeded);
+		Writer->WriteValue(TEXT("totalSeconds"), TotalSeconds);
+
+		Writer->WriteArrayStart(TEXT("results"));
+		for (const FFileImportResult& Result : Files)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("file"), Result.File);
+			Writer->WriteValue(TEXT("asset"), Result.AssetPath);
+			if (!Result.GraphName.IsEmpty())
+			{
+				Writer->WriteValue(TEXT("graph"), Result.GraphName);
+			}
+			Writer->WriteValue(TEXT("status"), !Result.bSucceeded ? TEXT("failed") : Result.IsPartial() ? TEXT("partial") : TEXT("ok"));
+			if (!Result.Error.IsEmpty())
+			{
+				Writer->WriteValue(TEXT("error"), Result.Error);
+			}
+			Writer->WriteValue(TEXT("nodesCreated"), Result.Stats.NodesCreated);
+			Writer->WriteValue(TEXT("nodesFailed"), Result.Stats.NodesFailed);
+			Writer->WriteValue(TEXT("connectionsCreated"), Result.Stats.ConnectionsCreated);
+			Writer->WriteValue(TEXT("connectionsFailed"), Result.Stats.ConnectionsFailed);
+			Writer->WriteValue(TEXT("applyMs"), Result.ApplySeconds * 1000.0);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("blueprintResults"));
+		for (const FBlueprintImportResult& Result : Blueprints)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("asset"), Result.AssetPath);
+			Writer->WriteValue(TEXT("status"), Result.bSucceeded ? TEXT("ok") : TEXT("failed"));
+			if (!Result.Error.IsEmpty())
+			{
+				Writer->WriteValue(TEXT("error"), Result.Error);
+			}
+			Writer->WriteValue(TEXT("files"), Result.Files.Num());
+			Writer->WriteValue(TEXT("loadMs"), Result.LoadSeconds * 1000.0);
+			Writer->WriteValue(TEXT("compileMs"), Result.CompileSeconds * 1000.0);
+			Writer->WriteValue(TEXT("saveMs"), Result.SaveSeconds * 1000.0);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return FFileHelper::SaveStringToFile(ReportJson, *ReportFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
+
+UUnrealGraphImportCommandlet::UUnrealGraphImportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UUnrealGraphImportCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Options
+	FString ManifestFile;
+	if (!FParse::Value(*Params, TEXT("Manifest="), ManifestFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: -Manifest=<file> is required"));
+		return 1;
+	}
+	ManifestFile = FPaths::ConvertRelativePathToFull(ManifestFile);
+
+	FString ReportFile = FPaths::Combine(FPaths::GetPath(ManifestFile), TEXT("UnrealGraphImport_Report.json"));
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+
+	int32 SaveBatchSize = 50;
+	FParse::Value(*Params, TEXT("SaveBatch="), SaveBatchSize);
+	SaveBatchSize = FMath::Max(SaveBatchSize, 1);
+
+	const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+	TArray<FFileImportResult> Files;
+	FString Error;
+	if (!ReadManifest(ManifestFile, Files, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: %s"), *Error);
+		return 1;
+	}
+
+	// Group entries by asset, in manifest order, so each Blueprint is loaded, compiled and saved once
+	TArray<FBlueprintImportResult> Blueprints;
+	TMap<FString, int32> BlueprintIndexByAsset;
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); ++FileIndex)
+	{
+		const int32* ExistingIndex = BlueprintIndexByAsset.Find(Files[FileIndex].AssetPath);
+		const int32 BlueprintIndex = ExistingIndex ? *ExistingIndex : Blueprints.AddDefaulted();
+		if (!ExistingIndex)
+		{
+			Blueprints[BlueprintIndex].AssetPath = Files[FileIndex].AssetPath;
+			BlueprintIndexByAsset.Add(Files[FileIndex].AssetPath, BlueprintIndex);
+		}
+		Blueprints[BlueprintIndex].Files.Add(FileIndex);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealGraphImport: Applying %d files to %d Blueprints from %s"), Files.Num(), Blueprints.Num(), *ManifestFile);
+
+	// Nothing to refresh without an editor UI: every file is applied in bulk mode (one graph snapshot,
+	// one structural modification). Compilation is left to the end of each Blueprint.
+	FGraphDeserializeOptions DeserializeOptions;
+	DeserializeOptions.bForceBulkMode = true;
+
+	// Modified packages waiting to be saved, with the Blueprint result they belong to
+	TArray<TPair<int32, UPackage*>> PendingSaves;
+	int32 NumCollections = 0;
+
+	auto SavePendingPackages = [&PendingSaves, &Blueprints, &Files, &NumCollections, bSave]()
+	{
+		for (const TPair<int32, UPackage*>& Pending : PendingSaves)
+		{
+			if (!bSave)
+			{
+				break;
+			}
+
+			FBlueprintImportResult& Result = Blueprints[Pending.Key];
+			const double SaveStart = FPlatformTime::Seconds();
+			if (!SavePackage(Pending.Value))
+			{
+				Result.bSucceeded = false;
+				Result.Error = TEXT("Failed to save package");
+				UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: Failed to save %s"), *Result.AssetPath);
+
+				// The applied graphs were lost with the package
+				for (const int32 FileIndex : Result.Files)
+				{
+					if (Files[FileIndex].bSucceeded)
+					{
+						Files[FileIndex].bSucceeded = false;
+						Files[FileIndex].Error = Result.Error;
+					}
+				}
+			}
+			Result.SaveSeconds = FPlatformTime::Seconds() - SaveStart;
+		}
+		PendingSaves.Reset();
+
+		// The saved Blueprints (and everything their compilation loaded) are no longer referenced
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		++NumCollections;
+	};
+
+	FUnrealGraphLogger::Initialize(TEXT("UnrealGraph_Import"));
+	UNREALGRAPH_LOG_SECTION(Summary, FString::Printf(TEXT("Importing %d files into %d Blueprints"), Files.Num(), Blueprints.Num()));
+
+	for (int32 BlueprintIndex = 0; BlueprintIndex < Blueprints.Num(); ++BlueprintIndex)
+	{
+		FBlueprintImportResult& BlueprintResult = Blueprints[BlueprintIndex];
+
+		double PhaseStart = FPlatformTime::Seconds();
+		UBlueprint* Blueprint = LoadBlueprint(BlueprintResult.AssetPath);
+		BlueprintResult.LoadSeconds = FPlatformTime::Seconds() - PhaseStart;
+		if (!Blueprint)
+		{
+			BlueprintResult.Error = TEXT("Failed to load Blueprint");
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: Failed to load %s"), *BlueprintResult.AssetPath);
+			for (const int32 FileIndex : BlueprintResult.Files)
+			{
+				Files[FileIndex].Error = BlueprintResult.Error;
+			}
+			continue;
+		}
+
+		int32 NumApplied = 0;
+		for (const int32 FileIndex : BlueprintResult.Files)
+		{
+			FFileImportResult& FileResult = Files[FileIndex];
+			PhaseStart = FPlatformTime::Seconds();
+
+			UEdGraph* Graph = FindTargetGraph(Blueprint, FileResult.GraphName);
+			FBlueprintGraphDescription Description;
+			if (!Graph)
+			{
+				FileResult.Error = FString::Printf(TEXT("Blueprint has no graph '%s'"), FileResult.GraphName.IsEmpty() ? TEXT("<event graph>") : *FileResult.GraphName);
+			}
+			else if (!ReadGraphFile(FileResult.File, Description, FileResult.Error))
+			{
+				FileResult.Error = FString::Printf(TEXT("Invalid graph file: %s"), *FileResult.Error);
+			}
+			else if (!FBlueprintGraphDeserializer::DeserializeGraph(Graph, Description, &FileResult.Stats, DeserializeOptions))
+			{
+				FileResult.Error = TEXT("Failed to apply graph");
+			}
+			else
+			{
+				FileResult.bSucceeded = true;
+				++NumApplied;
+			}
+			FileResult.ApplySeconds = FPlatformTime::Seconds() - PhaseStart;
+
+			if (FileResult.bSucceeded)
+			{
+				UE_LOG(LogTemp, Display, TEXT("UnrealGraphImport: %s -> %s: %d/%d nodes, %d/%d connections"),
+					*FileResult.File, *FileResult.AssetPath,
+					FileResult.Stats.NodesCreated, FileResult.Stats.NodesCreated + FileResult.Stats.NodesFailed,
+					FileResult.Stats.ConnectionsCreated, FileResult.Stats.ConnectionsCreated + FileResult.Stats.ConnectionsFailed);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: %s -> %s: %s"), *FileResult.File, *FileResult.AssetPath, *FileResult.Error);
+			}
+		}
+
+		// Undo history is of no use here and would keep every applied graph alive
+		if (GEditor)
+		{
+			GEditor->ResetTransaction(NSLOCTEXT("UnrealGraph", "ImportCommandlet", "UnrealGraph batch import"));
+		}
+
+		if (NumApplied == 0)
+		{
+			BlueprintResult.Error = TEXT("No file could be applied");
+			continue;
+		}
+
+		// Once per Blueprint, however many of its graphs were applied
+		PhaseStart = FPlatformTime::Seconds();
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		BlueprintResult.CompileSeconds = FPlatformTime::Seconds() - PhaseStart;
+		BlueprintResult.bCompileErrors = Blueprint->Status == BS_Error;
+		BlueprintResult.bSucceeded = !BlueprintResult.bCompileErrors;
+		if (BlueprintResult.bCompileErrors)
+		{
+			// Saved anyway: the graphs were applied as requested, and the errors are there to be fixed in the editor
+			BlueprintResult.Error = TEXT("Compiled with errors");
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: %s compiled with errors"), *BlueprintResult.AssetPath);
+		}
+
+		UNREALGRAPH_LOG(Summary, TEXT("%s: %d/%d files applied, compiled in %.1f ms%s"),
+			*BlueprintResult.AssetPath, NumApplied, BlueprintResult.Files.Num(), BlueprintResult.CompileSeconds * 1000.0,
+			BlueprintResult.bCompileErrors ? TEXT(" (with errors)") : TEXT(""));
+
+		Blueprint->MarkPackageDirty();
+		PendingSaves.Emplace(BlueprintIndex, Blueprint->GetOutermost());
+		if (PendingSaves.Num() >= SaveBatchSize)
+		{
+			SavePendingPackages();
+		}
+	}
+
+	if (PendingSaves.Num() > 0)
+	{
+		SavePendingPackages();
+	}
+
+	FUnrealGraphLogger::Shutdown();
+
+	// Summary
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	const int32 NumFilesFailed = Files.FilterByPredicate([](const FFileImportResult& Result) { return !Result.bSucceeded; }).Num();
+	const int32 NumBlueprintsFailed = Blueprints.FilterByPredicate([](const FBlueprintImportResult& Result) { return !Result.bSucceeded; }).Num();
+
+	if (!WriteReport(ReportFile, ManifestFile, Files, Blueprints, TotalSeconds))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraphImport: Failed to write report %s"), *ReportFile);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealGraphImport: Applied %d/%d files to %d Blueprints in %.1f s (%d files failed, %d Blueprints failed, %d garbage collections), report: %s"),
+		Files.Num() - NumFilesFailed, Files.Num(), Blueprints.Num(), TotalSeconds, NumFilesFailed, NumBlueprintsFailed, NumCollections, *ReportFile);
+
+	return NumFilesFailed == 0 && NumBlueprintsFailed == 0 ? 0 : 1;
+}
@@ -4,86 +4,489 @@
 #include "EdGraph/EdGraphNode.h"
 #include "UObject/Class.h"
 #include "UObject/UnrealType.h"
-#include "UObject/PropertyAccessUtil.h"
 #include "Misc/DateTime.h"
-#include "Misc/FileHelper.h"
-#include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopeLock.h"
 #include "Math/Vector2D.h"
 #include "Misc/VarArgs.h"
-#include "Misc/FileHelper.h"
-#include "HAL/PlatformFilemanager.h"
-#include "Math/Vector2D.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Containers/Queue.h"
+#include "Serialization/Archive.h"
+
+namespace UnrealGraphLog
+{
+	static int32 MaxQueuedKB = 4096;
+	static FAutoConsoleVariableRef CVarMaxQueuedKB(
+		TEXT("UnrealGraph.Log.MaxQueuedKB"),
+		MaxQueuedKB,
+		TEXT("Memory budget for log messages waiting to be written. Messages beyond it are dropped and counted."),
+		ECVF_Default
+	);
+
+	static int32 MaxFileSizeMB = 16;
+	static FAutoConsoleVariableRef CVarMaxFileSizeMB(
+		TEXT("UnrealGraph.Log.MaxFileSizeMB"),
+		MaxFileSizeMB,
+		TEXT("Size at which a log file is closed and continued in a new part file."),
+		ECVF_Default
+	);
+
+	static int32 MaxFiles = 20;
+	static FAutoConsoleVariableRef CVarMaxFiles(
+		TEXT("UnrealGraph.Log.MaxFiles"),
+		MaxFiles,
+		TEXT("Number of UnrealGraph_*.log files kept in the project log directory (0 keeps all)."),
+		ECVF_Default
+	);
+}
+
+/**
+ * Message handed from logging threads to the writer thread
+ */
+struct FUnrealGraphLogEntry
+{
+	enum class EKind : uint8
+	{
+		/** Timestamped line */
+		Line,
+		/** Pre-formatted text written as-is (section headers) */
+		Raw,
+		/** Start of a session; Text holds the log file name */
+		BeginSession,
+		/** End of a session; the current file is closed */
+		EndSession
+	};
+
+	EKind Kind = EKind::Line;
+	FDateTime Time;
+	FString Text;
+};
+
+/**
+ * Drains the log queue on a dedicated thread and owns the open log file
+ */
+class FUnrealGraphLogWriter : public FRunnable
+{
+public:
+	FUnrealGraphLogWriter();
+	virtual ~FUnrealGraphLogWriter() override;
+
+	/** Queue an entry from any thread */
+	void Enqueue(FUnrealGraphLogEntry::EKind Kind, FString&& Text);
+
+	/** Block until everything queued so far is on disk */
+	void Flush();
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	/** Write every queued entry (consumer side only) */
+	void ProcessQueue();
+
+	void WriteEntry(const FUnrealGraphLogEntry& Entry);
+	void WriteText(const FString& Text);
+	void OpenFile();
+	void CloseFile();
+
+	/** Delete the oldest UnrealGraph_*.log files beyond UnrealGraph.Log.MaxFiles */
+	void ApplyRetention() const;
+
+	static int64 GetEntrySize(const FString& Text) { return sizeof(FUnrealGraphLogEntry) + Text.GetAllocatedSize(); }
+
+	TQueue<FUnrealGraphLogEntry, EQueueMode::Mpsc> Queue;
+	std::atomic<int64> QueuedBytes{0};
+	std::atomic<int64> EnqueuedCount{0};
+	std::atomic<int64> ProcessedCount{0};
+	std::atomic<int32> DroppedCount{0};
+	std::atomic<bool> bStopRequested{false};
+
+	FEvent* WorkEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+
+	/** Consumer-side state, only touched while draining the queue */
+	FArchive* File = nullptr;
+	FString CurrentFilePath;
+	FString SessionName;
+	FString SessionTimestamp;
+	int32 PartIndex = 0;
+	int64 FileBytes = 0;
+};
+
+FUnrealGraphLogWriter::FUnrealGraphLogWriter()
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		Thread = FRunnableThread::Create(this, TEXT("UnrealGraphLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+FUnrealGraphLogWriter::~FUnrealGraphLogWriter()
+{
+	if (Thread)
+	{
+		// Kill calls Stop and waits for Run to drain the queue and close the file
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	else
+	{
+		ProcessQueue();
+		CloseFile();
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+void FUnrealGraphLogWriter::Enqueue(FUnrealGraphLogEntry::EKind Kind, FString&& Text)
+{
+	const int64 EntrySize = GetEntrySize(Text);
+	const bool bIsMessage = Kind == FUnrealGraphLogEntry::EKind::Line || Kind == FUnrealGraphLogEntry::EKind::Raw;
+
+	// Session markers are never dropped; messages are dropped once the budget is exhausted
+	if (bIsMessage && QueuedBytes.load(std::memory_order_relaxed) + EntrySize > static_cast<int64>(UnrealGraphLog::MaxQueuedKB) * 1024)
+	{
+		DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FUnrealGraphLogEntry Entry;
+	Entry.Kind = Kind;
+	Entry.Time = FDateTime::Now();
+	Entry.Text = MoveTemp(Text);
+
+	QueuedBytes.fetch_add(EntrySize, std::memory_order_relaxed);
+	EnqueuedCount.fetch_add(1, std::memory_order_release);
+	Queue.Enqueue(MoveTemp(Entry));
+
+	if (Thread)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		ProcessQueue();
+	}
+}
+
+void FUnrealGraphLogWriter::Flush()
+{
+	if (!Thread)
+	{
+		ProcessQueue();
+		return;
+	}
+
+	const int64 Target = EnqueuedCount.load(std::memory_order_acquire);
+	WorkEvent->Trigger();
+	while (ProcessedCount.load(std::memory_order_acquire) < Target && !bStopRequested)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+uint32 FUnrealGraphLogWriter::Run()
+{
+	while (!bStopRequested)
+	{
+		WorkEvent->Wait(FTimespan::FromMilliseconds(100));
+		ProcessQueue();
+	}
+
+	ProcessQueue();
+	CloseFile();
+	return 0;
+}
+
+void FUnrealGraphLogWriter::Stop()
+{
+	bStopRequested = true;
+	WorkEvent->Trigger();
+}
+
+void FUnrealGraphLogWriter::ProcessQueue()
+{
+	int64 Processed = 0;
+	FUnrealGraphLogEntry Entry;
+	while (Queue.Dequeue(Entry))
+	{
+		QueuedBytes.fetch_sub(GetEntrySize(Entry.Text), std::memory_order_relaxed);
+		WriteEntry(Entry);
+		++Processed;
+	}
+
+	const int32 Dropped = DroppedCount.exchange(0, std::memory_order_relaxed);
+	if (Dropped > 0)
+	{
+		FUnrealGraphLogEntry DroppedNote;
+		DroppedNote.Time = FDateTime::Now();
+		DroppedNote.Text = FString::Printf(TEXT("... %d log messages dropped (UnrealGraph.Log.MaxQueuedKB exceeded)"), Dropped);
+		WriteEntry(DroppedNote);
+	}
+
+	if (Processed > 0)
+	{
+		if (File)
+		{
+			File->Flush();
+		}
+		ProcessedCount.fetch_add(Processed, std::memory_order_release);
+	}
+}
+
+void FUnrealGraphLogWriter::WriteEntry(const FUnrealGraphLogEntry& Entry)
+{
+	switch (Entry.Kind)
+	{
+	case FUnrealGraphLogEntry::EKind::BeginSession:
+		CloseFile();
+		SessionName = Entry.Text;
+		SessionTimestamp = Entry.Time.ToString(TEXT("%Y%m%d_%H%M%S"));
+		PartIndex = 0;
+		break;
+
+	case FUnrealGraphLogEntry::EKind::EndSession:
+		CloseFile();
+		SessionName.Reset();
+		break;
+
+	case FUnrealGraphLogEntry::EKind::Line:
+		WriteText(FString::Printf(TEXT("%s %s\n"), *Entry.Time.ToString(TEXT("[%H:%M:%S]")), *Entry.Text));
+		break;
+
+	case FUnrealGraphLogEntry::EKind::Raw:
+		WriteText(Entry.Text);
+		break;
+	}
+}
+
+void FUnrealGraphLogWriter::WriteText(const FString& Text)
+{
+	if (!File)
+	{
+		OpenFile();
+		if (!File)
+		{
+			return;
+		}
+	}
 
-bool FUnrealGraphLogger::bIsInitialized = false;
-FString FUnrealGraphLogger::LogFilePath;
-TArray<FString> FUnrealGraphLogger::LogBuffer;
+	FTCHARToUTF8 Utf8Text(*Text);
+	File->Serialize(const_cast<ANSICHAR*>(Utf8Text.Get()), Utf8Text.Length());
+	FileBytes += Utf8Text.Length();
 
-void FUnrealGraphLogger::Initialize(const FString& LogFileName)
+	// Rotate: the next write continues the session in a new part file
+	if (UnrealGraphLog::MaxFileSizeMB > 0 && FileBytes >= static_cast<int64>(UnrealGraphLog::MaxFileSizeMB) * 1024 * 1024)
+	{
+		CloseFile();
+		++PartIndex;
+	}
+}
+
+void FUnrealGraphLogWriter::OpenFile()
 {
-	if (bIsInitialized)
+	// Messages logged outside a session go to a default file
+	if (SessionName.IsEmpty())
 	{
-		Shutdown();
+		SessionName = TEXT("UnrealGraph_Debug");
+		SessionTimestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+		PartIndex = 0;
 	}
 
 	// Create log file path in project logs directory
-	FString LogDir = FPaths::ProjectLogDir();
-	FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
-	LogFilePath = LogDir / FString::Printf(TEXT("%s_%s.log"), *LogFileName, *Timestamp);
+	const FString LogDir = FPaths::ProjectLogDir();
+	CurrentFilePath = PartIndex == 0
+		? LogDir / FString::Printf(TEXT("%s_%s.log"), *SessionName, *SessionTimestamp)
+		: LogDir / FString::Printf(TEXT("%s_%s_%d.log"), *SessionName, *SessionTimestamp, PartIndex);
 
-	bIsInitialized = true;
+	File = IFileManager::Get().CreateFileWriter(*CurrentFilePath, FILEWRITE_Append | FILEWRITE_AllowRead);
+	if (!File)
+	{
+		return;
+	}
+	FileBytes = File->TotalSize();
 
 	// Write header
 	FString Header = TEXT("================================================================================\n");
 	Header += TEXT("UnrealGraph Plugin - Debug Log\n");
 	Header += TEXT("================================================================================\n");
 	Header += FString::Printf(TEXT("Timestamp: %s\n"), *FDateTime::Now().ToString());
-	Header += FString::Printf(TEXT("Log File: %s\n"), *LogFilePath);
+	Header += FString::Printf(TEXT("Log File: %s\n"), *CurrentFilePath);
+	if (PartIndex > 0)
+	{
+		Header += FString::Printf(TEXT("Part: %d (continued)\n"), PartIndex);
+	}
 	Header += TEXT("================================================================================\n\n");
 
-	LogBuffer.Add(Header);
-	Log(TEXT("Logger initialized"));
+	FTCHARToUTF8 Utf8Header(*Header);
+	File->Serialize(const_cast<ANSICHAR*>(Utf8Header.Get()), Utf8Header.Length());
+	FileBytes += Utf8Header.Length();
+
+	ApplyRetention();
 }
 
-void FUnrealGraphLogger::Shutdown()
+void FUnrealGraphLogWriter::CloseFile()
 {
-	if (!bIsInitialized)
+	if (File)
+	{
+		File->Close();
+		delete File;
+		File = nullptr;
+	}
+	FileBytes = 0;
+}
+
+void FUnrealGraphLogWriter::ApplyRetention() const
+{
+	if (UnrealGraphLog::MaxFiles <= 0)
 	{
 		return;
 	}
 
-	FlushLogBuffer();
-	
-	LogBuffer.Empty();
+	const FString LogDir = FPaths::ProjectLogDir();
+	TArray<FString> FoundFiles;
+	IFileManager::Get().FindFiles(FoundFiles, *(LogDir / TEXT("UnrealGraph_*.log")), true, false);
+	if (FoundFiles.Num() <= UnrealGraphLog::MaxFiles)
+	{
+		return;
+	}
+
+	TArray<TPair<FDateTime, FString>> FilesByAge;
+	for (const FString& FileName : FoundFiles)
+	{
+		const FString FilePath = LogDir / FileName;
+		FilesByAge.Emplace(IFileManager::Get().GetTimeStamp(*FilePath), FilePath);
+	}
+	FilesByAge.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	int32 ToDelete = FilesByAge.Num() - UnrealGraphLog::MaxFiles;
+	for (const TPair<FDateTime, FString>& Entry : FilesByAge)
+	{
+		if (ToDelete <= 0)
+		{
+			break;
+		}
+		if (Entry.Value != CurrentFilePath)
+		{
+			IFileManager::Get().Delete(*Entry.Value, false, false, true);
+			--ToDelete;
+		}
+	}
+}
+
+std::atomic<bool> FUnrealGraphLogger::bIsInitialized{false};
+int32 FUnrealGraphLogger::SessionDepth = 0;
+FCriticalSection FUnrealGraphLogger::SessionLock;
+int32 FUnrealGraphLogger::RuntimeLogLevel = static_cast<int32>(EUnrealGraphLogLevel::Error);
+std::atomic<FUnrealGraphLogWriter*> FUnrealGraphLogger::Writer{nullptr};
+FCriticalSection FUnrealGraphLogger::WriterLock;
+
+FAutoConsoleVariableRef FUnrealGraphLogger::CVarLogLevel(
+	TEXT("UnrealGraph.LogLevel"),
+	FUnrealGraphLogger::RuntimeLogLevel,
+	TEXT("Verbosity of the UnrealGraph file log (Saved/Logs/UnrealGraph_*.log).\n")
+	TEXT("0: Off, 1: Error (default), 2: Summary, 3: Verbose, 4: Trace"),
+	ECVF_Default
+);
+
+FUnrealGraphLogWriter& FUnrealGraphLogger::GetWriter()
+{
+	FUnrealGraphLogWriter* Instance = Writer.load(std::memory_order_acquire);
+	if (!Instance)
+	{
+		FScopeLock Lock(&WriterLock);
+		Instance = Writer.load(std::memory_order_relaxed);
+		if (!Instance)
+		{
+			Instance = new FUnrealGraphLogWriter();
+			Writer.store(Instance, std::memory_order_release);
+		}
+	}
+	return *Instance;
+}
+
+void FUnrealGraphLogger::StopWriter()
+{
+	// Same order as Initialize (session, then writer)
+	FScopeLock SessionScope(&SessionLock);
+	FScopeLock Lock(&WriterLock);
+	if (FUnrealGraphLogWriter* Instance = Writer.exchange(nullptr))
+	{
+		delete Instance;
+	}
 	bIsInitialized = false;
+	SessionDepth = 0;
 }
 
-void FUnrealGraphLogger::Log(const FString& Message)
+void FUnrealGraphLogger::Flush()
 {
-	if (!bIsInitialized)
+	if (FUnrealGraphLogWriter* Instance = Writer.load(std::memory_order_acquire))
 	{
-		// Auto-initialize if not initialized
-		Initialize();
+		Instance->Flush();
 	}
+}
 
-	FString Timestamp = FDateTime::Now().ToString(TEXT("[%H:%M:%S]"));
-	FString LogLine = FString::Printf(TEXT("%s %s\n"), *Timestamp, *Message);
-	
-	LogBuffer.Add(LogLine);
+void FUnrealGraphLogger::Initialize(const FString& InLogFileName)
+{
+	FScopeLock Lock(&SessionLock);
+
+	// Nested session: keep logging into the outer one
+	if (SessionDepth++ > 0)
+	{
+		return;
+	}
 
-	// Flush periodically or immediately for important messages
-	if (LogBuffer.Num() > 50)
+	if (!IsLevelEnabled(EUnrealGraphLogLevel::Error))
 	{
-		FlushLogBuffer();
+		return;
 	}
+
+	// The file itself is created by the writer when the first message of the session arrives
+	GetWriter().Enqueue(FUnrealGraphLogEntry::EKind::BeginSession, FString(InLogFileName));
+	bIsInitialized = true;
 }
 
-void FUnrealGraphLogger::LogFormatted(const TCHAR* Format, ...)
+void FUnrealGraphLogger::Shutdown()
+{
+	FScopeLock Lock(&SessionLock);
+	if (SessionDepth == 0 || --SessionDepth > 0)
+	{
+		return;
+	}
+
+	if (!bIsInitialized.exchange(false))
+	{
+		return;
+	}
+
+	GetWriter().Enqueue(FUnrealGraphLogEntry::EKind::EndSession, FString());
+}
+
+void FUnrealGraphLogger::Log(const FString& Message)
 {
-	if (!bIsInitialized)
+	if (!IsLevelEnabled(EUnrealGraphLogLevel::Error))
 	{
-		Initialize();
+		return;
 	}
 
+	GetWriter().Enqueue(FUnrealGraphLogEntry::EKind::Line, FString(Message));
+}
+
+void FUnrealGraphLogger::LogFormatted(const TCHAR* Format, ...)
+{
 	va_list Args;
 	va_start(Args, Format);
 	
@@ -98,17 +501,17 @@ void FUnrealGraphLogger::LogFormatted(const TCHAR* Format, ...)
 
 void FUnrealGraphLogger::LogSection(const FString& SectionName)
 {
+	if (!IsLevelEnabled(EUnrealGraphLogLevel::Error))
+	{
+		return;
+	}
+
 	FString SectionHeader = TEXT("\n");
 	SectionHeader += TEXT("────────────────────────────────────────────────────────────────────────\n");
 	SectionHeader += FString::Printf(TEXT("  %s\n"), *SectionName);
 	SectionHeader += TEXT("────────────────────────────────────────────────────────────────────────\n");
 	
-	LogBuffer.Add(SectionHeader);
-	
-	if (LogBuffer.Num() > 0)
-	{
-		FlushLogBuffer();
-	}
+	GetWriter().Enqueue(FUnrealGraphLogEntry::EKind::Raw, MoveTemp(SectionHeader));
 }
 
 void FUnrealGraphLogger::LogNodeDetails(UEdGraphNode* Node)
@@ -188,23 +591,3 @@ void FUnrealGraphLogger::LogProperty(const FString& PropertyName, const FString&
 {
 	LogFormatted(TEXT("  %s: %s"), *PropertyName, *PropertyValue);
 }
-
-void FUnrealGraphLogger::FlushLogBuffer()
-{
-	if (LogBuffer.Num() == 0 || LogFilePath.IsEmpty())
-	{
-		return;
-	}
-
-	FString LogContent;
-	for (const FString& Line : LogBuffer)
-	{
-		LogContent += Line;
-	}
-
-	// Append to file (creates if doesn't exist)
-	FFileHelper::SaveStringToFile(LogContent, *LogFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), EFileWrite::FILEWRITE_Append);
-	
-	LogBuffer.Empty();
-}
-
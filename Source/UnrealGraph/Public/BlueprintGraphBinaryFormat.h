@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintGraphDescription;
+
+/**
+ * Versioned binary encoding of the graph JSON model, used for archives and caches.
+ *
+ * Layout (integers are unsigned LEB128 varints unless noted):
+ *   Header      magic (4 bytes, "UGRB"), format version
+ *   Strings     count, then per string its UTF-8 byte length and bytes
+ *   Metadata    version, unrealVersion, exportDate as string refs
+ *   Nodes       count, then per node: flags, id/type/classPath/title, member names, position, member reference, pins
+ *   Connections count, then per connection: from node, from pin, to node, to pin
+ *
+ * A string ref is index + 1 (0 = absent). Connection nodes and pins are index + 1, or 0 followed by
+ * a node id / pin name string ref (see FBlueprintGraphConnectionEndpoint). Integral positions are
+ * zigzag deltas from the previous positioned node; other positions are stored as raw doubles.
+ *
+ * Version history: 1 stored linked node refs per pin and pin names in connections; 2 (schema 2.0)
+ * stores pin indices and no per-pin links. Version 1 data is converted when decoded.
+ */
+class FBlueprintGraphBinaryFormat
+{
+public:
+	/** Format version written by Encode; Decode accepts this version and older */
+	static constexpr uint32 CurrentVersion = 2;
+
+	/**
+	 * Encode a graph description
+	 * @param Description The description to encode
+	 * @param OutBytes Receives the encoded bytes
+	 */
+	static void Encode(const FBlueprintGraphDescription& Description, TArray<uint8>& OutBytes);
+
+	/**
+	 * Decode a graph description
+	 * @param Bytes The encoded bytes
+	 * @param OutDescription Receives the description
+	 * @param OutError Receives a description of the problem when decoding fails
+	 * @return True if the bytes hold a valid graph of a supported version
+	 */
+	static bool Decode(TArrayView<const uint8> Bytes, FBlueprintGraphDescription& OutDescription, FString& OutError);
+
+	/**
+	 * Check whether a buffer starts with the binary graph magic
+	 * @param Bytes The buffer to check
+	 * @return True if the buffer looks like a binary graph
+	 */
+	static bool IsBinaryGraph(TArrayView<const uint8> Bytes);
+
+	/**
+	 * Convert graph JSON text to the binary format
+	 * @param JsonText The JSON text
+	 * @param OutBytes Receives the encoded bytes
+	 * @param OutError Receives a description of the problem when the JSON is invalid
+	 * @return True if the JSON was converted
+	 */
+	static bool JsonToBinary(const FString& JsonText, TArray<uint8>& OutBytes, FString& OutError);
+
+	/**
+	 * Convert the binary format back to graph JSON text.
+	 * JSON written by FBlueprintGraphSerializer round-trips byte for byte; unknown fields are not kept.
+	 * @param Bytes The encoded bytes
+	 * @param OutJson Receives the JSON text
+	 * @param OutError Receives a description of the problem when decoding fails
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the bytes were converted
+	 */
+	static bool BinaryToJson(TArrayView<const uint8> Bytes, FString& OutJson, FString& OutError, bool bPrettyPrint = true);
+};
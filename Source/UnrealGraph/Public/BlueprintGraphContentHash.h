@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+struct FBlueprintGraphDescription;
+struct FBlueprintGraphSectionDescription;
+struct FBlueprintDescription;
+
+/**
+ * Hashes of one node
+ */
+struct FBlueprintGraphNodeHashes
+{
+	/** Class, member, title, pins with their defaults, and outgoing links; not the id or the position */
+	uint64 Content = 0;
+
+	/** Position only, so moving nodes around leaves Content unchanged */
+	uint64 Layout = 0;
+};
+
+/**
+ * Hashes of one graph: per node, and Merkle roots over its nodes
+ */
+struct FBlueprintGraphHashes
+{
+	/** Parallel to the graph's nodes */
+	TArray<FBlueprintGraphNodeHashes> Nodes;
+
+	/** Root over the node content hashes; independent of node order and ids */
+	uint64 ContentRoot = 0;
+
+	/** Root over the node content and layout hashes */
+	uint64 LayoutRoot = 0;
+};
+
+/**
+ * Hashes of every graph of a Blueprint, and roots over the graph roots
+ */
+struct FBlueprintHashes
+{
+	/** Parallel to FBlueprintDescription::Graphs */
+	TArray<FBlueprintGraphHashes> Graphs;
+
+	uint64 ContentRoot = 0;
+	uint64 LayoutRoot = 0;
+};
+
+/**
+ * Stable content hashes of serialized graphs, for finding unchanged nodes, graphs and Blueprints
+ * without comparing their content (diffing, caching, deduplication).
+ *
+ * Hashes depend only on what is serialized, never on node GUIDs, so a copy of a graph in another
+ * asset hashes the same. A node's content hash covers its own fields and its outgoing links, each
+ * link identified by the pin names and the linked node's own fields (not its hash, as graphs may
+ * contain cycles). Hashes are 64-bit xxHash values, written as 16 hex digits.
+ */
+class FBlueprintGraphContentHash
+{
+public:
+	/**
+	 * Hash a whole graph description
+	 * @param Description The graph description
+	 * @param OutHashes Receives the hashes
+	 */
+	static void HashGraph(const FBlueprintGraphDescription& Description, FBlueprintGraphHashes& OutHashes);
+
+	/**
+	 * Hash one graph of a Blueprint description
+	 * @param Content The shared content of the Blueprint description
+	 * @param Section The graph (connection node indices are local to it)
+	 * @param OutHashes Receives the hashes
+	 */
+	static void HashGraph(const FBlueprintGraphDescription& Content, const FBlueprintGraphSectionDescription& Section, FBlueprintGraphHashes& OutHashes);
+
+	/**
+	 * Hash a live graph (takes a snapshot with FBlueprintGraphSerializer::DescribeGraph)
+	 * @param Graph The graph
+	 * @param OutHashes Receives the hashes
+	 * @return False if the graph could not be described
+	 */
+	static bool HashGraph(UEdGraph* Graph, FBlueprintGraphHashes& OutHashes);
+
+	/**
+	 * Hash every graph of a Blueprint description
+	 * @param Description The Blueprint description
+	 * @param OutHashes Receives the hashes
+	 */
+	static void HashBlueprint(const FBlueprintDescription& Description, FBlueprintHashes& OutHashes);
+
+	/**
+	 * Combine the graph hashes of a Blueprint into its roots; graphs are combined in order, with their name and kind
+	 * @param Description The Blueprint description the graph hashes belong to
+	 * @param InOutHashes Hashes with Graphs filled in; receives the roots
+	 */
+	static void FinishBlueprint(const FBlueprintDescription& Description, FBlueprintHashes& InOutHashes);
+
+	/**
+	 * Format a hash as written to JSON
+	 * @param Hash The hash
+	 * @return 16 lower-case hex digits
+	 */
+	static FString ToString(uint64 Hash);
+};
@@ -0,0 +1,332 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+/**
+ * Case-sensitive FString keys; the default TMap<FString> comparison ignores case,
+ * which would merge pin names such as "Value" and "value"
+ */
+template <typename ValueType>
+struct TCaseSensitiveStringMapKeyFuncs : public TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+	static FORCEINLINE bool Matches(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/**
+ * Pin entry of a graph description. String fields are indices into FBlueprintGraphDescription::Strings,
+ * INDEX_NONE when the field was absent.
+ */
+struct FBlueprintGraphPinDescription
+{
+	int32 Name = INDEX_NONE;
+	int32 Category = INDEX_NONE;
+	int32 SubCategory = INDEX_NONE;
+	int32 DefaultValue = INDEX_NONE;
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
+};
+
+/**
+ * Node entry of a graph description. String fields are indices into FBlueprintGraphDescription::Strings,
+ * INDEX_NONE when the field was absent.
+ */
+struct FBlueprintGraphNodeDescription
+{
+	int32 Id = INDEX_NONE;
+	int32 Type = INDEX_NONE;
+	int32 ClassPath = INDEX_NONE;
+	int32 Title = INDEX_NONE;
+
+	double PositionX = 0.0;
+	double PositionY = 0.0;
+	bool bHasPosition = false;
+
+	int32 FunctionName = INDEX_NONE;
+	int32 VariableName = INDEX_NONE;
+	int32 EventName = INDEX_NONE;
+	int32 EventClass = INDEX_NONE;
+	int32 EventClassPath = INDEX_NONE;
+	bool bHasIsCustomEvent = false;
+	bool bIsCustomEvent = false;
+
+	/** "memberReference" object; the remaining member fields are only meaningful when set */
+	bool bHasMemberReference = false;
+	int32 MemberName = INDEX_NONE;
+	int32 MemberParent = INDEX_NONE;
+	int32 MemberGuid = INDEX_NONE;
+	bool bSelfContext = false;
+
+	/** Range in FBlueprintGraphDescription::Pins */
+	int32 FirstPin = 0;
+	int32 NumPins = 0;
+};
+
+/**
+ * One end of a connection. The node is either an index into FBlueprintGraphDescription::Nodes or,
+ * for a node outside the document, its id string; the pin is either an index into that node's pins
+ * or a pin name string. Exactly one of Node/NodeId and one of Pin/PinName is set, and Pin is only
+ * used together with Node.
+ */
+struct FBlueprintGraphConnectionEndpoint
+{
+	int32 Node = INDEX_NONE;
+	int32 Pin = INDEX_NONE;
+
+	/** String indices, INDEX_NONE when the index form is used */
+	int32 NodeId = INDEX_NONE;
+	int32 PinName = INDEX_NONE;
+
+	bool IsValid() const
+	{
+		return (Node != INDEX_NONE) != (NodeId != INDEX_NONE)
+			&& (Pin != INDEX_NONE) != (PinName != INDEX_NONE)
+			&& (Pin == INDEX_NONE || Node != INDEX_NONE);
+	}
+};
+
+/**
+ * Connection entry of a graph description, written as [fromNode, fromPin, toNode, toPin]
+ */
+struct FBlueprintGraphConnectionDescription
+{
+	FBlueprintGraphConnectionEndpoint From;
+	FBlueprintGraphConnectionEndpoint To;
+};
+
+/**
+ * Compact, DOM-free description of a serialized graph: flat node, pin and connection arrays
+ * referring to a single table of interned strings. Filled by FBlueprintGraphJsonReader and
+ * consumed by FBlueprintGraphDeserializer.
+ */
+struct FBlueprintGraphDescription
+{
+	/** Interned strings (case-sensitive, each stored once) */
+	TArray<FString> Strings;
+
+	/** Metadata (string indices) */
+	int32 Version = INDEX_NONE;
+	int32 UnrealVersion = INDEX_NONE;
+	int32 ExportDate = INDEX_NONE;
+
+	TArray<FBlueprintGraphNodeDescription> Nodes;
+	TArray<FBlueprintGraphPinDescription> Pins;
+	TArray<FBlueprintGraphConnectionDescription> Connections;
+
+	/**
+	 * Intern a string
+	 * @param Value The string to add
+	 * @return Index of the string in Strings
+	 */
+	int32 AddString(const FString& Value)
+	{
+		if (const int32* Existing = StringLookup.Find(Value))
+		{
+			return *Existing;
+		}
+		const int32 Index = Strings.Add(Value);
+		StringLookup.Add(Value, Index);
+		return Index;
+	}
+
+	/**
+	 * Get an interned string
+	 * @param Index String index, may be INDEX_NONE
+	 * @return The string, or an empty string for INDEX_NONE
+	 */
+	const FString& GetString(int32 Index) const
+	{
+		static const FString Empty;
+		return Strings.IsValidIndex(Index) ? Strings[Index] : Empty;
+	}
+
+	/** Drop the interning lookup and spare capacity once the description is complete (no AddString afterwards) */
+	void FinishBuilding()
+	{
+		StringLookup.Empty();
+		Strings.Shrink();
+		Nodes.Shrink();
+		Pins.Shrink();
+		Connections.Shrink();
+	}
+
+	/**
+	 * Convert id/name endpoints that refer to nodes and pins of this document to the index form.
+	 * Used when reading schema 1.0 payloads, which name every endpoint by node id and pin name.
+	 */
+	void ResolveConnectionEndpoints()
+	{
+		TMap<int32, int32> NodeIndexById;
+		NodeIndexById.Reserve(Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			NodeIndexById.FindOrAdd(Nodes[NodeIndex].Id, NodeIndex);
+		}
+
+		auto Resolve = [this, &NodeIndexById](FBlueprintGraphConnectionEndpoint& Endpoint)
+		{
+			if (Endpoint.NodeId != INDEX_NONE)
+			{
+				if (const int32* NodeIndex = NodeIndexById.Find(Endpoint.NodeId))
+				{
+					Endpoint.Node = *NodeIndex;
+					Endpoint.NodeId = INDEX_NONE;
+				}
+			}
+			if (Endpoint.Node != INDEX_NONE && Endpoint.PinName != INDEX_NONE)
+			{
+				const FBlueprintGraphNodeDescription& Node = Nodes[Endpoint.Node];
+				for (int32 PinIndex = 0; PinIndex < Node.NumPins; ++PinIndex)
+				{
+					if (Pins[Node.FirstPin + PinIndex].Name == Endpoint.PinName)
+					{
+						Endpoint.Pin = PinIndex;
+						Endpoint.PinName = INDEX_NONE;
+						break;
+					}
+				}
+			}
+		};
+
+		for (FBlueprintGraphConnectionDescription& Connection : Connections)
+		{
+			Resolve(Connection.From);
+			Resolve(Connection.To);
+		}
+	}
+
+	/**
+	 * Get the pin an index-form endpoint refers to
+	 * @param Endpoint The endpoint, with Node and Pin set
+	 * @return The pin description, or nullptr if the endpoint does not use pin indices
+	 */
+	const FBlueprintGraphPinDescription* GetEndpointPin(const FBlueprintGraphConnectionEndpoint& Endpoint) const
+	{
+		if (!Nodes.IsValidIndex(Endpoint.Node) || Endpoint.Pin == INDEX_NONE || Endpoint.Pin >= Nodes[Endpoint.Node].NumPins)
+		{
+			return nullptr;
+		}
+		return &Pins[Nodes[Endpoint.Node].FirstPin + Endpoint.Pin];
+	}
+
+	/** Clear all content */
+	void Reset()
+	{
+		*this = FBlueprintGraphDescription();
+	}
+
+private:
+	/** Interning lookup, only needed while the description is being built */
+	TMap<FString, int32, FDefaultSetAllocator, TCaseSensitiveStringMapKeyFuncs<int32>> StringLookup;
+};
+
+/**
+ * One graph of a Blueprint description: a range of the shared node and connection arrays.
+ * Connection endpoints index nodes relative to FirstNode.
+ */
+struct FBlueprintGraphSectionDescription
+{
+	/** Graph name and kind ("ubergraph", "function", "macro", "delegate", "interface", "subgraph") as string indices */
+	int32 Name = INDEX_NONE;
+	int32 Kind = INDEX_NONE;
+
+	/** Index of the graph a collapsed sub-graph belongs to, INDEX_NONE for top-level graphs */
+	int32 ParentGraph = INDEX_NONE;
+
+	int32 FirstNode = 0;
+	int32 NumNodes = 0;
+	int32 FirstConnection = 0;
+	int32 NumConnections = 0;
+};
+
+/**
+ * Every graph of one Blueprint, sharing a single string table so names, class paths and pin
+ * categories used by several graphs are stored once
+ */
+struct FBlueprintDescription
+{
+	/** Nodes, pins, connections and strings of all graphs, plus the document metadata */
+	FBlueprintGraphDescription Content;
+
+	/** Blueprint path name (string index) */
+	int32 BlueprintPath = INDEX_NONE;
+
+	TArray<FBlueprintGraphSectionDescription> Graphs;
+
+	/** Clear all content */
+	void Reset()
+	{
+		*this = FBlueprintDescription();
+	}
+};
+
+/**
+ * New position of a node that exists in both graphs of a diff
+ */
+struct FBlueprintGraphNodeMove
+{
+	/** Node id (string index) */
+	int32 Id = INDEX_NONE;
+
+	double PositionX = 0.0;
+	double PositionY = 0.0;
+};
+
+/**
+ * New default value of a pin of a node that exists in both graphs of a diff
+ */
+struct FBlueprintGraphPinDefaultChange
+{
+	/** Node id and pin name (string indices) */
+	int32 Id = INDEX_NONE;
+	int32 PinName = INDEX_NONE;
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
+
+	/** The new value (string index), INDEX_NONE when the pin no longer has a serialized default */
+	int32 DefaultValue = INDEX_NONE;
+};
+
+/**
+ * Changes that turn one serialized graph into another, keyed by node id (node GUID); see FBlueprintGraphDiff.
+ * A node whose type, member or pin layout changed is replaced: its id is both removed and added.
+ */
+struct FBlueprintGraphPatch
+{
+	/**
+	 * Added and replaced nodes, and the links to add. Link endpoints on these nodes use the index form;
+	 * endpoints on nodes already in the graph use the id/name form. Its string table is shared by
+	 * every other field of the patch.
+	 */
+	FBlueprintGraphDescription Added;
+
+	/** Ids of nodes to remove (string indices), including replaced nodes */
+	TArray<int32> RemovedNodes;
+
+	TArray<FBlueprintGraphNodeMove> MovedNodes;
+	TArray<FBlueprintGraphPinDefaultChange> ChangedDefaults;
+
+	/** Links to break between nodes that stay, both endpoints in the id/name form */
+	TArray<FBlueprintGraphConnectionDescription> RemovedLinks;
+
+	/** @return True if applying the patch changes nothing */
+	bool IsEmpty() const
+	{
+		return Added.Nodes.Num() == 0 && Added.Connections.Num() == 0 && RemovedNodes.Num() == 0
+			&& MovedNodes.Num() == 0 && ChangedDefaults.Num() == 0 && RemovedLinks.Num() == 0;
+	}
+
+	/** Clear all content */
+	void Reset()
+	{
+		*this = FBlueprintGraphPatch();
+	}
+};
@@ -4,14 +4,138 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "EdGraph/EdGraphPin.h"
 
 class UEdGraph;
 class UEdGraphNode;
+struct FBlueprintGraphDescription;
+struct FBlueprintGraphNodeDescription;
+struct FBlueprintGraphConnectionEndpoint;
+struct FBlueprintGraphPatch;
+class UBlueprint;
+
+/**
+ * Pins of one node indexed by name (FName comparison, case-insensitive) and by direction + name.
+ * Built once after the node's pins are allocated; shared by default-value restoration and wiring.
+ */
+class FGraphNodePinIndex
+{
+public:
+	FGraphNodePinIndex() = default;
+
+	/**
+	 * Index the current pins of a node
+	 * @param Node The node to index, may be nullptr
+	 */
+	void Build(const UEdGraphNode* Node);
+
+	/**
+	 * Check whether the index still matches the node's pins (pins are reallocated by reconstruction)
+	 * @param Node The indexed node
+	 * @return True if the node has exactly the indexed pins, in order
+	 */
+	bool IsUpToDate(const UEdGraphNode* Node) const;
+
+	/**
+	 * Find a pin by name; the first pin with the name wins
+	 * @param PinName The pin name
+	 * @return The pin, or nullptr if the node has no pin with that name
+	 */
+	UEdGraphPin* FindPin(FName PinName) const;
+
+	/**
+	 * Find a pin by direction and name
+	 * @param PinName The pin name
+	 * @param Direction The pin direction
+	 * @return The pin, or nullptr if the node has no such pin
+	 */
+	UEdGraphPin* FindPin(FName PinName, EEdGraphPinDirection Direction) const;
+
+	/**
+	 * Get a pin by its index among the node's non-null pins (the serialized pin index)
+	 * @param PinIndex The pin index
+	 * @return The pin, or nullptr if out of range
+	 */
+	UEdGraphPin* GetPin(int32 PinIndex) const
+	{
+		return Pins.IsValidIndex(PinIndex) ? Pins[PinIndex] : nullptr;
+	}
+
+private:
+	/** Non-null pins in node order */
+	TArray<UEdGraphPin*> Pins;
+
+	TMap<FName, UEdGraphPin*> PinsByName;
+	TMap<FName, UEdGraphPin*> PinsByDirection[EGPD_MAX];
+};
+
+/**
+ * Per-call state of a graph deserialization. Owned by the call that deserializes, so several
+ * graphs can be deserialized independently without sharing lookup tables.
+ */
+struct FGraphDeserializeContext
+{
+	/**
+	 * Resolve the owning Blueprint and index the nodes already in the graph
+	 * @param InGraph The target graph
+	 * @param InDescription The graph description being deserialized (must outlive the context)
+	 * @param bIndexExistingNodes Fill ExistingNodesByGuid from every node of the graph; callers that
+	 *        resolve only the nodes they need (ApplyPatch) fill it themselves
+	 */
+	FGraphDeserializeContext(UEdGraph* InGraph, const FBlueprintGraphDescription& InDescription, bool bIndexExistingNodes = true);
+
+	/** The target graph */
+	UEdGraph* Graph;
+
+	/** Blueprint owning the target graph, nullptr for graphs outside a Blueprint */
+	UBlueprint* Blueprint;
+
+	/** The graph description being deserialized */
+	const FBlueprintGraphDescription& Description;
+
+	/** Node created for each entry of Description.Nodes (nullptr where creation failed); connections index into it */
+	TArray<UEdGraphNode*> CreatedNodes;
+
+	/** Pin index of each created node, parallel to CreatedNodes */
+	TArray<FGraphNodePinIndex> CreatedNodePins;
+
+	/** Nodes that were in the graph before deserialization, by NodeGuid (for a patch, only the nodes it names) */
+	TMap<FGuid, UEdGraphNode*> ExistingNodesByGuid;
+
+	/**
+	 * Bulk paste (see UnrealGraph.Paste.BulkThreshold): nodes are added without per-node graph notifications,
+	 * undo records one graph snapshot instead of every node, and the editor is refreshed once at the end
+	 */
+	bool bBulkMode = false;
+};
+
+/**
+ * Per-call switches of a graph deserialization
+ */
+struct FGraphDeserializeOptions
+{
+	/**
+	 * Use bulk mode whatever the node count (see FGraphDeserializeContext::bBulkMode); callers without
+	 * an editor UI to refresh (e.g., batch import) set it instead of lowering UnrealGraph.Paste.BulkThreshold
+	 */
+	bool bForceBulkMode = false;
+};
+
+/**
+ * What one graph deserialization created, for callers that report per-graph results (e.g., batch import)
+ */
+struct FGraphDeserializeStats
+{
+	int32 NodesCreated = 0;
+	int32 NodesFailed = 0;
+	int32 ConnectionsCreated = 0;
+	int32 ConnectionsFailed = 0;
+};
 
 /**
  * Deserializes JSON format back to Blueprint graphs
  */
-class FBlueprintGraphDeserializer
+class UNREALGRAPH_API FBlueprintGraphDeserializer
 {
 public:
 	/**
@@ -23,20 +147,72 @@ public:
 	static bool DeserializeGraph(UEdGraph* Graph, const TSharedPtr<FJsonObject>& JsonData);
 
 	/**
-	 * Create a node from JSON data
-	 * @param Graph The graph to add the node to
-	 * @param NodeData The JSON object containing node data
+	 * Deserialize JSON text into a Blueprint graph without building a FJsonObject tree.
+	 * The text is read token by token into a FBlueprintGraphDescription, which node creation consumes.
+	 * @param Graph The target graph to populate
+	 * @param JsonText The JSON text (e.g., clipboard content)
+	 * @return True if deserialization succeeded, false otherwise
+	 */
+	static bool DeserializeGraphFromString(UEdGraph* Graph, const FString& JsonText);
+
+	/**
+	 * Deserialize a graph stored in the compact binary format (see FBlueprintGraphBinaryFormat)
+	 * @param Graph The target graph to populate
+	 * @param Bytes The encoded graph
+	 * @return True if deserialization succeeded, false otherwise
+	 */
+	static bool DeserializeGraphFromBinary(UEdGraph* Graph, TArrayView<const uint8> Bytes);
+
+	/**
+	 * Deserialize a graph description into a Blueprint graph
+	 * @param Graph The target graph to populate
+	 * @param Description The graph description
+	 * @param OutStats Optional, receives the created and failed node and connection counts
+	 * @param Options Per-call switches (e.g., forced bulk mode)
+	 * @return True if deserialization succeeded, false otherwise
+	 */
+	static bool DeserializeGraph(UEdGraph* Graph, const FBlueprintGraphDescription& Description, FGraphDeserializeStats* OutStats = nullptr, const FGraphDeserializeOptions& Options = FGraphDeserializeOptions());
+
+	/**
+	 * Apply a patch (see FBlueprintGraphDiff) in one transaction. Only the nodes and links the patch
+	 * names are touched: links are broken, nodes removed, moved and given new defaults, then the added
+	 * nodes are created and the added links made. Added nodes keep their patch id as NodeGuid when it is
+	 * a GUID not used in the graph, so later diffs against this graph match them.
+	 * @param Graph The graph the patch was computed against
+	 * @param Patch The patch
+	 * @return True if the patch was applied (nodes or links that cannot be found are logged and skipped)
+	 */
+	static bool ApplyPatch(UEdGraph* Graph, const FBlueprintGraphPatch& Patch);
+
+	/**
+	 * Read a patch document and apply it (see ApplyPatch)
+	 * @param Graph The graph the patch was computed against
+	 * @param PatchJson The patch JSON text
+	 * @return True if the patch was read and applied
+	 */
+	static bool ApplyPatchFromString(UEdGraph* Graph, const FString& PatchJson);
+
+	/**
+	 * Drop the node indices ApplyPatch keeps between patches and unregister their graph change handlers.
+	 * Called on module shutdown, so no graph keeps a handler into unloaded code.
+	 */
+	static void ResetPatchNodeIndices();
+
+	/**
+	 * Create a node from its description
+	 * @param Context The deserialization state (target graph, description)
+	 * @param NodeDescription The node to create
+	 * @param OutPins Receives the pin index of the created node
 	 * @return The created node, or nullptr if creation failed
 	 */
-	static UEdGraphNode* CreateNodeFromJson(UEdGraph* Graph, const TSharedPtr<FJsonObject>& NodeData);
+	static UEdGraphNode* CreateNode(const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, FGraphNodePinIndex& OutPins);
 
 	/**
-	 * Create connections from JSON data
-	 * @param Graph The graph containing the nodes
-	 * @param ConnectionsArray The JSON array containing connection data
+	 * Create the connections of a graph description
+	 * @param Context The deserialization state, with CreatedNodes filled in
 	 * @return Number of successfully created connections
 	 */
-	static int32 CreateConnectionsFromJson(UEdGraph* Graph, const TArray<TSharedPtr<FJsonValue>>& ConnectionsArray);
+	static int32 CreateConnections(const FGraphDeserializeContext& Context);
 
 	/**
 	 * Validate JSON schema
@@ -47,49 +223,101 @@ public:
 
 private:
 	/**
-	 * Find a node by its ID
-	 * @param Graph The graph to search in
+	 * Find a node that was in the graph before deserialization by its ID (node GUID)
+	 * @param Context The deserialization state holding the existing-node index
 	 * @param NodeId The ID of the node to find
 	 * @return The found node, or nullptr if not found
 	 */
-	static UEdGraphNode* FindNodeById(UEdGraph* Graph, const FString& NodeId);
+	static UEdGraphNode* FindNodeById(const FGraphDeserializeContext& Context, const FString& NodeId);
+
+	/**
+	 * Record the existing nodes that id-form connection endpoints will link to in the open transaction.
+	 * Used in bulk mode, where per-node undo recording is suspended while nodes are created and wired.
+	 * @param Context The deserialization state
+	 */
+	static void ModifyExistingEndpointNodes(const FGraphDeserializeContext& Context);
+
+	/**
+	 * Find the pin a connection endpoint refers to, logging what could not be found
+	 * @param Context The deserialization state
+	 * @param Endpoint The connection endpoint
+	 * @return The pin, or nullptr if the node or pin could not be found
+	 */
+	static class UEdGraphPin* ResolveConnectionEndpoint(const FGraphDeserializeContext& Context, const FBlueprintGraphConnectionEndpoint& Endpoint);
 
 	/**
-	 * Find a pin by name on a node
+	 * Find a pin by name on a node (FName comparison) without building an index, for one-off lookups
 	 * @param Node The node to search
 	 * @param PinName The name of the pin
 	 * @return The found pin, or nullptr if not found
 	 */
 	static class UEdGraphPin* FindPinByName(UEdGraphNode* Node, const FString& PinName);
 
+	/**
+	 * Find a pin by name on a node, preferring a pin of the given direction when several share the name
+	 * @param Node The node to search
+	 * @param PinName The name of the pin
+	 * @param Direction The preferred direction
+	 * @return The found pin, or nullptr if not found
+	 */
+	static class UEdGraphPin* FindPinByName(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction);
+
 	/**
 	 * Map JSON node type name to UClass
 	 * @param NodeTypeName The class name from JSON (e.g., "K2Node_Event")
+	 * @param ClassPath Optional full class path from JSON (e.g., "/Script/BlueprintGraph.K2Node_Event")
 	 * @return The UClass for that node type, or nullptr if not found
 	 */
-	static UClass* GetNodeClassFromTypeName(const FString& NodeTypeName);
+	static UClass* GetNodeClassFromTypeName(const FString& NodeTypeName, const FString& ClassPath = FString());
 
 	/**
-	 * Set node position from JSON data
+	 * Set node position from its description
 	 * @param Node The node to set position for
-	 * @param NodeData The JSON object containing position data
+	 * @param NodeDescription The node description containing position data
 	 */
-	static void SetNodePosition(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData);
+	static void SetNodePosition(UEdGraphNode* Node, const FBlueprintGraphNodeDescription& NodeDescription);
 
 	/**
 	 * Configure node-specific properties before allocating pins
 	 * @param Node The node to configure
-	 * @param NodeData The JSON object containing node data
-	 * @param Graph The graph the node belongs to
+	 * @param Context The deserialization state (graph, owning Blueprint, description)
+	 * @param NodeDescription The node description
 	 * @return True if configuration succeeded
 	 */
-	static bool ConfigureNodeProperties(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData, UEdGraph* Graph);
+	static bool ConfigureNodeProperties(UEdGraphNode* Node, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription);
+
+	/**
+	 * Apply a serialized "memberReference" (name, parent class path, GUID, self context) to a node.
+	 * The owner class is resolved with a single FindObject, and the member must exist on it by name or GUID.
+	 * Legacy payloads without the field, and members the target does not have, return false so the caller
+	 * falls back to name-based lookup (which warns when that fails too).
+	 * @param Node The node to configure
+	 * @param ReferencePropertyName Name of the FMemberReference property (e.g., "FunctionReference")
+	 * @param Context The deserialization state (self-context members resolve against its Blueprint)
+	 * @param NodeDescription The node description
+	 * @param bIsFunction True for function and event references, false for variable references
+	 * @return True if the reference was resolved and applied
+	 */
+	static bool ApplyMemberReference(UEdGraphNode* Node, FName ReferencePropertyName, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, bool bIsFunction);
+
+	/**
+	 * Resolve the variable of a VariableGet/VariableSet node and set its VariableReference
+	 * @param Node The variable node to configure
+	 * @param Title The node title, used when the JSON has no explicit variableName
+	 * @param TitlePrefix Prefix stripped from the title (e.g., "Get ")
+	 * @param Context The deserialization state (variables are looked up on its Blueprint)
+	 * @param NodeDescription The node description
+	 * @return True if the variable was found and the reference was set
+	 */
+	static bool ConfigureVariableReference(UEdGraphNode* Node, const FString& Title, const TCHAR* TitlePrefix, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription);
 
 	/**
-	 * Restore pin default values from JSON
+	 * Restore pin default values from the node description
 	 * @param Node The node to restore pin values for
-	 * @param NodeData The JSON object containing pin data
+	 * @param Context The deserialization state
+	 * @param NodeDescription The node description containing pin data
+	 * @param Pins The pin index of the node
 	 */
-	static void RestorePinDefaultValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& NodeData);
+	static void RestorePinDefaultValues(UEdGraphNode* Node, const FGraphDeserializeContext& Context, const FBlueprintGraphNodeDescription& NodeDescription, const FGraphNodePinIndex& Pins);
 };
 
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintGraphDescription;
+struct FBlueprintGraphPatch;
+
+/**
+ * Structural diff of two serialized graphs, keyed by node id (node GUID), and the patch document it produces.
+ * The patch is applied with FBlueprintGraphDeserializer::ApplyPatch.
+ *
+ * Patch JSON:
+ *   {
+ *     "patch": { "version": "1.0" },
+ *     "added": <graph document with the added and replaced nodes and the links to add>,
+ *     "removedNodes": [ "<id>", ... ],
+ *     "movedNodes": [ [ "<id>", x, y ], ... ],
+ *     "changedDefaults": [ [ "<id>", "<pin>", "input" | "output", "<value>" | null ], ... ],
+ *     "removedLinks": [ [ "<from id>", "<from pin>", "<to id>", "<to pin>" ], ... ]
+ *   }
+ * Empty sections are omitted. Links in "added" use the connection encoding of graph documents: a node
+ * index refers to an added node, a string to a node already in the graph.
+ */
+class FBlueprintGraphDiff
+{
+public:
+	/** Patch format version written by WritePatchJson */
+	static const TCHAR* const PatchVersion;
+
+	/**
+	 * Compute the changes that turn one graph description into another.
+	 * Nodes are matched by id; a matched node whose type, member or pin layout differs is replaced,
+	 * otherwise its position and pin defaults are compared. Links are matched by node id and pin name.
+	 * @param Base The description of the graph as it is
+	 * @param Target The description of the graph as it should be
+	 * @param OutPatch Receives the changes
+	 */
+	static void Diff(const FBlueprintGraphDescription& Base, const FBlueprintGraphDescription& Target, FBlueprintGraphPatch& OutPatch);
+
+	/**
+	 * Diff two graph JSON documents (FBlueprintGraphSerializer output) into patch JSON
+	 * @param BaseJson The graph as it is
+	 * @param TargetJson The graph as it should be
+	 * @param OutPatchJson Receives the patch document
+	 * @param OutError Receives a description of the problem when either document is invalid
+	 * @param bPrettyPrint Whether to format the patch nicely
+	 * @return True if both documents were read and the patch was written
+	 */
+	static bool DiffJson(const FString& BaseJson, const FString& TargetJson, FString& OutPatchJson, FString& OutError, bool bPrettyPrint = true);
+
+	/**
+	 * Write a patch document
+	 * @param Patch The patch
+	 * @param OutJson Receives the JSON text
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the patch was written
+	 */
+	static bool WritePatchJson(const FBlueprintGraphPatch& Patch, FString& OutJson, bool bPrettyPrint = true);
+
+	/**
+	 * Read a patch document
+	 * @param PatchJson The JSON text
+	 * @param OutPatch Receives the patch
+	 * @param OutError Receives a description of the problem when the document is invalid
+	 * @return True if the text is a valid patch
+	 */
+	static bool ReadPatchJson(const FString& PatchJson, FBlueprintGraphPatch& OutPatch, FString& OutError);
+};
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+struct FBlueprintGraphDescription;
+
+/**
+ * Reads graph JSON into a FBlueprintGraphDescription in a single pass over TJsonReader tokens,
+ * without building a FJsonObject tree, or in a single walk over a tree a caller already holds.
+ * Both share one field mapping. Schema checks (graph object, node id/type, connection
+ * endpoints) are applied while reading. Schema 1.0 connection objects are converted to the
+ * index form of FBlueprintGraphConnectionDescription.
+ */
+class FBlueprintGraphJsonReader
+{
+public:
+	/**
+	 * Read graph JSON text
+	 * @param JsonText The JSON text (e.g., clipboard content)
+	 * @param OutDescription Receives the graph description
+	 * @param OutError Receives a description of the problem when reading fails
+	 * @return True if the text is valid graph JSON
+	 */
+	static bool ReadGraph(const FString& JsonText, FBlueprintGraphDescription& OutDescription, FString& OutError);
+
+	/**
+	 * Read an already parsed JSON object (DOM callers), walking the object directly
+	 * @param JsonData The JSON object containing graph data
+	 * @param OutDescription Receives the graph description
+	 * @param OutError Receives a description of the problem when reading fails
+	 * @return True if the object is valid graph JSON
+	 */
+	static bool ReadGraph(const TSharedPtr<FJsonObject>& JsonData, FBlueprintGraphDescription& OutDescription, FString& OutError);
+};
@@ -17,6 +17,21 @@ public:
 	 */
 	static FString GetCurrentSchemaVersion();
 
+	/**
+	 * Get the version of multi-graph Blueprint documents (FBlueprintGraphSerializer::SerializeBlueprint).
+	 * 3.0: graph, node and pin string fields are indices into the top-level "strings" array;
+	 * connections are schema 2.0 tuples.
+	 * @return Blueprint document version string
+	 */
+	static FString GetBlueprintSchemaVersion();
+
+	/**
+	 * Get the major schema version of a payload from metadata.version
+	 * @param JsonData The JSON object to inspect
+	 * @return Major version, 1 when the payload carries no version
+	 */
+	static int32 GetSchemaMajorVersion(const TSharedPtr<FJsonObject>& JsonData);
+
 	/**
 	 * Validate JSON against the schema
 	 * @param JsonData The JSON object to validate
@@ -25,9 +40,12 @@ public:
 	static bool ValidateJson(const TSharedPtr<FJsonObject>& JsonData);
 
 	/**
-	 * Migrate JSON from an older schema version
+	 * Migrate JSON from an older schema version.
+	 * 1 -> 2: from/to connection objects become [fromNode, fromPin, toNode, toPin] index tuples and
+	 * pin "connectedNodeIds" arrays are dropped. Endpoints outside the document keep their node id
+	 * and pin name strings. JsonData is replaced with a new object; the original is not modified.
 	 * @param JsonData The JSON object to migrate
-	 * @param FromVersion The version to migrate from
+	 * @param FromVersion The major version to migrate from
 	 * @return True if migration succeeded
 	 */
 	static bool MigrateJson(TSharedPtr<FJsonObject>& JsonData, int32 FromVersion);
@@ -49,8 +67,20 @@ private:
 	static bool ValidateNode(const TSharedPtr<FJsonObject>& NodeObject);
 
 	/**
-	 * Validate connection structure
+	 * Validate connection structure (schema 1.0 from/to object)
 	 */
 	static bool ValidateConnection(const TSharedPtr<FJsonObject>& ConnectionObject);
+
+	/**
+	 * Validate a [fromNode, fromPin, toNode, toPin] connection tuple
+	 * @param Tuple The tuple elements
+	 * @param NodePinCounts Number of pins of each node in the document, for range checks
+	 */
+	static bool ValidateConnectionTuple(const TArray<TSharedPtr<FJsonValue>>& Tuple, const TArray<int32>& NodePinCounts);
+
+	/**
+	 * Convert schema 1.0 connections and pins of a graph object to schema 2.0
+	 */
+	static TSharedPtr<FJsonObject> MigrateGraphToVersion2(const TSharedPtr<FJsonObject>& GraphObject);
 };
 
@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UClass;
+class UFunction;
+class UEdGraphNode;
+class FProperty;
+
+/**
+ * How a node class exposes its position, resolved once per class
+ */
+enum class ENodePositionAccessorKind : uint8
+{
+	/** No position property could be found */
+	None,
+	/** UEdGraphNode::NodePosX / NodePosY read directly */
+	EdGraphNodeMembers,
+	/** A Vector2D property named NodePos, NodePosition, Position or Pos */
+	Vector2DProperty,
+	/** Separate integer X/Y properties */
+	IntXYProperties,
+	/** Separate float X/Y properties */
+	FloatXYProperties,
+	/** Any Vector2D property whose name contains Pos/Position (value must be non-zero) */
+	Vector2DScan
+};
+
+/**
+ * Resolved position accessor for a node class
+ */
+struct FNodePositionAccessor
+{
+	ENodePositionAccessorKind Kind = ENodePositionAccessorKind::None;
+
+	/** Vector2D property, or the X property for the XY kinds */
+	const FProperty* PropertyX = nullptr;
+
+	/** Y property for the XY kinds */
+	const FProperty* PropertyY = nullptr;
+
+	/**
+	 * Read the position of a node using this accessor
+	 * @param Node The node to read from (must be an instance of the class this accessor was resolved for)
+	 * @param OutPosition Receives the node position
+	 * @return True if a position was found
+	 */
+	bool Read(const UEdGraphNode* Node, FVector2D& OutPosition) const;
+};
+
+/**
+ * Session-wide cache of reflection lookups used by the serializer and deserializer.
+ * Entries are built lazily on first use and dropped on hot reload. A Blueprint compile drops the
+ * per-class member caches; loaded and recompiled Blueprint classes are re-indexed one class at a time.
+ */
+class FBlueprintGraphReflectionCache
+{
+public:
+	/**
+	 * Register invalidation hooks (hot reload, module changes, asset load, Blueprint compile)
+	 */
+	static void Startup();
+
+	/**
+	 * Unregister invalidation hooks and clear all cached data
+	 */
+	static void Shutdown();
+
+	/**
+	 * Drop every cached entry; they will be rebuilt on demand
+	 */
+	static void Invalidate();
+
+	/**
+	 * Drop the entries that depend on the set of loaded classes (module load/unload)
+	 */
+	static void InvalidateClassIndices();
+
+	/**
+	 * Drop the per-class member lookups (position accessors, class properties), which a Blueprint compile changes
+	 */
+	static void InvalidateMemberCaches();
+
+	/**
+	 * Get the position accessor for a node class, resolving it on first use
+	 * @param NodeClass The node class
+	 * @return Cached accessor for the class
+	 */
+	static const FNodePositionAccessor& GetPositionAccessor(const UClass* NodeClass);
+
+	/**
+	 * Find a UEdGraphNode subclass by short name (e.g. "K2Node_CallFunction").
+	 * The name index is built from the class hash on first use and rebuilt only after
+	 * module load/unload or hot reload, so misses never trigger another scan.
+	 * @param ClassName Short class name
+	 * @return The node class, or nullptr if no loaded node class has that name
+	 */
+	static UClass* FindNodeClass(FName ClassName);
+
+	/**
+	 * Find the preferred function with a given name across all loaded classes.
+	 * Candidates are ranked: UKismetSystemLibrary, other function libraries, static functions,
+	 * Blueprint-callable functions, other native functions, then Blueprint-generated functions.
+	 * Unresolved names are remembered so repeated misses cost a single lookup, until a class loaded or
+	 * compiled later declares the name.
+	 * @param FunctionName The function name (e.g., "PrintString")
+	 * @return The best ranked function, or nullptr if no loaded class declares it
+	 */
+	static UFunction* FindFunction(FName FunctionName);
+
+	/**
+	 * Get every function with a given name, best ranked first
+	 * @param FunctionName The function name
+	 * @param OutCandidates Receives the live candidates
+	 */
+	static void GetFunctionCandidates(FName FunctionName, TArray<UFunction*>& OutCandidates);
+
+	/**
+	 * Find a property by name on a class, including inherited properties.
+	 * Results (misses included) are cached per (class, name) until the next Blueprint compile or hot reload.
+	 * @param Class The class to search; may be nullptr
+	 * @param PropertyName The property name (e.g., a Blueprint variable name)
+	 * @return The property, or nullptr if the class has none with that name
+	 */
+	static FProperty* FindClassProperty(const UClass* Class, FName PropertyName);
+
+	/**
+	 * Get a FMemberReference property value on a node (FunctionReference, VariableReference, EventReference)
+	 * @param Node The node owning the reference
+	 * @param ReferencePropertyName Name of the struct property
+	 * @return Pointer into the node, or nullptr if the node has no such FMemberReference property
+	 */
+	static struct FMemberReference* FindMemberReference(UEdGraphNode* Node, FName ReferencePropertyName);
+
+private:
+	/**
+	 * Index every function declared by a loaded class by name
+	 */
+	static void BuildFunctionIndex();
+
+	/**
+	 * Build the function index, or re-index the classes queued since it was built
+	 */
+	static void UpdateFunctionIndex();
+
+	/**
+	 * Add the functions a class declares to the function index
+	 * @param Class The class; stale and intermediate Blueprint classes are skipped
+	 * @param OutIndexedNames Receives the names of the functions added
+	 */
+	static void IndexClassFunctions(UClass* Class, TSet<FName>& OutIndexedNames);
+
+	/**
+	 * Drop unloaded functions and order the rest by rank
+	 */
+	static void SortFunctionCandidates(TArray<TWeakObjectPtr<UFunction>>& Candidates);
+
+	/**
+	 * Queue a loaded class, or a Blueprint about to compile, for re-indexing on the next function lookup
+	 * @param ClassOrBlueprint A UClass or a UBlueprint (its generated class is indexed)
+	 */
+	static void QueueFunctionOwner(UObject* ClassOrBlueprint);
+
+	/**
+	 * Ranking used to order functions sharing a name (lower is preferred)
+	 */
+	static int32 GetFunctionRank(const UFunction* Function);
+
+	/**
+	 * Index every loaded UEdGraphNode subclass by name
+	 */
+	static void BuildNodeClassIndex();
+
+	/**
+	 * Probe a class for its position properties
+	 * @param NodeClass The class to probe
+	 * @return The resolved accessor
+	 */
+	static FNodePositionAccessor ResolvePositionAccessor(const UClass* NodeClass);
+
+	/** Register the Blueprint compile hook once GEditor exists */
+	static void RegisterEditorHooks();
+
+	static TMap<const UClass*, FNodePositionAccessor> PositionAccessors;
+
+	/** Cached class property lookup; the weak class pointer guards against a recycled class address */
+	struct FClassPropertyEntry
+	{
+		TWeakObjectPtr<const UClass> Class;
+		FProperty* Property = nullptr;
+	};
+	static TMap<TPair<const UClass*, FName>, FClassPropertyEntry> ClassProperties;
+
+	static TMap<FName, TWeakObjectPtr<UClass>> NodeClassIndex;
+	static bool bNodeClassIndexBuilt;
+
+	static TMap<FName, TArray<TWeakObjectPtr<UFunction>>> FunctionIndex;
+	static TSet<FName> MissedFunctionNames;
+	static bool bFunctionIndexBuilt;
+
+	/** Function names each indexed Blueprint class contributed, so re-indexing it can drop the stale ones */
+	static TMap<TWeakObjectPtr<UClass>, TArray<FName>> BlueprintClassFunctionNames;
+
+	/** Classes and Blueprints loaded or compiled since the function index was built */
+	static TArray<TWeakObjectPtr<UObject>> PendingFunctionOwners;
+
+	static FDelegateHandle ReloadCompleteHandle;
+	static FDelegateHandle BlueprintCompiledHandle;
+	static FDelegateHandle BlueprintPreCompileHandle;
+	static FDelegateHandle AssetLoadedHandle;
+	static FDelegateHandle ModulesChangedHandle;
+	static FDelegateHandle PostEngineInitHandle;
+};
@@ -8,12 +8,38 @@
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
 
+struct FBlueprintGraphDescription;
+struct FBlueprintGraphNodeDescription;
+struct FBlueprintGraphConnectionDescription;
+struct FBlueprintDescription;
+struct FBlueprintGraphNodeHashes;
+struct FBlueprintHashes;
+class UBlueprint;
+
+/**
+ * Direction in which CollectReachableNodes follows links
+ */
+enum class EBlueprintGraphReachDirection : uint8
+{
+	/** From output pins to the nodes they feed (e.g., everything downstream of an event) */
+	Forward,
+
+	/** From input pins to the nodes feeding them (e.g., everything a node depends on) */
+	Backward
+};
+
 /**
  * Serializes Blueprint graphs to JSON format
  */
-class FBlueprintGraphSerializer
+class UNREALGRAPH_API FBlueprintGraphSerializer
 {
 public:
+	/**
+	 * Version of the serializer output. Bump whenever the same Blueprint would export differently
+	 * (new fields, changed titles or ordering) without a schema version change; cached exports are keyed on it.
+	 */
+	static constexpr int32 OutputVersion = 1;
+
 	/**
 	 * Serialize an entire Blueprint graph to JSON
 	 * @param Graph The graph to serialize
@@ -42,6 +68,158 @@ public:
 	 */
 	static TArray<TSharedPtr<FJsonValue>> SerializeConnections(UEdGraph* Graph);
 
+	/**
+	 * Serialize a graph to a JSON string with the writer selected by UnrealGraph.Serialize.Streaming
+	 * @param Graph The graph to serialize
+	 * @param OutJson Receives the JSON text
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the graph was serialized
+	 */
+	static bool SerializeGraphToString(UEdGraph* Graph, FString& OutJson, bool bPrettyPrint = true);
+
+	/**
+	 * Serialize a graph straight to JSON text in one pass, without building a FJsonObject DOM.
+	 * Output is byte-identical to JsonToString(SerializeGraph(Graph), bPrettyPrint).
+	 * @param Graph The graph to serialize
+	 * @param OutJson Receives the JSON text
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the graph was serialized
+	 */
+	static bool WriteGraphJson(UEdGraph* Graph, FString& OutJson, bool bPrettyPrint = true);
+
+	/**
+	 * Same as WriteGraphJson, encoding directly to a UTF-8 buffer (e.g., for writing to disk)
+	 * @param Graph The graph to serialize
+	 * @param OutUtf8 Receives the UTF-8 JSON bytes (no BOM, no terminator)
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the graph was serialized
+	 */
+	static bool WriteGraphJsonUtf8(UEdGraph* Graph, TArray<uint8>& OutUtf8, bool bPrettyPrint = true);
+
+	/**
+	 * Capture a graph as a FBlueprintGraphDescription holding the same fields as the JSON output
+	 * @param Graph The graph to describe
+	 * @param OutDescription Receives the description
+	 * @return True if the graph was described
+	 */
+	static bool DescribeGraph(UEdGraph* Graph, FBlueprintGraphDescription& OutDescription);
+
+	/**
+	 * Capture some nodes of a graph (e.g., the editor selection) with the links among them.
+	 * Only these nodes are visited, so the cost follows the number of nodes, not the size of their graph.
+	 * @param Nodes Distinct nodes of one graph, written in this order; null entries are skipped
+	 * @param bIncludeBoundaryLinks Also keep links between these nodes and the rest of the graph,
+	 *        with the outside end written as node id and pin name (reconnected on paste into the same graph)
+	 * @param OutDescription Receives the description
+	 * @return True if the nodes were described
+	 */
+	static bool DescribeNodes(const TArray<UEdGraphNode*>& Nodes, bool bIncludeBoundaryLinks, FBlueprintGraphDescription& OutDescription);
+
+	/**
+	 * Serialize some nodes of a graph (see DescribeNodes) to a graph JSON document
+	 * @param Nodes Distinct nodes of one graph
+	 * @param OutJson Receives the JSON text
+	 * @param bIncludeBoundaryLinks Also keep links to nodes outside the set
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the nodes were serialized
+	 */
+	static bool SerializeNodesToString(const TArray<UEdGraphNode*>& Nodes, FString& OutJson, bool bIncludeBoundaryLinks = false, bool bPrettyPrint = true);
+
+	/**
+	 * Collect the nodes reachable from some root nodes by following pin links in one direction.
+	 * Only reachable nodes are visited, so the cost follows the size of the result, not of the graph.
+	 * @param Roots The nodes to start from; they are part of the result
+	 * @param Direction Follow links from output pins (Forward) or from input pins (Backward)
+	 * @param bFollowExec Follow links of exec pins
+	 * @param bFollowData Follow links of data (non-exec) pins
+	 * @param OutNodes Receives the roots and the reachable nodes, in breadth-first order
+	 */
+	static void CollectReachableNodes(const TArray<UEdGraphNode*>& Roots, EBlueprintGraphReachDirection Direction, bool bFollowExec, bool bFollowData, TArray<UEdGraphNode*>& OutNodes);
+
+	/**
+	 * Serialize the nodes reachable from some root nodes (see CollectReachableNodes) to a graph JSON document
+	 * @param Roots The nodes to start from
+	 * @param Direction Follow links from output pins (Forward) or from input pins (Backward)
+	 * @param bFollowExec Follow links of exec pins
+	 * @param bFollowData Follow links of data (non-exec) pins
+	 * @param OutJson Receives the JSON text
+	 * @param bIncludeBoundaryLinks Also keep links to nodes that were not reached
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the nodes were serialized
+	 */
+	static bool SerializeReachableToString(const TArray<UEdGraphNode*>& Roots, EBlueprintGraphReachDirection Direction, bool bFollowExec, bool bFollowData,
+		FString& OutJson, bool bIncludeBoundaryLinks = false, bool bPrettyPrint = true);
+
+	/**
+	 * Serialize a graph to the compact binary format (see FBlueprintGraphBinaryFormat)
+	 * @param Graph The graph to serialize
+	 * @param OutBytes Receives the encoded graph
+	 * @return True if the graph was serialized
+	 */
+	static bool SerializeGraphToBinary(UEdGraph* Graph, TArray<uint8>& OutBytes);
+
+	/**
+	 * Write a graph description as JSON text in the same field order as WriteGraphJson.
+	 * Absent fields are left out, so a description read from serializer output is written back unchanged.
+	 * Large descriptions (see ShouldEncodeInParallel) have their nodes encoded on worker threads; the output is the same.
+	 * @param Description The description to write
+	 * @param OutJson Receives the JSON text
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the JSON was written
+	 */
+	static bool WriteDescriptionJson(const FBlueprintGraphDescription& Description, FString& OutJson, bool bPrettyPrint = true);
+
+	/**
+	 * Serialize every graph of a Blueprint into one JSON document: event graphs, functions, macros,
+	 * delegate signatures, interface implementations and the collapsed sub-graphs of each.
+	 * The graphs share one string table while being described, and are encoded in parallel.
+	 * Nodes, graphs and the metadata carry content and layout hashes (see FBlueprintGraphContentHash).
+	 * Each distinct graph, node and pin string is written once to "strings"; those fields hold its index
+	 * (see FBlueprintGraphJsonSchema::GetBlueprintSchemaVersion).
+	 * @param Blueprint The Blueprint to serialize
+	 * @param OutJson Receives the JSON text ({"metadata": {...}, "strings": [...], "graphs": [{"name", "kind", "parentGraph", "contentHash", "layoutHash", "nodes", "connections"}]})
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @return True if the Blueprint was serialized
+	 */
+	static bool SerializeBlueprint(UBlueprint* Blueprint, FString& OutJson, bool bPrettyPrint = true);
+
+	/**
+	 * Capture every graph of a Blueprint (see SerializeBlueprint) as one description
+	 * @param Blueprint The Blueprint to describe
+	 * @param OutDescription Receives the description
+	 * @return True if the Blueprint was described
+	 */
+	static bool DescribeBlueprint(UBlueprint* Blueprint, FBlueprintDescription& OutDescription);
+
+	/**
+	 * Write a Blueprint description as JSON text, encoding and hashing its graphs on worker threads
+	 * @param Description The description to write
+	 * @param OutJson Receives the JSON text
+	 * @param bPrettyPrint Whether to format the JSON nicely
+	 * @param OutHashes Optional, receives the hashes written to the document
+	 * @return True if the JSON was written
+	 */
+	static bool WriteBlueprintDescriptionJson(const FBlueprintDescription& Description, FString& OutJson, bool bPrettyPrint = true, FBlueprintHashes* OutHashes = nullptr);
+
+	/**
+	 * Whether SerializeGraphToString uses the streaming writer (UnrealGraph.Serialize.Streaming)
+	 */
+	static bool IsStreamingWriterEnabled();
+
+	/**
+	 * Whether a graph is large enough to be encoded in parallel (UnrealGraph.Serialize.ParallelMinNodes).
+	 * Parallel encoding snapshots the graph with DescribeGraph on the calling thread, then encodes the
+	 * description in chunks on worker threads and joins the chunks in node order.
+	 * @param NumNodes Number of nodes in the graph
+	 * @return True if the graph should be encoded in parallel
+	 */
+	static bool ShouldEncodeInParallel(int32 NumNodes);
+
+	/**
+	 * Number of nodes encoded by one parallel task
+	 */
+	static int32 GetParallelEncodeChunkSize();
+
 	/**
 	 * Convert JSON object to string for output/logging
 	 * @param JsonObject The JSON object to convert
@@ -51,6 +229,34 @@ public:
 	static FString JsonToString(const TSharedPtr<FJsonObject>& JsonObject, bool bPrettyPrint = true);
 
 private:
+	/**
+	 * Append the nodes, pins and connections of a graph to a description; connection node
+	 * indices are relative to the graph's first node
+	 * @param Graph The graph to describe
+	 * @param OutDescription The description to append to
+	 */
+	static void AppendGraphDescription(UEdGraph* Graph, FBlueprintGraphDescription& OutDescription);
+
+	/**
+	 * Append nodes and their links to a description; connection node indices are relative to the first node
+	 * @param Nodes The nodes to describe (Graph->Nodes or a subset of it); null entries are skipped
+	 * @param bIncludeBoundaryLinks Keep links from these nodes to nodes outside the set, in the id/name form
+	 * @param bIncludeIncomingLinks Also keep links from nodes outside the set into these nodes (never
+	 *        needed for a whole graph, where every link has its output side in the graph)
+	 * @param OutDescription The description to append to
+	 */
+	template <typename NodeArrayType>
+	static void AppendNodesDescription(const NodeArrayType& Nodes, bool bIncludeBoundaryLinks, bool bIncludeIncomingLinks, FBlueprintGraphDescription& OutDescription);
+
+	/**
+	 * Append a graph and, recursively, its sub-graphs to a Blueprint description
+	 * @param Graph The graph to describe
+	 * @param Kind The graph kind written to "kind"
+	 * @param ParentGraph Index of the graph owning this sub-graph, INDEX_NONE for top-level graphs
+	 * @param OutDescription The description to append to
+	 */
+	static void AppendBlueprintGraph(UEdGraph* Graph, const TCHAR* Kind, int32 ParentGraph, FBlueprintDescription& OutDescription);
+
 	/**
 	 * Generate a unique ID for a node
 	 * @param Node The node to generate an ID for
@@ -71,5 +277,52 @@ private:
 	 * @param NodeObject The JSON object to add properties to
 	 */
 	static void SerializeNodeProperties(UEdGraphNode* Node, TSharedPtr<FJsonObject>& NodeObject);
+
+	/**
+	 * Serialize a FMemberReference as "memberReference" (name, parent class path, GUID, self context)
+	 * so the deserializer can resolve the member with a direct lookup
+	 * @param Reference The member reference to serialize
+	 * @param NodeObject The JSON object to add the reference to
+	 */
+	static void SerializeMemberReference(const struct FMemberReference& Reference, TSharedPtr<FJsonObject>& NodeObject);
+
+	/**
+	 * Streaming counterparts of SerializeGraph/SerializeNode/SerializePin, instantiated for
+	 * TJsonWriter with TCHAR or UTF8CHAR output and pretty or condensed print policies
+	 */
+	template <class WriterType>
+	static bool WriteGraph(UEdGraph* Graph, WriterType& Writer);
+
+	template <class WriterType>
+	static void WriteNode(UEdGraphNode* Node, WriterType& Writer);
+
+	template <class WriterType>
+	static void WritePin(UEdGraphPin* Pin, WriterType& Writer);
+
+	/**
+	 * Write a description; NodesJson, when given, is the already encoded "nodes" array
+	 */
+	template <class WriterType>
+	static bool WriteDescription(const FBlueprintGraphDescription& Description, WriterType& Writer, const FString* NodesJson = nullptr);
+
+	template <class WriterType>
+	static void WriteDescriptionConnection(const FBlueprintGraphDescription& Description, const FBlueprintGraphConnectionDescription& Connection, WriterType& Writer);
+
+	/**
+	 * Write a node object; Hashes, when given, are written as "contentHash" and "layoutHash".
+	 * StringReferences, when given, maps description strings to document string indices, which are written instead of the strings.
+	 */
+	template <class WriterType>
+	static void WriteDescriptionNode(const FBlueprintGraphDescription& Description, const FBlueprintGraphNodeDescription& Node, WriterType& Writer,
+		const FBlueprintGraphNodeHashes* Hashes = nullptr, const TArray<int32>* StringReferences = nullptr);
+
+	/**
+	 * WriteDescriptionJson with the node objects encoded on worker threads
+	 */
+	template <class PrintPolicy>
+	static bool WriteDescriptionJsonParallel(const FBlueprintGraphDescription& Description, FString& OutJson, bool bPrettyPrint);
+
+	template <class PrintPolicy>
+	static bool WriteBlueprintDescriptionJsonImpl(const FBlueprintDescription& Description, FString& OutJson, bool bPrettyPrint, FBlueprintHashes& OutHashes);
 };
 
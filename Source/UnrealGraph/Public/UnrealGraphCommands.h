@@ -19,5 +19,8 @@ public:
 	
 	/** Paste graph from JSON */
 	TSharedPtr<FUICommandInfo> PasteFromJSON;
+	
+	/** Copy every graph of the Blueprint as JSON */
+	TSharedPtr<FUICommandInfo> CopyBlueprintAsJSON;
 };
 
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+
+/**
+ * An exported Blueprint document as stored in the cache
+ */
+struct FCachedBlueprintExport
+{
+	/** Number of graphs in the document */
+	int32 NumGraphs = 0;
+
+	/** Number of nodes over all graphs */
+	int32 NumNodes = 0;
+
+	/** Content root of the document (see FBlueprintGraphContentHash) */
+	uint64 ContentHash = 0;
+
+	/** The document, UTF-8 encoded as written to disk */
+	TArray<uint8> Json;
+};
+
+/**
+ * Cache of exported Blueprint documents, so repeat exports of unchanged assets skip loading and encoding.
+ *
+ * Entries are keyed by content: the saved hash of the package and of the packages it hard-depends on
+ * (read from the asset registry, without loading anything), the binaries of the code modules behind its
+ * script dependencies and of this plugin, the schema, serializer output and cache versions, the engine
+ * build and the output format. Entries live in the Derived Data Cache, or in a local directory
+ * (Saved/UnrealGraph/ExportCache) when the DDC is not available.
+ *
+ * A cached document is returned with its exportDate restamped to the time of the hit.
+ *
+ * Purging deletes the local directory and starts a new cache generation, which is part of every key,
+ * so entries already in a shared DDC are no longer used by this machine (the DDC evicts them itself).
+ */
+class FUnrealGraphExportCache
+{
+public:
+	/** Bump when the layout of a cache entry changes (serializer output is versioned by FBlueprintGraphSerializer::OutputVersion) */
+	static constexpr int32 CacheVersion = 2;
+
+	/**
+	 * @param bAllowDDC Use the Derived Data Cache if available; false always uses the local directory
+	 */
+	explicit FUnrealGraphExportCache(bool bAllowDDC = true);
+
+	/**
+	 * Build the content key of an asset's export
+	 * @param AssetRegistry Registry holding the package data (the search must have completed)
+	 * @param PackageName The package of the Blueprint
+	 * @param bPrettyPrint Whether the export is pretty-printed
+	 * @param OutKey Receives the key
+	 * @return False if the package has no saved hash (e.g., never saved by this engine version); it cannot be cached
+	 */
+	static bool BuildKey(const IAssetRegistry& AssetRegistry, FName PackageName, bool bPrettyPrint, FString& OutKey);
+
+	/**
+	 * Fetch an export
+	 * @param Key The content key (see BuildKey)
+	 * @param OutExport Receives the export on a hit, with exportDate set to the current time
+	 * @return True on a cache hit
+	 */
+	bool Get(const FString& Key, FCachedBlueprintExport& OutExport);
+
+	/**
+	 * Store an export
+	 * @param Key The content key (see BuildKey)
+	 * @param Export The export to store
+	 */
+	void Put(const FString& Key, const FCachedBlueprintExport& Export);
+
+	/** @return True if entries are stored in the Derived Data Cache rather than the local directory */
+	bool IsUsingDDC() const { return bUseDDC; }
+
+	int32 GetNumHits() const { return NumHits; }
+	int32 GetNumMisses() const { return NumMisses; }
+
+	/**
+	 * Delete the local cache directory and start a new cache generation (see class comment)
+	 * @return True if the local directory was deleted and the new generation recorded
+	 */
+	static bool Purge();
+
+private:
+	/** Directory of the local cache and of the generation file */
+	static FString GetCacheDirectory();
+
+	/** The current cache generation, "0" until the cache is first purged */
+	static FString GetGeneration();
+
+	/** File of a local cache entry */
+	static FString GetLocalEntryPath(const FString& Key);
+
+	/** Full DDC key of an entry */
+	static FString GetDDCKey(const FString& Key);
+
+	/**
+	 * Identity of the code module behind a script package, so rebuilding game or plugin code changes the key
+	 * @param ModuleName The module (e.g., "Engine" for /Script/Engine)
+	 * @return Size and timestamp of the module binary, read once per process; empty if it has none (monolithic builds)
+	 */
+	static const FString& GetModuleStamp(FName ModuleName);
+
+	/**
+	 * Overwrite the exportDate of a cached document in place with the current time
+	 * @param Json The UTF-8 document
+	 */
+	static void RestampExportDate(TArray<uint8>& Json);
+
+	bool bUseDDC = false;
+	int32 NumHits = 0;
+	int32 NumMisses = 0;
+};
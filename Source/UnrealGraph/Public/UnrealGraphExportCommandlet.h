@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealGraphExportCommandlet.generated.h"
+
+/**
+ * Exports Blueprint assets to JSON without the editor UI, one file per asset (see FBlueprintGraphSerializer::SerializeBlueprint).
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=UnrealGraphExport -OutputDir=<dir> [options] -nullrhi -unattended
+ *   -Paths=/Game/A+/Game/B     Package paths to search, recursively (default /Game)
+ *   -Classes=<class path>+...  Asset classes to export, including subclasses (default /Script/Engine.Blueprint)
+ *   -ShardIndex=<i> -ShardCount=<n>
+ *                              Export only the assets of shard i of n. Assets are assigned by package name hash,
+ *                              so N processes given the same filters split the work without overlap.
+ *   -Report=<file>             Summary report with per-asset timings (default <OutputDir>/UnrealGraphExport_Shard<i>.json)
+ *   -Condensed                 Write condensed instead of pretty-printed JSON
+ *   -MaxInFlight=<n>           Packages loaded asynchronously ahead of the one being exported (default 16)
+ *   -MemoryCeilingMB=<mb>      When used physical memory exceeds this, loading pauses until the packages in flight
+ *                              are exported, then garbage is collected (default half of physical memory)
+ *   -NoCache                   Export every asset, ignoring the export cache (see FUnrealGraphExportCache)
+ *   -LocalCache                Keep the export cache in Saved/UnrealGraph/ExportCache instead of the Derived Data Cache
+ *   -PurgeCache                Purge the export cache before exporting
+ *
+ * Assets whose content key is cached are written from the cache without being loaded. The report counts cache hits, misses
+ * and uncacheable assets (no saved package hash, so no key); together they cover every asset when the cache is on.
+ * Files are written to <OutputDir>/<package path>.json. Returns 0 if every selected asset was exported.
+ */
+UCLASS()
+class UUnrealGraphExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealGraphExportCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
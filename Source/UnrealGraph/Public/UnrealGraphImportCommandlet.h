@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealGraphImportCommandlet.generated.h"
+
+/**
+ * Applies graph JSON (or binary graph) files to Blueprint assets without the editor UI (see FBlueprintGraphDeserializer).
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=UnrealGraphImport -Manifest=<file> [options] -nullrhi -unattended
+ *   -Report=<file>             Report with per-file node and connection counts (default <manifest dir>/UnrealGraphImport_Report.json)
+ *   -SaveBatch=<n>             Modified Blueprints saved together, followed by a garbage collection (default 50)
+ *   -NoSave                    Apply and compile, but do not save packages
+ *
+ * The manifest lists the files to apply and their target graphs; relative file paths are relative to the manifest:
+ *   { "entries": [ { "file": "Graphs/Door.json", "asset": "/Game/BP/BP_Door", "graph": "EventGraph" }, ... ] }
+ * "graph" names any graph of the Blueprint (function, macro, ...) and defaults to its first event graph.
+ * Entries are grouped by asset, so each Blueprint is loaded, compiled and saved once.
+ * Returns 0 if every file was applied and every touched Blueprint was compiled and saved.
+ */
+UCLASS()
+class UUnrealGraphImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealGraphImportCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -3,25 +3,78 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Misc/FileHelper.h"
-#include "HAL/PlatformFilemanager.h"
 #include "Misc/Paths.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FAutoConsoleVariableRef;
+class FUnrealGraphLogWriter;
+
+/**
+ * Verbosity levels for the UnrealGraph file log, from least to most detailed
+ */
+enum class EUnrealGraphLogLevel : uint8
+{
+	/** Nothing is written */
+	Off = 0,
+	/** Failures only */
+	Error = 1,
+	/** One line per graph operation (start, counts, completion) */
+	Summary = 2,
+	/** Per-node and per-connection diagnostics */
+	Verbose = 3,
+	/** Full property dumps and every resolution step */
+	Trace = 4
+};
+
+/**
+ * Highest level compiled into the binary. Calls above it are removed entirely.
+ * Override with PublicDefinitions in UnrealGraph.Build.cs (e.g. UNREALGRAPH_LOG_COMPILE_LEVEL=1).
+ */
+#ifndef UNREALGRAPH_LOG_COMPILE_LEVEL
+#define UNREALGRAPH_LOG_COMPILE_LEVEL 4
+#endif
+
+/** True if messages at Level are compiled in and enabled by UnrealGraph.LogLevel */
+#define UNREALGRAPH_LOG_ACTIVE(Level) \
+	(static_cast<int32>(EUnrealGraphLogLevel::Level) <= UNREALGRAPH_LOG_COMPILE_LEVEL && FUnrealGraphLogger::IsLevelEnabled(EUnrealGraphLogLevel::Level))
+
+/** Log a formatted message at Level. Format arguments are not evaluated when the level is disabled. */
+#define UNREALGRAPH_LOG(Level, Format, ...) \
+	do { if (UNREALGRAPH_LOG_ACTIVE(Level)) { FUnrealGraphLogger::LogFormatted(Format, ##__VA_ARGS__); } } while (0)
+
+/** Log a section header at Level. The section name is not evaluated when the level is disabled. */
+#define UNREALGRAPH_LOG_SECTION(Level, SectionName) \
+	do { if (UNREALGRAPH_LOG_ACTIVE(Level)) { FUnrealGraphLogger::LogSection(SectionName); } } while (0)
 
 /**
  * Logger utility for UnrealGraph plugin
- * Writes detailed logs to file for debugging and analysis
+ * Writes detailed logs to file for debugging and analysis.
+ * Use the UNREALGRAPH_LOG macros rather than calling Log/LogFormatted directly so that
+ * disabled levels cost nothing.
+ *
+ * Messages are pushed onto a lock-free MPSC queue and written by a background thread that
+ * keeps the log file open, so logging is safe from any thread. Queued memory is bounded by
+ * UnrealGraph.Log.MaxQueuedKB (excess messages are dropped and counted), files are rotated
+ * at UnrealGraph.Log.MaxFileSizeMB and only the newest UnrealGraph.Log.MaxFiles
+ * UnrealGraph_*.log files are kept.
  */
 class FUnrealGraphLogger
 {
 public:
 	/**
-	 * Initialize the logger - opens log file
-	 * @param LogFileName Name of the log file (without extension)
+	 * Begin a logging session. The log file is only created once something is logged.
+	 * Does nothing when UnrealGraph.LogLevel is Off. Sessions nest: while a session is open (e.g., a
+	 * commandlet run), inner sessions (each deserialized graph) log into it instead of opening their own file.
+	 * Every call must be paired with Shutdown. Safe from any thread: sessions opened on several threads
+	 * share the outermost one.
+	 * @param InLogFileName Name of the log file (without extension)
 	 */
-	static void Initialize(const FString& LogFileName = TEXT("UnrealGraph_Debug"));
+	static void Initialize(const FString& InLogFileName = TEXT("UnrealGraph_Debug"));
 
 	/**
-	 * Close the logger and flush any remaining content
+	 * End the current session; the writer closes its file once the queued messages are written.
+	 * Ending an inner session leaves the outer one open.
 	 */
 	static void Shutdown();
 
@@ -57,19 +110,44 @@ public:
 	 */
 	static void LogProperty(const FString& PropertyName, const FString& PropertyValue);
 
+	/**
+	 * Block until every message queued so far has been written to disk
+	 */
+	static void Flush();
+
+	/**
+	 * Flush, close the log file and stop the writer thread (module shutdown)
+	 */
+	static void StopWriter();
+
 	/**
 	 * Check if logger is initialized
 	 */
 	static bool IsInitialized() { return bIsInitialized; }
 
+	/**
+	 * Check whether messages at a level are enabled at runtime (UnrealGraph.LogLevel)
+	 * @param Level The level to test
+	 */
+	static bool IsLevelEnabled(EUnrealGraphLogLevel Level) { return static_cast<int32>(Level) <= RuntimeLogLevel; }
+
 private:
-	static bool bIsInitialized;
-	static FString LogFilePath;
-	static TArray<FString> LogBuffer;
+	static std::atomic<bool> bIsInitialized;
+
+	/** Number of open Initialize calls; only the outermost one begins and ends a session (guarded by SessionLock) */
+	static int32 SessionDepth;
+
+	/** Makes the first-open and last-close transitions and their session markers one step, so they queue in order */
+	static FCriticalSection SessionLock;
+	static int32 RuntimeLogLevel;
+	static FAutoConsoleVariableRef CVarLogLevel;
+
+	/** Background writer, created on first use */
+	static std::atomic<FUnrealGraphLogWriter*> Writer;
+	static FCriticalSection WriterLock;
 
 	/**
-	 * Flush log buffer to file
+	 * Get the writer, starting it if needed
 	 */
-	static void FlushLogBuffer();
+	static FUnrealGraphLogWriter& GetWriter();
 };
-
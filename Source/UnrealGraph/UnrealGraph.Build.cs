@@ -44,10 +44,16 @@ public class UnrealGraph : ModuleRules
 				"EditorSubsystem",
 				"InputCore",
 				"Projects",
-				"ApplicationCore"
+				"ApplicationCore",
+				"AssetRegistry",
+				"DerivedDataCache"
 			}
 		);
 		
+		// Highest UnrealGraph file-log level compiled in (0 = Off, 1 = Error, 2 = Summary, 3 = Verbose, 4 = Trace)
+		// The runtime level is selected with the UnrealGraph.LogLevel console variable
+		PublicDefinitions.Add("UNREALGRAPH_LOG_COMPILE_LEVEL=4");
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -5,6 +5,11 @@
 #include "UnrealGraphStyle.h"
 #include "BlueprintGraphSerializer.h"
 #include "BlueprintGraphDeserializer.h"
+#include "BlueprintGraphDescription.h"
+#include "BlueprintGraphJsonReader.h"
+#include "BlueprintGraphBinaryFormat.h"
+#include "BlueprintGraphReflectionCache.h"
+#include "UnrealGraphLogger.h"
 #include "ToolMenus.h"
 #include "HAL/IConsoleManager.h"
 #include "BlueprintEditorModule.h"
@@ -27,6 +32,17 @@
 
 #define LOCTEXT_NAMESPACE "FUnrealGraphModule"
 
+namespace UnrealGraphEditor
+{
+	static int32 CopyBoundaryLinks = 0;
+	static FAutoConsoleVariableRef CVarCopyBoundaryLinks(
+		TEXT("UnrealGraph.Copy.BoundaryLinks"),
+		CopyBoundaryLinks,
+		TEXT("Copy as JSON on a selection also records links between the selected nodes and the rest of the graph, as node id and pin name (1), or only links among the selected nodes (0)."),
+		ECVF_Default
+	);
+}
+
 void FUnrealGraphModule::StartupModule()
 {
 	// Initialize style
@@ -35,6 +51,9 @@ void FUnrealGraphModule::StartupModule()
 	// Register commands
 	FUnrealGraphCommands::Register();
 	
+	// Hook reflection cache invalidation (hot reload, Blueprint compile)
+	FBlueprintGraphReflectionCache::Startup();
+	
 	// Register menu extensions
 	RegisterMenus();
 	
@@ -53,6 +72,11 @@ void FUnrealGraphModule::StartupModule()
 		FExecuteAction::CreateRaw(this, &FUnrealGraphModule::OnPasteFromJSON),
 		FCanExecuteAction()
 	);
+	CommandList->MapAction(
+		FUnrealGraphCommands::Get().CopyBlueprintAsJSON,
+		FExecuteAction::CreateRaw(this, &FUnrealGraphModule::OnCopyBlueprintAsJSON),
+		FCanExecuteAction()
+	);
 	
 	// Register Blueprint editor menu extensions using ToolMenus
 	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FUnrealGraphModule::RegisterBlueprintEditorMenus));
@@ -69,6 +93,15 @@ void FUnrealGraphModule::ShutdownModule()
 	// Unregister commands
 	FUnrealGraphCommands::Unregister();
 	
+	// Drop cached reflection data
+	FBlueprintGraphReflectionCache::Shutdown();
+	
+	// Unhook the patch node indices from the graphs they watch
+	FBlueprintGraphDeserializer::ResetPatchNodeIndices();
+	
+	// Write any pending log messages and stop the log writer thread
+	FUnrealGraphLogger::StopWriter();
+	
 	// Shutdown style
 	FUnrealGraphStyle::Shutdown();
 }
@@ -96,6 +129,40 @@ void FUnrealGraphModule::RegisterConsoleCommands()
 		FConsoleCommandDelegate::CreateRaw(this, &FUnrealGraphModule::TestDeserialization),
 		ECVF_Default
 	);
+	
+	// Console command to compare the DOM and streaming serializers
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("UnrealGraph.CompareSerializers"),
+		TEXT("Serialize the focused graph with the DOM, streaming and snapshot + parallel encode paths, check the output matches and log timings"),
+		FConsoleCommandDelegate::CreateRaw(this, &FUnrealGraphModule::CompareSerializers),
+		ECVF_Default
+	);
+	
+	// Console command to compare the DOM and token-streaming readers
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("UnrealGraph.CompareReaders"),
+		TEXT("Read UnrealGraph_Test.json with the DOM parser and the token-streaming reader and log timings"),
+		FConsoleCommandDelegate::CreateRaw(this, &FUnrealGraphModule::CompareReaders),
+		ECVF_Default
+	);
+	
+	// Console command to compare the JSON and binary formats
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("UnrealGraph.BenchmarkBinary"),
+		TEXT("Encode the focused graph as JSON and as binary, log sizes and timings and check JSON -> binary -> JSON is lossless"),
+		FConsoleCommandDelegate::CreateRaw(this, &FUnrealGraphModule::BenchmarkBinary),
+		ECVF_Default
+	);
+	
+	// Console command to copy the part of the focused graph reachable from a node
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("UnrealGraph.CopyReachable"),
+		TEXT("Copy as JSON the nodes reachable from a root node of the focused graph. ")
+		TEXT("Arguments: [forward|backward] [exec|data|all] [NodeGuid]; the defaults are forward, all and the selected nodes. ")
+		TEXT("Links to nodes that were not reached are kept when UnrealGraph.Copy.BoundaryLinks is 1."),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnrealGraphModule::OnCopyReachableAsJSON),
+		ECVF_Default
+	);
 }
 
 void FUnrealGraphModule::TestSerialization()
@@ -119,11 +186,9 @@ void FUnrealGraphModule::TestSerialization()
 			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Graph has only 1 node (likely a function entry). Looking for graphs with multiple nodes..."));
 		}
 		
-		TSharedPtr<FJsonObject> JsonData = FBlueprintGraphSerializer::SerializeGraph(Graph);
-		if (JsonData.IsValid())
+		FString JsonString;
+		if (FBlueprintGraphSerializer::SerializeGraphToString(Graph, JsonString, true))
 		{
-			FString JsonString = FBlueprintGraphSerializer::JsonToString(JsonData, true);
-			
 			// Log first 1000 characters to see more of the structure
 			FString ShortJson = JsonString.Len() > 1000 ? JsonString.Left(1000) + TEXT("...") : JsonString;
 			UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: Serialized graph to JSON (%d chars, %d nodes):\n%s"), 
@@ -145,6 +210,132 @@ void FUnrealGraphModule::TestSerialization()
 	}
 }
 
+void FUnrealGraphModule::CompareSerializers()
+{
+	UEdGraph* Graph = GetFocusedBlueprintGraph();
+	if (!Graph)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: No Blueprint graph found. Please open a Blueprint with nodes first."));
+		return;
+	}
+
+	const double DomStart = FPlatformTime::Seconds();
+	const FString DomJson = FBlueprintGraphSerializer::JsonToString(FBlueprintGraphSerializer::SerializeGraph(Graph), true);
+	const double DomSeconds = FPlatformTime::Seconds() - DomStart;
+
+	const double StreamStart = FPlatformTime::Seconds();
+	FString StreamJson;
+	FBlueprintGraphSerializer::WriteGraphJson(Graph, StreamJson, true);
+	const double StreamSeconds = FPlatformTime::Seconds() - StreamStart;
+
+	// exportDate is taken at serialization time, so it is the only field allowed to differ
+	auto StripExportDate = [](const FString& Json)
+	{
+		const FString Key = TEXT("\"exportDate\": \"");
+		const int32 Start = Json.Find(Key, ESearchCase::CaseSensitive);
+		const int32 End = Start != INDEX_NONE ? Json.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start + Key.Len()) : INDEX_NONE;
+		return End != INDEX_NONE ? Json.Left(Start) + Json.Mid(End) : Json;
+	};
+	const bool bIdentical = StripExportDate(DomJson).Equals(StripExportDate(StreamJson), ESearchCase::CaseSensitive);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %s (%d nodes): DOM %.2f ms, streaming %.2f ms, %d chars, output %s"),
+		*Graph->GetName(), Graph->Nodes.Num(), DomSeconds * 1000.0, StreamSeconds * 1000.0, StreamJson.Len(),
+		bIdentical ? TEXT("identical") : TEXT("DIFFERS"));
+
+	// Two-phase path: snapshot on this thread, then encode (on worker threads above UnrealGraph.Serialize.ParallelMinNodes)
+	const double SnapshotStart = FPlatformTime::Seconds();
+	FBlueprintGraphDescription Description;
+	FBlueprintGraphSerializer::DescribeGraph(Graph, Description);
+	const double SnapshotSeconds = FPlatformTime::Seconds() - SnapshotStart;
+
+	const double EncodeStart = FPlatformTime::Seconds();
+	FString DescriptionJson;
+	FBlueprintGraphSerializer::WriteDescriptionJson(Description, DescriptionJson, true);
+	const double EncodeSeconds = FPlatformTime::Seconds() - EncodeStart;
+
+	const bool bDescriptionIdentical = StripExportDate(DescriptionJson).Equals(StripExportDate(StreamJson), ESearchCase::CaseSensitive);
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %s: snapshot %.2f ms, %s encode %.2f ms, output %s"),
+		*Graph->GetName(), SnapshotSeconds * 1000.0,
+		FBlueprintGraphSerializer::ShouldEncodeInParallel(Description.Nodes.Num()) ? TEXT("parallel") : TEXT("serial"),
+		EncodeSeconds * 1000.0, bDescriptionIdentical ? TEXT("identical") : TEXT("DIFFERS"));
+}
+
+void FUnrealGraphModule::CompareReaders()
+{
+	FString FilePath = FPaths::ProjectLogDir() / TEXT("UnrealGraph_Test.json");
+	FString JsonContent;
+	if (!FFileHelper::LoadFileToString(JsonContent, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to load JSON file: %s"), *FilePath);
+		return;
+	}
+
+	// DOM: parse the full tree, then validate it (what the paste path used to do before creating nodes)
+	const double DomStart = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> JsonData;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
+	const bool bDomParsed = FJsonSerializer::Deserialize(Reader, JsonData) && FBlueprintGraphDeserializer::ValidateJsonSchema(JsonData);
+	const double DomSeconds = FPlatformTime::Seconds() - DomStart;
+
+	const double StreamStart = FPlatformTime::Seconds();
+	FBlueprintGraphDescription Description;
+	FString Error;
+	const bool bStreamParsed = FBlueprintGraphJsonReader::ReadGraph(JsonContent, Description, Error);
+	const double StreamSeconds = FPlatformTime::Seconds() - StreamStart;
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %d chars: DOM %.2f ms (%s), token reader %.2f ms (%s: %d nodes, %d pins, %d connections, %d unique strings)"),
+		JsonContent.Len(), DomSeconds * 1000.0, bDomParsed ? TEXT("ok") : TEXT("failed"),
+		StreamSeconds * 1000.0, bStreamParsed ? TEXT("ok") : *Error,
+		Description.Nodes.Num(), Description.Pins.Num(), Description.Connections.Num(), Description.Strings.Num());
+}
+
+void FUnrealGraphModule::BenchmarkBinary()
+{
+	UEdGraph* Graph = GetFocusedBlueprintGraph();
+	if (!Graph)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: No Blueprint graph found. Please open a Blueprint with nodes first."));
+		return;
+	}
+
+	TArray<uint8> JsonUtf8;
+	const double JsonWriteStart = FPlatformTime::Seconds();
+	FBlueprintGraphSerializer::WriteGraphJsonUtf8(Graph, JsonUtf8, false);
+	const double JsonWriteSeconds = FPlatformTime::Seconds() - JsonWriteStart;
+
+	TArray<uint8> Binary;
+	const double BinaryWriteStart = FPlatformTime::Seconds();
+	FBlueprintGraphSerializer::SerializeGraphToBinary(Graph, Binary);
+	const double BinaryWriteSeconds = FPlatformTime::Seconds() - BinaryWriteStart;
+
+	FString JsonText;
+	FBlueprintGraphSerializer::WriteGraphJson(Graph, JsonText, true);
+
+	FBlueprintGraphDescription Description;
+	FString Error;
+	const double JsonReadStart = FPlatformTime::Seconds();
+	FBlueprintGraphJsonReader::ReadGraph(JsonText, Description, Error);
+	const double JsonReadSeconds = FPlatformTime::Seconds() - JsonReadStart;
+
+	const double BinaryReadStart = FPlatformTime::Seconds();
+	const bool bDecoded = FBlueprintGraphBinaryFormat::Decode(Binary, Description, Error);
+	const double BinaryReadSeconds = FPlatformTime::Seconds() - BinaryReadStart;
+
+	// Lossless check: JSON -> binary -> JSON must give back the exact text
+	TArray<uint8> RoundTripBinary;
+	FString RoundTripJson;
+	const bool bRoundTrip = FBlueprintGraphBinaryFormat::JsonToBinary(JsonText, RoundTripBinary, Error) &&
+		FBlueprintGraphBinaryFormat::BinaryToJson(RoundTripBinary, RoundTripJson, Error, true) &&
+		RoundTripJson.Equals(JsonText, ESearchCase::CaseSensitive);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %s (%d nodes): JSON %d bytes (write %.2f ms, read %.2f ms), binary %d bytes / %.1f%% (write %.2f ms, read %.2f ms, %s), round-trip %s"),
+		*Graph->GetName(), Graph->Nodes.Num(),
+		JsonUtf8.Num(), JsonWriteSeconds * 1000.0, JsonReadSeconds * 1000.0,
+		Binary.Num(), JsonUtf8.Num() > 0 ? 100.0 * Binary.Num() / JsonUtf8.Num() : 0.0,
+		BinaryWriteSeconds * 1000.0, BinaryReadSeconds * 1000.0, bDecoded ? TEXT("ok") : *Error,
+		bRoundTrip ? TEXT("lossless") : (Error.IsEmpty() ? TEXT("DIFFERS") : *Error));
+}
+
 void FUnrealGraphModule::TestDeserialization()
 {
 	UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: TestDeserialization called"));
@@ -169,18 +360,8 @@ void FUnrealGraphModule::TestDeserialization()
 	
 	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Loaded JSON from file (%d characters)"), JsonContent.Len());
 	
-	// Parse JSON
-	TSharedPtr<FJsonObject> JsonData;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
-	
-	if (!FJsonSerializer::Deserialize(Reader, JsonData) || !JsonData.IsValid())
-	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to parse JSON from file"));
-		return;
-	}
-	
-	// Deserialize
-	if (FBlueprintGraphDeserializer::DeserializeGraph(Graph, JsonData))
+	// Parse and deserialize in one pass (no JSON DOM)
+	if (FBlueprintGraphDeserializer::DeserializeGraphFromString(Graph, JsonContent))
 	{
 		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Graph deserialized from file successfully!"));
 	}
@@ -201,6 +382,7 @@ void FUnrealGraphModule::RegisterBlueprintEditorMenus()
 	
 	Section.AddMenuEntryWithCommandList(FUnrealGraphCommands::Get().CopyAsJSON, CommandList);
 	Section.AddMenuEntryWithCommandList(FUnrealGraphCommands::Get().PasteFromJSON, CommandList);
+	Section.AddMenuEntryWithCommandList(FUnrealGraphCommands::Get().CopyBlueprintAsJSON, CommandList);
 }
 
 void FUnrealGraphModule::OnCopyAsJSON()
@@ -212,24 +394,112 @@ void FUnrealGraphModule::OnCopyAsJSON()
 		return;
 	}
 
-	// Serialize the graph
-	TSharedPtr<FJsonObject> JsonData = FBlueprintGraphSerializer::SerializeGraph(Graph);
-	if (!JsonData.IsValid())
+	// With a selection, only the selected nodes are visited; otherwise the whole graph is serialized
+	// (streaming or DOM writer, see UnrealGraph.Serialize.Streaming)
+	const TArray<UEdGraphNode*> SelectedNodes = GetSelectedNodes(Graph);
+	FString JsonString;
+	const bool bSerialized = SelectedNodes.Num() > 0
+		? FBlueprintGraphSerializer::SerializeNodesToString(SelectedNodes, JsonString, UnrealGraphEditor::CopyBoundaryLinks != 0, true)
+		: FBlueprintGraphSerializer::SerializeGraphToString(Graph, JsonString, true);
+	if (!bSerialized)
 	{
 		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to serialize graph"));
 		return;
 	}
-
-	// Convert to string
-	FString JsonString = FBlueprintGraphSerializer::JsonToString(JsonData, true);
 	
 	// Copy to clipboard
 	FPlatformApplicationMisc::ClipboardCopy(*JsonString);
 	
-	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Graph copied as JSON to clipboard"));
+	if (SelectedNodes.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %d selected nodes copied as JSON to clipboard"), SelectedNodes.Num());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Graph copied as JSON to clipboard"));
+	}
 	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: JSON length: %d characters"), JsonString.Len());
 }
 
+void FUnrealGraphModule::OnCopyReachableAsJSON(const TArray<FString>& Args)
+{
+	UEdGraph* Graph = GetFocusedBlueprintGraph();
+	if (!Graph)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: No Blueprint graph is currently focused"));
+		return;
+	}
+
+	EBlueprintGraphReachDirection Direction = EBlueprintGraphReachDirection::Forward;
+	bool bFollowExec = true;
+	bool bFollowData = true;
+	FGuid RootGuid;
+	for (const FString& Arg : Args)
+	{
+		if (Arg.Equals(TEXT("forward"), ESearchCase::IgnoreCase))
+		{
+			Direction = EBlueprintGraphReachDirection::Forward;
+		}
+		else if (Arg.Equals(TEXT("backward"), ESearchCase::IgnoreCase))
+		{
+			Direction = EBlueprintGraphReachDirection::Backward;
+		}
+		else if (Arg.Equals(TEXT("exec"), ESearchCase::IgnoreCase) || Arg.Equals(TEXT("data"), ESearchCase::IgnoreCase) || Arg.Equals(TEXT("all"), ESearchCase::IgnoreCase))
+		{
+			bFollowExec = !Arg.Equals(TEXT("data"), ESearchCase::IgnoreCase);
+			bFollowData = !Arg.Equals(TEXT("exec"), ESearchCase::IgnoreCase);
+		}
+		else if (!FGuid::Parse(Arg, RootGuid))
+		{
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraph: CopyReachable: Unknown argument '%s' (expected forward, backward, exec, data, all or a node GUID)"), *Arg);
+			return;
+		}
+	}
+
+	// Root: the node with the given GUID, otherwise the selection
+	TArray<UEdGraphNode*> Roots;
+	if (RootGuid.IsValid())
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && Node->NodeGuid == RootGuid)
+			{
+				Roots.Add(Node);
+				break;
+			}
+		}
+		if (Roots.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("UnrealGraph: CopyReachable: No node with GUID %s in graph %s"), *RootGuid.ToString(), *Graph->GetName());
+			return;
+		}
+	}
+	else
+	{
+		Roots = GetSelectedNodes(Graph);
+	}
+	if (Roots.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: CopyReachable: Select a root node or pass its GUID"));
+		return;
+	}
+
+	TArray<UEdGraphNode*> Nodes;
+	FBlueprintGraphSerializer::CollectReachableNodes(Roots, Direction, bFollowExec, bFollowData, Nodes);
+
+	FString JsonString;
+	if (!FBlueprintGraphSerializer::SerializeNodesToString(Nodes, JsonString, UnrealGraphEditor::CopyBoundaryLinks != 0, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to serialize graph"));
+		return;
+	}
+
+	FPlatformApplicationMisc::ClipboardCopy(*JsonString);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: %d of %d nodes reachable from %d root(s) copied as JSON to clipboard (%d characters)"),
+		Nodes.Num(), Graph->Nodes.Num(), Roots.Num(), JsonString.Len());
+}
+
 void FUnrealGraphModule::OnPasteFromJSON()
 {
 	// Get clipboard content
@@ -242,16 +512,6 @@ void FUnrealGraphModule::OnPasteFromJSON()
 		return;
 	}
 
-	// Parse JSON
-	TSharedPtr<FJsonObject> JsonData;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ClipboardContent);
-	
-	if (!FJsonSerializer::Deserialize(Reader, JsonData) || !JsonData.IsValid())
-	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to parse JSON from clipboard"));
-		return;
-	}
-
 	// Get the focused graph
 	UEdGraph* Graph = GetFocusedBlueprintGraph();
 	if (!Graph)
@@ -260,8 +520,8 @@ void FUnrealGraphModule::OnPasteFromJSON()
 		return;
 	}
 
-	// Deserialize
-	if (FBlueprintGraphDeserializer::DeserializeGraph(Graph, JsonData))
+	// Parse and deserialize in one pass (no JSON DOM)
+	if (FBlueprintGraphDeserializer::DeserializeGraphFromString(Graph, ClipboardContent))
 	{
 		UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Graph pasted from JSON successfully"));
 	}
@@ -271,6 +531,28 @@ void FUnrealGraphModule::OnPasteFromJSON()
 	}
 }
 
+void FUnrealGraphModule::OnCopyBlueprintAsJSON()
+{
+	UEdGraph* Graph = GetFocusedBlueprintGraph();
+	UBlueprint* Blueprint = Graph ? FBlueprintEditorUtils::FindBlueprintForGraph(Graph) : nullptr;
+	if (!Blueprint)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGraph: No Blueprint is currently focused"));
+		return;
+	}
+
+	FString JsonString;
+	if (!FBlueprintGraphSerializer::SerializeBlueprint(Blueprint, JsonString, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGraph: Failed to serialize Blueprint %s"), *Blueprint->GetName());
+		return;
+	}
+
+	FPlatformApplicationMisc::ClipboardCopy(*JsonString);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Blueprint %s copied as JSON to clipboard (%d characters)"), *Blueprint->GetName(), JsonString.Len());
+}
+
 UEdGraph* FUnrealGraphModule::GetFocusedBlueprintGraph() const
 {
 	// Use AssetEditorSubsystem to find the currently active (foreground) Blueprint editor
@@ -389,6 +671,40 @@ UEdGraph* FUnrealGraphModule::GetFocusedBlueprintGraph() const
 	return nullptr;
 }
 
+TArray<UEdGraphNode*> FUnrealGraphModule::GetSelectedNodes(UEdGraph* Graph) const
+{
+	TArray<UEdGraphNode*> SelectedNodes;
+	UBlueprint* Blueprint = Graph ? FBlueprintEditorUtils::FindBlueprintForGraph(Graph) : nullptr;
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if (!Blueprint || !AssetEditorSubsystem)
+	{
+		return SelectedNodes;
+	}
+
+	IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false);
+	FBlueprintEditor* BlueprintEditor = EditorInstance ? static_cast<FBlueprintEditor*>(static_cast<FAssetEditorToolkit*>(EditorInstance)) : nullptr;
+	if (!BlueprintEditor || BlueprintEditor->GetFocusedGraph() != Graph)
+	{
+		return SelectedNodes;
+	}
+
+	for (UObject* Object : BlueprintEditor->GetSelectedNodes())
+	{
+		UEdGraphNode* Node = Cast<UEdGraphNode>(Object);
+		if (Node && Node->GetGraph() == Graph)
+		{
+			SelectedNodes.Add(Node);
+		}
+	}
+
+	// The selection set has no meaningful order; write nodes top to bottom, left to right
+	SelectedNodes.Sort([](const UEdGraphNode& A, const UEdGraphNode& B)
+	{
+		return A.NodePosY != B.NodePosY ? A.NodePosY < B.NodePosY : A.NodePosX < B.NodePosX;
+	});
+	return SelectedNodes;
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FUnrealGraphModule, UnrealGraph)
@@ -28,6 +28,15 @@ private:
 	/** Test serialization function */
 	void TestSerialization();
 	
+	/** Compare the DOM, streaming and two-phase (snapshot + encode) serializers on the focused graph */
+	void CompareSerializers();
+	
+	/** Compare the DOM and token-streaming readers on UnrealGraph_Test.json */
+	void CompareReaders();
+	
+	/** Compare JSON and binary size and speed on the focused graph and check the binary round-trip */
+	void BenchmarkBinary();
+	
 	/** Test deserialization from file */
 	void TestDeserialization();
 
@@ -37,10 +46,19 @@ private:
 	/** Handler for Copy as JSON */
 	void OnCopyAsJSON();
 	
+	/** Copy the nodes reachable from the selection or a node GUID (UnrealGraph.CopyReachable) */
+	void OnCopyReachableAsJSON(const TArray<FString>& Args);
+	
 	/** Handler for Paste from JSON */
 	void OnPasteFromJSON();
 	
+	/** Handler for Copy Blueprint as JSON */
+	void OnCopyBlueprintAsJSON();
+	
 	/** Get the currently focused Blueprint graph */
 	UEdGraph* GetFocusedBlueprintGraph() const;
+
+	/** Get the nodes selected in the Blueprint editor showing a graph; empty if none are selected */
+	TArray<UEdGraphNode*> GetSelectedNodes(UEdGraph* Graph) const;
 };
 
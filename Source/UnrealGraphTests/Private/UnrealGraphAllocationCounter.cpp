@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealGraphAllocationCounter.h"
+
+FUnrealGraphAllocationCounter* FUnrealGraphAllocationCounter::Instance = nullptr;
+bool FUnrealGraphAllocationCounter::bInstalled = false;
+
+FUnrealGraphAllocationCounter::FUnrealGraphAllocationCounter(FMalloc* InInner)
+	: Inner(InInner)
+{
+}
+
+void FUnrealGraphAllocationCounter::Install()
+{
+	check(IsInGameThread());
+	if (bInstalled)
+	{
+		return;
+	}
+
+	// Allocated with the inner allocator and intentionally leaked (see class comment). Threads that still
+	// read the old GMalloc keep allocating from the same inner allocator, so swapping it is safe.
+	if (!Instance)
+	{
+		Instance = new FUnrealGraphAllocationCounter(GMalloc);
+	}
+	Instance->Inner = GMalloc;
+	GMalloc = Instance;
+	bInstalled = true;
+
+	// Publish the swap before the measured work starts handing tasks to other threads
+	FPlatformMisc::MemoryBarrier();
+	UE_LOG(LogTemp, Log, TEXT("UnrealGraph: Counting allocations over %s"), Instance->Inner->GetDescriptiveName());
+}
+
+void FUnrealGraphAllocationCounter::Uninstall()
+{
+	check(IsInGameThread());
+	if (!bInstalled)
+	{
+		return;
+	}
+
+	// Anything else that wrapped GMalloc after Install would be unhooked by restoring it
+	ensureMsgf(GMalloc == Instance, TEXT("GMalloc was replaced while allocations were counted"));
+	GMalloc = Instance->Inner;
+	bInstalled = false;
+	FPlatformMisc::MemoryBarrier();
+}
+
+FUnrealGraphAllocationStats FUnrealGraphAllocationCounter::GetStats()
+{
+	FUnrealGraphAllocationStats Stats;
+	if (Instance)
+	{
+		Stats.Allocations = Instance->Allocations.load(std::memory_order_relaxed);
+		Stats.Bytes = Instance->Bytes.load(std::memory_order_relaxed);
+	}
+	return Stats;
+}
+
+void* FUnrealGraphAllocationCounter::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	AddAllocation(Count);
+	return Inner->Malloc(Count, Alignment);
+}
+
+void* FUnrealGraphAllocationCounter::TryMalloc(SIZE_T Count, uint32 Alignment)
+{
+	AddAllocation(Count);
+	return Inner->TryMalloc(Count, Alignment);
+}
+
+void* FUnrealGraphAllocationCounter::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	// Realloc to zero bytes is a free
+	if (Count > 0)
+	{
+		AddAllocation(Count);
+	}
+	return Inner->Realloc(Original, Count, Alignment);
+}
+
+void* FUnrealGraphAllocationCounter::TryRealloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	if (Count > 0)
+	{
+		AddAllocation(Count);
+	}
+	return Inner->TryRealloc(Original, Count, Alignment);
+}
+
+void FUnrealGraphAllocationCounter::Free(void* Original)
+{
+	Inner->Free(Original);
+}
+
+SIZE_T FUnrealGraphAllocationCounter::QuantizeSize(SIZE_T Count, uint32 Alignment)
+{
+	return Inner->QuantizeSize(Count, Alignment);
+}
+
+bool FUnrealGraphAllocationCounter::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return Inner->GetAllocationSize(Original, SizeOut);
+}
+
+void FUnrealGraphAllocationCounter::Trim(bool bTrimThreadCaches)
+{
+	Inner->Trim(bTrimThreadCaches);
+}
+
+void FUnrealGraphAllocationCounter::SetupTLSCachesOnCurrentThread()
+{
+	Inner->SetupTLSCachesOnCurrentThread();
+}
+
+void FUnrealGraphAllocationCounter::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	Inner->ClearAndDisableTLSCachesOnCurrentThread();
+}
+
+void FUnrealGraphAllocationCounter::InitializeStatsMetadata()
+{
+	Inner->InitializeStatsMetadata();
+}
+
+void FUnrealGraphAllocationCounter::UpdateStats()
+{
+	Inner->UpdateStats();
+}
+
+void FUnrealGraphAllocationCounter::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	Inner->GetAllocatorStats(OutStats);
+}
+
+void FUnrealGraphAllocationCounter::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	Inner->DumpAllocatorStats(Ar);
+}
+
+bool FUnrealGraphAllocationCounter::IsInternallyThreadSafe() const
+{
+	return Inner->IsInternallyThreadSafe();
+}
+
+bool FUnrealGraphAllocationCounter::ValidateHeap()
+{
+	return Inner->ValidateHeap();
+}
+
+void FUnrealGraphAllocationCounter::OnMallocInitialized()
+{
+	Inner->OnMallocInitialized();
+}
+
+void FUnrealGraphAllocationCounter::OnPreFork()
+{
+	Inner->OnPreFork();
+}
+
+void FUnrealGraphAllocationCounter::OnPostFork()
+{
+	Inner->OnPostFork();
+}
+
+const TCHAR* FUnrealGraphAllocationCounter::GetDescriptiveName()
+{
+	return TEXT("UnrealGraphAllocationCounter");
+}
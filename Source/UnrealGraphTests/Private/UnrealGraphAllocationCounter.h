@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include <atomic>
+
+/**
+ * Allocation counters at one point in time; subtract two snapshots to measure the work between them
+ */
+struct FUnrealGraphAllocationStats
+{
+	/** Malloc and Realloc calls */
+	uint64 Allocations = 0;
+
+	/** Bytes requested by those calls */
+	uint64 Bytes = 0;
+
+	FUnrealGraphAllocationStats operator-(const FUnrealGraphAllocationStats& Other) const
+	{
+		FUnrealGraphAllocationStats Delta;
+		Delta.Allocations = Allocations - Other.Allocations;
+		Delta.Bytes = Bytes - Other.Bytes;
+		return Delta;
+	}
+};
+
+/**
+ * FMalloc proxy that counts allocations made through GMalloc on every thread, so work spread over
+ * task threads (parallel encoding) is included. Other threads allocating at the same time are counted
+ * too; measurements are meant for an otherwise idle editor (e.g., a headless automation run).
+ *
+ * The proxy only sits over GMalloc between Install and Uninstall, i.e. while a perf test runs. Every
+ * call is forwarded to the allocator it replaced, so memory allocated through it can be freed after it
+ * is removed. The proxy object itself is kept alive: a thread may still be inside it after Uninstall.
+ */
+class FUnrealGraphAllocationCounter final : public FMalloc
+{
+public:
+	/**
+	 * Route GMalloc through the proxy until Uninstall (game thread only)
+	 */
+	static void Install();
+
+	/**
+	 * Give GMalloc back to the allocator the proxy replaced (game thread only)
+	 */
+	static void Uninstall();
+
+	/**
+	 * Read the counters
+	 * @return The counters since the proxy was first installed; zero if it never was
+	 */
+	static FUnrealGraphAllocationStats GetStats();
+
+	//~ Begin FMalloc Interface
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void Trim(bool bTrimThreadCaches) override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void InitializeStatsMetadata() override;
+	virtual void UpdateStats() override;
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual bool ValidateHeap() override;
+	virtual void OnMallocInitialized() override;
+	virtual void OnPreFork() override;
+	virtual void OnPostFork() override;
+	virtual const TCHAR* GetDescriptiveName() override;
+	//~ End FMalloc Interface
+
+private:
+	explicit FUnrealGraphAllocationCounter(FMalloc* InInner);
+
+	void AddAllocation(SIZE_T Size)
+	{
+		Allocations.fetch_add(1, std::memory_order_relaxed);
+		Bytes.fetch_add(Size, std::memory_order_relaxed);
+	}
+
+	/** The allocator this proxy forwards to */
+	FMalloc* Inner;
+
+	std::atomic<uint64> Allocations{ 0 };
+	std::atomic<uint64> Bytes{ 0 };
+
+	/** The proxy, nullptr until the first Install */
+	static FUnrealGraphAllocationCounter* Instance;
+
+	/** Whether GMalloc currently points at the proxy */
+	static bool bInstalled;
+};
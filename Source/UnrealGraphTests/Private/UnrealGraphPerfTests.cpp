@@ -0,0 +1,312 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealGraphAllocationCounter.h"
+#include "BlueprintGraphSerializer.h"
+#include "BlueprintGraphDeserializer.h"
+#include "Misc/AutomationTest.h"
+#include "Editor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealGraphPerf
+{
+	/** Graph sizes measured by UnrealGraph.Perf.RoundTrip */
+	static const int32 GraphSizes[] = { 100, 1000, 10000, 50000 };
+
+	/** Nodes per row when laying out generated graphs */
+	static constexpr int32 NodesPerRow = 200;
+
+	/**
+	 * Measurements of one phase of the round trip
+	 */
+	struct FPhaseResult
+	{
+		const TCHAR* Name = TEXT("");
+		double Seconds = 0.0;
+		FUnrealGraphAllocationStats Allocations;
+	};
+
+	/**
+	 * Measurements of one graph size
+	 */
+	struct FSizeResult
+	{
+		int32 NumNodes = 0;
+		int32 NumConnections = 0;
+
+		/** Size of the JSON document, UTF-8 encoded */
+		int64 JsonBytes = 0;
+
+		TArray<FPhaseResult> Phases;
+	};
+
+	/** Results of every size measured in this session, written together to one file */
+	static TArray<FSizeResult> SessionResults;
+
+	template <typename FunctionType>
+	FPhaseResult MeasurePhase(const TCHAR* Name, FunctionType&& Function)
+	{
+		FPhaseResult Result;
+		Result.Name = Name;
+		const FUnrealGraphAllocationStats AllocationsBefore = FUnrealGraphAllocationCounter::GetStats();
+		const double StartTime = FPlatformTime::Seconds();
+		Function();
+		Result.Seconds = FPlatformTime::Seconds() - StartTime;
+		Result.Allocations = FUnrealGraphAllocationCounter::GetStats() - AllocationsBefore;
+		return Result;
+	}
+
+	/**
+	 * Results file: -UnrealGraphPerfResults=<file>, or Saved/Automation/UnrealGraphPerf.json
+	 */
+	FString GetResultsFile()
+	{
+		FString ResultsFile;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("UnrealGraphPerfResults="), ResultsFile))
+		{
+			ResultsFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("UnrealGraphPerf.json"));
+		}
+		return ResultsFile;
+	}
+
+	bool WriteResults(const FString& ResultsFile)
+	{
+		FString ResultsJson;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&ResultsJson);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+		Writer->WriteValue(TEXT("platform"), FPlatformProperties::IniPlatformName());
+		Writer->WriteValue(TEXT("date"), FDateTime::UtcNow().ToIso8601());
+
+		Writer->WriteArrayStart(TEXT("results"));
+		for (const FSizeResult& SizeResult : SessionResults)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("nodes"), SizeResult.NumNodes);
+			Writer->WriteValue(TEXT("connections"), SizeResult.NumConnections);
+			Writer->WriteValue(TEXT("jsonBytes"), static_cast<double>(SizeResult.JsonBytes));
+
+			Writer->WriteObjectStart(TEXT("phases"));
+			for (const FPhaseResult& Phase : SizeResult.Phases)
+			{
+				Writer->WriteObjectStart(Phase.Name);
+				Writer->WriteValue(TEXT("ms"), Phase.Seconds * 1000.0);
+				Writer->WriteValue(TEXT("nodesPerSecond"), Phase.Seconds > 0.0 ? SizeResult.NumNodes / Phase.Seconds : 0.0);
+				Writer->WriteValue(TEXT("allocations"), static_cast<double>(Phase.Allocations.Allocations));
+				Writer->WriteValue(TEXT("allocatedBytes"), static_cast<double>(Phase.Allocations.Bytes));
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteObjectEnd();
+
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return FFileHelper::SaveStringToFile(ResultsJson, *ResultsFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+
+	UEdGraph* AddGraph(UBlueprint* Blueprint, const TCHAR* BaseName)
+	{
+		UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, MakeUniqueObjectName(Blueprint, UEdGraph::StaticClass(), BaseName),
+			UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		FBlueprintEditorUtils::AddUbergraphPage(Blueprint, Graph);
+		return Graph;
+	}
+
+	/**
+	 * Fill a graph with an exec chain of PrintString calls, each fed by a pure Conv_IntToString node
+	 * with a default value, so nodes carry member references, pin defaults, and exec and data links
+	 * @return Number of connections made
+	 */
+	int32 BuildGraph(UEdGraph* Graph, int32 NumNodes)
+	{
+		UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+		UFunction* IntToString = UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Conv_IntToString));
+
+		int32 NumConnections = 0;
+		UK2Node_CallFunction* PreviousCall = nullptr;
+		UEdGraphPin* PendingValue = nullptr;
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+		{
+			const bool bConversion = NodeIndex % 2 == 0;
+
+			FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+			UK2Node_CallFunction* Node = Creator.CreateNode(/*bSelectNewNode*/ false);
+			Node->SetFromFunction(bConversion ? IntToString : PrintString);
+			Node->NodePosX = (NodeIndex % NodesPerRow) * 300;
+			Node->NodePosY = (NodeIndex / NodesPerRow) * 200;
+			Creator.Finalize();
+
+			// Links are made directly rather than through the schema, which notifies the graph on every change
+			if (bConversion)
+			{
+				Node->FindPinChecked(TEXT("InInt"))->DefaultValue = FString::FromInt(NodeIndex);
+				PendingValue = Node->GetReturnValuePin();
+				continue;
+			}
+
+			if (PendingValue)
+			{
+				PendingValue->MakeLinkTo(Node->FindPinChecked(TEXT("InString")));
+				++NumConnections;
+			}
+			if (PreviousCall)
+			{
+				PreviousCall->GetThenPin()->MakeLinkTo(Node->GetExecPin());
+				++NumConnections;
+			}
+			PreviousCall = Node;
+		}
+		return NumConnections;
+	}
+}
+
+/**
+ * Round trip of generated graphs through the DOM path, timing each phase separately:
+ * SerializeGraph, JsonToString, JSON parse, ValidateJsonSchema and DeserializeGraph.
+ * Every size adds its results to the results file (see UnrealGraphPerf::GetResultsFile).
+ *
+ * Headless: UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests UnrealGraph.Perf; Quit" -unattended -nullrhi
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUnrealGraphPerfRoundTripTest, "UnrealGraph.Perf.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUnrealGraphPerfRoundTripTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 NumNodes : UnrealGraphPerf::GraphSizes)
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%d Nodes"), NumNodes));
+		OutTestCommands.Add(FString::FromInt(NumNodes));
+	}
+}
+
+bool FUnrealGraphPerfRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealGraphPerf;
+
+	const int32 NumNodes = FCString::Atoi(*Parameters);
+	if (!TestTrue(TEXT("Graph size"), NumNodes > 0))
+	{
+		return false;
+	}
+
+	// Only counted for the duration of the test; ordinary editor work never runs through the proxy
+	FUnrealGraphAllocationCounter::Install();
+	ON_SCOPE_EXIT
+	{
+		FUnrealGraphAllocationCounter::Uninstall();
+	};
+
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), GetTransientPackage(),
+		MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("BP_UnrealGraphPerf")),
+		BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	if (!TestNotNull(TEXT("Transient Blueprint"), Blueprint))
+	{
+		return false;
+	}
+
+	UEdGraph* SourceGraph = AddGraph(Blueprint, TEXT("PerfSource"));
+	UEdGraph* TargetGraph = AddGraph(Blueprint, TEXT("PerfTarget"));
+
+	FSizeResult Result;
+	Result.NumNodes = NumNodes;
+	Result.NumConnections = BuildGraph(SourceGraph, NumNodes);
+
+	TSharedPtr<FJsonObject> Serialized;
+	FString JsonString;
+	TSharedPtr<FJsonObject> Parsed;
+	bool bParsed = false;
+	bool bValid = false;
+	bool bDeserialized = false;
+
+	Result.Phases.Add(MeasurePhase(TEXT("serializeGraph"), [&]()
+	{
+		Serialized = FBlueprintGraphSerializer::SerializeGraph(SourceGraph);
+	}));
+	Result.Phases.Add(MeasurePhase(TEXT("jsonToString"), [&]()
+	{
+		JsonString = FBlueprintGraphSerializer::JsonToString(Serialized, true);
+	}));
+	Result.Phases.Add(MeasurePhase(TEXT("parse"), [&]()
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+		bParsed = FJsonSerializer::Deserialize(Reader, Parsed);
+	}));
+	Result.Phases.Add(MeasurePhase(TEXT("validate"), [&]()
+	{
+		bValid = FBlueprintGraphDeserializer::ValidateJsonSchema(Parsed);
+	}));
+	Result.Phases.Add(MeasurePhase(TEXT("deserializeGraph"), [&]()
+	{
+		bDeserialized = FBlueprintGraphDeserializer::DeserializeGraph(TargetGraph, Parsed);
+	}));
+
+	Result.JsonBytes = FTCHARToUTF8(*JsonString, JsonString.Len()).Length();
+
+	TestTrue(TEXT("SerializeGraph"), Serialized.IsValid());
+	TestTrue(TEXT("JSON parse"), bParsed);
+	TestTrue(TEXT("ValidateJsonSchema"), bValid);
+	TestTrue(TEXT("DeserializeGraph"), bDeserialized);
+	TestEqual(TEXT("Deserialized node count"), TargetGraph->Nodes.Num(), SourceGraph->Nodes.Num());
+
+	for (const FPhaseResult& Phase : Result.Phases)
+	{
+		AddInfo(FString::Printf(TEXT("%d nodes, %s: %.2f ms, %.0f nodes/s, %llu allocations (%llu bytes)"),
+			NumNodes, Phase.Name, Phase.Seconds * 1000.0, Phase.Seconds > 0.0 ? NumNodes / Phase.Seconds : 0.0,
+			Phase.Allocations.Allocations, Phase.Allocations.Bytes));
+	}
+	AddInfo(FString::Printf(TEXT("%d nodes: %lld JSON bytes"), NumNodes, Result.JsonBytes));
+
+	// Keep one entry per size when a size is run again
+	SessionResults.RemoveAll([NumNodes](const FSizeResult& Existing) { return Existing.NumNodes == NumNodes; });
+	SessionResults.Add(MoveTemp(Result));
+	SessionResults.Sort([](const FSizeResult& A, const FSizeResult& B) { return A.NumNodes < B.NumNodes; });
+
+	const FString ResultsFile = GetResultsFile();
+	if (WriteResults(ResultsFile))
+	{
+		AddInfo(FString::Printf(TEXT("Results written to %s"), *ResultsFile));
+	}
+	else
+	{
+		AddError(FString::Printf(TEXT("Failed to write %s"), *ResultsFile));
+	}
+
+	// The deserializer's transaction references the graphs; drop it so the Blueprint can be collected
+	Serialized.Reset();
+	Parsed.Reset();
+	GEditor->ResetTransaction(NSLOCTEXT("UnrealGraph", "PerfTests", "UnrealGraph performance tests"));
+	Blueprint->MarkAsGarbage();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
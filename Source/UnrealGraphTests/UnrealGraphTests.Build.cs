@@ -0,0 +1,23 @@
+
+using UnrealBuildTool;
+
+public class UnrealGraphTests : ModuleRules
+{
+	public UnrealGraphTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"UnrealEd",
+				"BlueprintGraph",
+				"UnrealGraph"
+			}
+		);
+	}
+}
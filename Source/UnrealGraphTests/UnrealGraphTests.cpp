@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Automation tests only; see Private/UnrealGraphPerfTests.cpp
+IMPLEMENT_MODULE(FDefaultModuleImpl, UnrealGraphTests)